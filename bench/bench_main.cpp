@@ -0,0 +1,388 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "Attractor.h"
+#include "Bifurcation.h"
+#include "CustomSystem.h"
+#include "DeltaCodec.h"
+#include "Lyapunov.h"
+#include "Plugins.h"
+#include "Poincare.h"
+#include "Sweep.h"
+
+// Banc d'essai sans interface : mesure le coût de Attractor::update pour
+// chacun des systèmes du registre, greffons chargés compris (ATTRACTEUR_PLUGINS
+// ou dossier plugins/ du répertoire courant).
+
+struct BenchOptions {
+    long steps = 5000000; // Itérations par mesure
+    int repeats = 3;      // On garde la meilleure mesure
+    int onlyType = 0;     // 0 = tous les systèmes
+};
+
+static BenchOptions parseOptions(int argc, char* argv[]) {
+    BenchOptions opt;
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--quick")) { opt.steps = 200000; opt.repeats = 1; }
+        else if (!std::strcmp(argv[i], "--steps") && i + 1 < argc) opt.steps = std::atol(argv[++i]);
+        else if (!std::strcmp(argv[i], "--repeats") && i + 1 < argc) opt.repeats = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--type") && i + 1 < argc) opt.onlyType = std::atoi(argv[++i]);
+        else {
+            std::fprintf(stderr, "Usage : %s [--quick] [--steps N] [--repeats N] [--type T]\n", argv[0]);
+            std::exit(2);
+        }
+    }
+    return opt;
+}
+
+static double benchUpdate(int type, const BenchOptions& opt, Point& last, Precision precision = Precision::Single) {
+    double best = 1e300;
+    for (int r = 0; r < opt.repeats; r++) {
+        Attractor att;
+        att.select(type);
+        att.precision = precision;
+        auto t0 = std::chrono::steady_clock::now();
+        for (long i = 0; i < opt.steps; i++) att.update();
+        auto t1 = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / opt.steps;
+        if (ns < best) best = ns;
+        last = att.p;
+    }
+    return best;
+}
+
+// Pas avant que les trajectoires float et double, parties du même point,
+// s'écartent de plus de 1 % de l'étendue parcourue ; -1 si jamais
+static long benchDivergence(int type, const BenchOptions& opt) {
+    Attractor single, exact;
+    single.select(type);
+    exact.select(type);
+    exact.precision = Precision::Double;
+    Point lo = exact.p, hi = exact.p;
+    for (long i = 0; i < opt.steps; i++) {
+        single.update();
+        exact.update();
+        const Point& p = exact.p;
+        lo = {std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z)};
+        hi = {std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z)};
+        float extent = std::max({hi.x - lo.x, hi.y - lo.y, hi.z - lo.z});
+        float d = std::max({std::fabs(single.p.x - p.x), std::fabs(single.p.y - p.y), std::fabs(single.p.z - p.z)});
+        if (!(d <= 0.01f * extent)) return i + 1;   // NaN compris
+    }
+    return -1;
+}
+
+// Benettin : pas + jacobienne + orthonormalisation, par pas
+static double benchLyapunov(int type, const BenchOptions& opt, LyapunovResult& last) {
+    Attractor att;
+    att.select(type);
+    LyapunovSettings s;
+    s.transient = 1000;
+    s.maxSteps = opt.steps / 5;
+    auto t0 = std::chrono::steady_clock::now();
+    last = estimateLyapunov(att, s);
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / (s.transient + last.steps);
+}
+
+// Balayage : plus grand exposant sur une grille, par paquets de cellules et
+// sur tous les cœurs ; coût rapporté à un pas d'une cellule
+static double benchSweep(int type, const BenchOptions& opt, SweepMode mode, double& cellsPerSecond,
+                         Precision precision = Precision::Single) {
+    SweepSettings s(type);
+    s.precision = precision;
+    const SystemInfo& sys = Attractor::info(type);
+    s.paramX = 0;
+    s.paramY = sys.paramCount > 1 ? 1 : 0;
+    s.xMin = sys.paramDefaults[s.paramX] * 0.9f; s.xMax = sys.paramDefaults[s.paramX] * 1.1f;
+    s.yMin = sys.paramDefaults[s.paramY] * 0.9f; s.yMax = sys.paramDefaults[s.paramY] * 1.1f;
+    s.width = 64;
+    s.height = 16;
+    s.transient = 1000;
+    s.steps = std::max(1000L, opt.steps / 500);
+    s.mode = mode;
+    SweepResult r = runSweep(s);
+    double cells = double(r.width) * r.height;
+    cellsPerSecond = cells / r.seconds;
+    return r.seconds * 1e9 / (cells * double(s.transient + s.steps));
+}
+
+// Diagramme de bifurcation : colonnes réparties sur tous les cœurs
+static double benchBifurcation(int type, const BenchOptions& opt, double& columnsPerSecond) {
+    BifurcationSettings s(type);
+    s.columns = 128;
+    s.rows = 64;
+    s.transient = 1000;
+    s.steps = std::max(1000L, opt.steps / 200);
+    BifurcationDiagram diagram;
+    diagram.start(s);
+    diagram.wait();
+    columnsPerSecond = s.columns / diagram.seconds();
+    return diagram.seconds() * 1e9 / (double(s.columns) * double(s.transient + s.steps));
+}
+
+// Section de Poincaré (RK4 + astuce de Hénon) : coût par passage
+static double benchPoincare(int type, const BenchOptions& opt, long& crossings) {
+    PoincareSettings s(type);
+    s.width = s.height = 256;
+    s.transient = 1000;
+    s.uMin = s.vMin = -100.0f;   // Plage fixe : pas d'estimation préalable
+    s.uMax = s.vMax = 100.0f;
+    s.maxCrossings = std::max(1024L, opt.steps / 2000);
+    PoincareSection section;
+    if (!section.start(s)) return 0.0;
+    section.wait();
+    crossings = section.crossings();
+    return crossings > 0 ? section.seconds() * 1e9 / double(crossings) : 0.0;
+}
+
+// Codec Delta des trajectoires (pas 1e-3) : codage et décodage par point
+// (trois coordonnées), taille obtenue
+static double benchCodec(int type, const BenchOptions& opt, double& decodeNs, double& bytesPerPoint) {
+    const size_t chunk = 65536;
+    const size_t count = std::max<size_t>(chunk, size_t(opt.steps) / chunk * chunk);
+    std::vector<float> columns[3];
+    for (auto& c : columns) c.resize(count);
+    // Même trajectoire que attracteurs_cli record (Euler, une itération par
+    // point pour les applications)
+    Attractor att;
+    att.select(type);
+    const SystemInfo& sys = Attractor::info(type);
+    dispatchSystem(type, [&](auto tag) {
+        constexpr int Type = decltype(tag)::value;
+        const float dt = sys.isMap ? 1.0f : att.dt;
+        Point p = att.p;
+        for (size_t i = 0; i < count; i++) {
+            advance<Type>(Integrator::Euler, att.params, p, dt);
+            columns[0][i] = p.x;
+            columns[1][i] = p.y;
+            columns[2][i] = p.z;
+        }
+    });
+    for (auto& c : columns) {
+        if (!deltaEncodable(c.data(), count, 1e-3)) return -1.0;   // Trajectoire divergente
+    }
+    std::vector<uint8_t> encoded;
+    std::vector<size_t> offsets;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t first = 0; first < count; first += chunk) {
+        for (auto& c : columns) {
+            offsets.push_back(encoded.size());
+            deltaEncode(c.data() + first, chunk, 1e-3, encoded);
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    offsets.push_back(encoded.size());
+    std::vector<float> decoded(chunk);
+    for (size_t i = 0; i + 1 < offsets.size(); i++) {
+        deltaDecode(encoded.data() + offsets[i], offsets[i + 1] - offsets[i], chunk, 1e-3, decoded.data());
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    decodeNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / count;
+    bytesPerPoint = double(encoded.size()) / count;
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / count;
+}
+
+// Intégrateurs à horizon fixe (en double) : coût par unité de temps et écart
+// au point final de référence (pas exact ou série de Taylor à petit pas)
+static double benchIntegrator(int type, Integrator integrator, double dt, double horizon,
+                              Vec3<double>& end, int order = kTaylorOrder) {
+    Attractor att;
+    att.select(type);
+    double k[kMaxParams];
+    std::copy(att.params, att.params + kMaxParams, k);
+    const long steps = std::lround(horizon / dt);
+    const int repeats = std::max(1, int(2000 / steps));
+    auto t0 = std::chrono::steady_clock::now();
+    dispatchSystem(type, [&](auto tag) {
+        for (int r = 0; r < repeats; r++) {
+            end = vecCast<double>(att.p);
+            for (long i = 0; i < steps; i++) advance<decltype(tag)::value>(integrator, k, end, dt, order);
+        }
+    });
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / (repeats * horizon);
+}
+
+// Systèmes du registre réécrits en équations : même point de départ et mêmes
+// paramètres, pour comparer la machine virtuelle aux noyaux compilés
+struct CustomCase {
+    int type;
+    const char* equations[3];
+};
+
+static const CustomCase kCustomCases[] = {
+    {1, {"sigma * (y - x)", "x * (rho - z) - y", "x * y - beta * z"}},
+    {2, {"-y - z", "x + a * y", "b + z * (x - c)"}},
+    {4, {"sin(y) - b * x", "sin(z) - b * y", "sin(x) - b * z"}},
+    {5, {"1 - a * x * x + y", "b * x", ""}},
+};
+
+static bool defineCase(const CustomCase& c, bool native) {
+    const SystemInfo& sys = Attractor::info(c.type);
+    CustomDefinition def;
+    def.name = std::string(sys.name) + " (VM)";
+    for (int i = 0; i < 3; i++) def.equations[i] = c.equations[i];
+    for (int i = 0; i < sys.paramCount; i++) def.params.emplace_back(sys.paramNames[i], sys.paramDefaults[i]);
+    def.isMap = sys.isMap;
+    def.initial = sys.initial;
+    def.zoom = sys.zoom;
+    def.native = native;
+    std::string error;
+    if (!defineCustomSystem(def, error)) std::fprintf(stderr, "%s : %s\n", sys.name, error.c_str());
+    return error.empty();
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions opt = parseOptions(argc, argv);
+    loadStartupPlugins();
+    std::vector<int> types;
+    for (int type = 1; type <= Attractor::kSystemCount; type++) types.push_back(type);
+    for (int slot = 0; slot < pluginCount(); slot++) types.push_back(kFirstPluginType + slot);
+
+    std::printf("%-16s %12s %12s %14s\n", "systeme", "ns/pas", "Mpas/s", "etat final x");
+    for (int type : types) {
+        if (opt.onlyType && type != opt.onlyType) continue;
+        Point last{};
+        double ns = benchUpdate(type, opt, last);
+        std::printf("%-16s %12.2f %12.1f %14.5g\n", Attractor::info(type).name, ns, 1e3 / ns, last.x);
+    }
+
+    std::printf("\n%-16s %12s %12s %10s %14s\n", "precision", "float ns/pas", "double ns/pas", "rapport",
+                "pas avant ecart");
+    for (int type : types) {
+        if (opt.onlyType && type != opt.onlyType) continue;
+        Point last{};
+        double single = benchUpdate(type, opt, last, Precision::Single);
+        double exact = benchUpdate(type, opt, last, Precision::Double);
+        long apart = benchDivergence(type, opt);
+        std::printf("%-16s %12.2f %12.2f %10.2f ", Attractor::info(type).name, single, exact, exact / single);
+        if (apart < 0) std::printf("%14s\n", "-");
+        else std::printf("%14ld\n", apart);
+    }
+
+    std::printf("\n%-16s %12s   %s\n", "lyapunov", "ns/pas", "exposants");
+    for (int type : types) {
+        if (opt.onlyType && type != opt.onlyType) continue;
+        LyapunovResult r;
+        double ns = benchLyapunov(type, opt, r);
+        std::printf("%-16s %12.2f  ", Attractor::info(type).name, ns);
+        for (int i = 0; i < r.count; i++) std::printf(" %+9.4f", r.exponents[i]);
+        std::printf("%s\n", r.diverged ? "  (diverge)" : "");
+    }
+
+    std::printf("\n%-16s %12s %12s %14s %14s\n", "balayage", "ns/cellule/pas", "cellules/s", "periode ns/pas",
+                "double ns/pas");
+    for (int type : types) {
+        if (opt.onlyType && type != opt.onlyType) continue;
+        if (Attractor::info(type).paramCount == 0) continue;
+        double lyapCells = 0.0, periodCells = 0.0;
+        double lyapNs = benchSweep(type, opt, SweepMode::Lyapunov, lyapCells);
+        double periodNs = benchSweep(type, opt, SweepMode::Period, periodCells);
+        double doubleCells = 0.0;
+        double doubleNs = benchSweep(type, opt, SweepMode::Lyapunov, doubleCells, Precision::Double);
+        std::printf("%-16s %12.2f %12.0f %14.2f %14.2f\n", Attractor::info(type).name, lyapNs, lyapCells, periodNs,
+                    doubleNs);
+    }
+
+    std::printf("\n%-16s %12s %12s\n", "bifurcation", "ns/col/pas", "colonnes/s");
+    for (int type : types) {
+        if (opt.onlyType && type != opt.onlyType) continue;
+        if (Attractor::info(type).paramCount == 0) continue;
+        double columns = 0.0;
+        double ns = benchBifurcation(type, opt, columns);
+        std::printf("%-16s %12.2f %12.0f\n", Attractor::info(type).name, ns, columns);
+    }
+
+    std::printf("\n%-16s %12s %12s\n", "poincare", "ns/passage", "passages");
+    for (int type : types) {
+        if (opt.onlyType && type != opt.onlyType) continue;
+        const SystemInfo& sys = Attractor::info(type);
+        if (!poincareSupported(type)) continue;
+        long crossings = 0;
+        double ns = benchPoincare(type, opt, crossings);
+        std::printf("%-16s %12.1f %12ld\n", sys.name, ns, crossings);
+    }
+
+    std::printf("\n%-16s %12s %12s %14s\n", "compression", "ns/pt codage", "ns/pt lecture", "octets/point");
+    for (int type : types) {
+        if (opt.onlyType && type != opt.onlyType) continue;
+        double decodeNs = 0.0, bytes = 0.0;
+        double ns = benchCodec(type, opt, decodeNs, bytes);
+        if (ns < 0.0) std::printf("%-16s %12s\n", Attractor::info(type).name, "(diverge)");
+        else std::printf("%-16s %12.2f %12.2f %14.2f\n", Attractor::info(type).name, ns, decodeNs, bytes);
+    }
+
+    // Chua est affine par morceaux : le pas exact reste précis à grand pas
+    if (!opt.onlyType || opt.onlyType == 11) {
+        const double horizon = 10.0;
+        Vec3<double> reference;
+        benchIntegrator(11, Integrator::Exact, 1e-3, horizon, reference);
+        struct Case { Integrator integrator; double dt; };
+        const Case cases[] = {{Integrator::Euler, 1e-3}, {Integrator::RK4, 1e-2}, {Integrator::RK4, 2e-3},
+                              {Integrator::Exact, 1e-1}, {Integrator::Exact, 2e-2}};
+        std::printf("\n%-16s %12s %12s %12s\n", "chua t = 10", "dt", "ns/unite", "ecart final");
+        for (const Case& c : cases) {
+            Vec3<double> end;
+            double ns = benchIntegrator(11, c.integrator, c.dt, horizon, end);
+            double error = std::max({std::fabs(end.x - reference.x), std::fabs(end.y - reference.y),
+                                     std::fabs(end.z - reference.z)});
+            std::printf("%-16s %12g %12.0f %12.2e\n", integratorName(c.integrator), c.dt, ns, error);
+        }
+    }
+
+    // Lorenz est polynomial : la série de Taylor d'ordre élevé tient la
+    // précision machine avec quelques sous-pas par unité de temps
+    if (!opt.onlyType || opt.onlyType == 1) {
+        const double horizon = 5.0;
+        Vec3<double> reference;
+        benchIntegrator(1, Integrator::Taylor, 1e-2, horizon, reference, 30);
+        struct Case { Integrator integrator; double dt; int order; };
+        const Case cases[] = {{Integrator::RK4, 1e-2, 0}, {Integrator::RK4, 1e-3, 0}, {Integrator::RK4, 2e-4, 0},
+                              {Integrator::Taylor, 1e-1, 10}, {Integrator::Taylor, 1e-1, 20},
+                              {Integrator::Taylor, 1.0, 20}};
+        std::printf("\n%-16s %12s %12s %12s\n", "lorenz t = 5", "dt", "ns/unite", "ecart final");
+        for (const Case& c : cases) {
+            Vec3<double> end;
+            double ns = benchIntegrator(1, c.integrator, c.dt, horizon, end, c.order ? c.order : kTaylorOrder);
+            double error = std::max({std::fabs(end.x - reference.x), std::fabs(end.y - reference.y),
+                                     std::fabs(end.z - reference.z)});
+            char name[32];
+            if (c.order) std::snprintf(name, sizeof(name), "%s %d", integratorName(c.integrator), c.order);
+            else std::snprintf(name, sizeof(name), "%s", integratorName(c.integrator));
+            std::printf("%-16s %12g %12.0f %12.2e\n", name, c.dt, ns, error);
+        }
+    }
+
+    // Noyaux natifs : première compilation comprise dans le temps du banc,
+    // pas dans les mesures ; « - » si le compilateur local est indisponible
+    std::printf("\n%-16s %12s %10s %10s %14s %12s %12s\n", "personnalise", "ns/pas", "VM", "JIT",
+                "balayage ns", "VM", "JIT");
+    for (const CustomCase& c : kCustomCases) {
+        if (opt.onlyType && c.type != opt.onlyType) continue;
+        if (!defineCase(c, false)) continue;
+        Point last{};
+        double cells = 0.0;
+        double nativeNs = benchUpdate(c.type, opt, last);
+        double vmNs = benchUpdate(Attractor::kCustomType, opt, last);
+        double nativeSweep = benchSweep(c.type, opt, SweepMode::Lyapunov, cells);
+        double vmSweep = benchSweep(Attractor::kCustomType, opt, SweepMode::Lyapunov, cells);
+        std::printf("%-16s %12.2f %10.2f ", Attractor::info(c.type).name, nativeNs, vmNs);
+        const bool jit = defineCase(c, true) && customBackend().compare(0, 5, "natif") == 0;
+        if (jit) std::printf("%10.2f ", benchUpdate(Attractor::kCustomType, opt, last));
+        else std::printf("%10s ", "-");
+        std::printf("%14.2f %12.2f ", nativeSweep, vmSweep);
+        if (jit) std::printf("%12.2f\n", benchSweep(Attractor::kCustomType, opt, SweepMode::Lyapunov, cells));
+        else std::printf("%12s\n", "-");
+    }
+    return 0;
+}
+/**
+ * bench_main.cpp
+ *
+ * Contient le banc d'essai sans interface graphique (attracteurs_bench).
+ */
@@ -1 +1,60 @@
+#!/usr/bin/env python3
+"""Script de build : enveloppe autour des presets CMake (CMakePresets.json).
 
+    python build.py                      # preset "release"
+    python build.py --preset release-native --bench
+    python build.py --preset debug --test
+    python build.py --pgo                # build instrumenté, entraînement, rebuild
+"""
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+
+ROOT = os.path.dirname(os.path.abspath(__file__))
+
+
+def run(cmd):
+    print("+", " ".join(cmd), flush=True)
+    subprocess.run(cmd, cwd=ROOT, check=True)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compilation d'Attracteur_etrange")
+    parser.add_argument("--preset", default="release",
+                        help="preset CMake (debug, release, relwithdebinfo, release-native, "
+                             "release-portable, release-avx2)")
+    parser.add_argument("--clean", action="store_true", help="supprime le dossier de build avant")
+    parser.add_argument("--test", action="store_true", help="lance ctest après la compilation")
+    parser.add_argument("--bench", action="store_true", help="lance le banc d'essai après la compilation")
+    parser.add_argument("--pgo", action="store_true",
+                        help="optimisation guidée par profil (presets pgo-generate puis pgo-use)")
+    parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count() or 1)
+    args = parser.parse_args()
+
+    if args.pgo:
+        args.preset = "pgo-use"
+        generate_dir = os.path.join(ROOT, "build", "pgo-generate")
+        if args.clean and os.path.isdir(generate_dir):
+            shutil.rmtree(generate_dir)
+        run(["cmake", "--preset", "pgo-generate"])
+        run(["cmake", "--build", "--preset", "pgo-generate", "-j", str(args.jobs)])
+        run(["cmake", "--build", "--preset", "pgo-generate", "--target", "pgo_train"])
+
+    build_dir = os.path.join(ROOT, "build", args.preset)
+    if args.clean and os.path.isdir(build_dir):
+        shutil.rmtree(build_dir)
+
+    run(["cmake", "--preset", args.preset])
+    run(["cmake", "--build", "--preset", args.preset, "-j", str(args.jobs)])
+    if args.test:
+        run(["ctest", "--preset", args.preset])
+    if args.bench:
+        run([os.path.join(build_dir, "attracteurs_bench")])
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
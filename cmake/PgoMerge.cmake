@@ -0,0 +1,13 @@
+# Fusionne les profils bruts de Clang (*.profraw) en merged.profdata.
+# Usage : cmake -DPROFDATA=<llvm-profdata> -DDIR=<dossier des profils> -P PgoMerge.cmake
+file(GLOB raw_profiles "${DIR}/*.profraw")
+if(NOT raw_profiles)
+    message(FATAL_ERROR "Aucun profil .profraw dans ${DIR}")
+endif()
+execute_process(
+    COMMAND ${PROFDATA} merge -o ${DIR}/merged.profdata ${raw_profiles}
+    RESULT_VARIABLE merge_result)
+if(NOT merge_result EQUAL 0)
+    message(FATAL_ERROR "llvm-profdata merge a échoué")
+endif()
+file(REMOVE ${raw_profiles})
@@ -0,0 +1,11 @@
+#include "Cli.h"
+
+// Point d'entrée sans SDL ni ImGui : mêmes commandes que "attracteurs <commande>"
+int main(int argc, char* argv[]) {
+    int code = runCommandLine(argc, argv);
+    if (code < 0) {
+        printCommandLineUsage(argv[0]);
+        return 2;
+    }
+    return code;
+}
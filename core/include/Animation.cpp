@@ -0,0 +1,415 @@
+#include "Animation.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include "Density.h"
+#include "Png.h"
+#include "Utils.h"
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+namespace {
+#ifdef _WIN32
+    const char* kPipeMode = "wb";   // En mode texte, _popen altérerait le flux
+#else
+    const char* kPipeMode = "w";
+#endif
+
+    double now() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Appelle plot(p) pour les s.steps points qui suivent le transitoire
+    template <typename Plot>
+    void simulate(const AnimationSettings& s, const float* params, Plot&& plot) {
+        const SystemInfo& sys = Attractor::info(s.type);
+        dispatchPrecision(s.precision, [&](auto scalar) {
+            using T = decltype(scalar);
+            T k[kMaxParams];
+            std::copy(params, params + kMaxParams, k);
+            dispatchSystem(s.type, [&](auto tag) {
+                constexpr int Type = decltype(tag)::value;
+                const T dt = sys.isMap ? T(1) : T(s.dt);
+                Vec3<T> p = vecCast<T>(s.initial);
+                for (long i = 0; i < s.transient; i++) advance<Type>(s.integrator, k, p, dt, s.taylorOrder);
+                for (long i = 0; i < s.steps; i++) {
+                    advance<Type>(s.integrator, k, p, dt, s.taylorOrder);
+                    plot(vecCast<float>(p));
+                }
+            });
+        });
+    }
+
+    // Projection de Renderer::render, zoom ramené à la hauteur de l'image
+    class Projector {
+    public:
+        Projector(const FrameView& view, int width, int height)
+            : width(width), w(float(width)), h(float(height)), cx(0.5f * width), cy(0.5f * height),
+              cyaw(std::cos(view.yaw)), syaw(std::sin(view.yaw)),
+              cpitch(std::cos(view.pitch)), spitch(std::sin(view.pitch)),
+              zoom(view.zoom * float(height) / float(kReferenceHeight)) {}
+
+        // Indice du pixel de p ; faux hors de l'image (et pour NaN : trajectoire divergente)
+        bool pixel(const Point& p, size_t& index) const {
+            float x = cyaw * p.x + syaw * p.z;
+            float z = -syaw * p.x + cyaw * p.z;
+            float y = cpitch * p.y - spitch * z;
+            float px = cx + x * zoom, py = cy + y * zoom;
+            if (!(px >= 0.0f && px < w && py >= 0.0f && py < h)) return false;
+            index = size_t(py) * size_t(width) + size_t(px);
+            return true;
+        }
+
+    private:
+        int width;
+        float w, h, cx, cy, cyaw, syaw, cpitch, spitch, zoom;
+    };
+
+    void viewColor(const FrameView& view, uint8_t color[3]) {
+        for (int c = 0; c < 3; c++) color[c] = uint8_t(std::clamp(view.color[c], 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+
+    // Paramètres et vue de l'image index
+    void frameState(const AnimationSettings& s, int index, float* k, FrameView& v) {
+        std::copy(s.params, s.params + kMaxParams, k);
+        v = s.view;
+        if (s.mode == AnimationMode::Orbit) {
+            // Dernière image juste avant la première : l'animation boucle
+            v.yaw += 6.2831853f * s.turns * float(index) / float(s.frames);
+        } else if (s.mode == AnimationMode::Morph) {
+            // De from à to, bornes comprises
+            float t = s.frames > 1 ? float(index) / float(s.frames - 1) : 0.0f;
+            k[s.param] = s.from + (s.to - s.from) * t;
+        } else {
+            interpolateKeyframes(s.keyframes, float(index), s.smooth, k, v);
+        }
+    }
+
+    // Hermite entre p1 (en f1) et p2 (en f2), tangentes par différences
+    // centrées sur les voisins p0 (en f0) et p3 (en f3), espacement quelconque
+    float catmullRom(float p0, float p1, float p2, float p3, float f0, float f1, float f2, float f3, float t) {
+        const float span = f2 - f1;
+        const float m1 = (p2 - p0) / (f2 - f0) * span;
+        const float m2 = (p3 - p1) / (f3 - f1) * span;
+        const float t2 = t * t, t3 = t2 * t;
+        return (2.0f * t3 - 3.0f * t2 + 1.0f) * p1 + (t3 - 2.0f * t2 + t) * m1
+             + (-2.0f * t3 + 3.0f * t2) * p2 + (t3 - t2) * m2;
+    }
+
+    // "FRAME\n" puis les plans Y, U et V (BT.601, plage limitée) ; chaque
+    // échantillon de chrominance est la moyenne de quatre pixels (C420jpeg)
+    void encodeY4mFrame(const uint8_t* rgb, int w, int h, std::vector<uint8_t>& out) {
+        static const char tag[] = "FRAME\n";
+        const size_t luma = size_t(w) * h, chroma = luma / 4;
+        out.resize(6 + luma + 2 * chroma);
+        std::memcpy(out.data(), tag, 6);
+        uint8_t* y = out.data() + 6;
+        uint8_t* u = y + luma;
+        uint8_t* v = u + chroma;
+        for (size_t i = 0; i < luma; i++) {
+            int r = rgb[3 * i], g = rgb[3 * i + 1], b = rgb[3 * i + 2];
+            y[i] = uint8_t(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+        }
+        for (int cy = 0; cy < h / 2; cy++) {
+            for (int cx = 0; cx < w / 2; cx++) {
+                int r = 0, g = 0, b = 0;
+                for (int dy = 0; dy < 2; dy++) {
+                    const uint8_t* px = rgb + 3 * (size_t(2 * cy + dy) * w + size_t(2 * cx));
+                    r += px[0] + px[3];
+                    g += px[1] + px[4];
+                    b += px[2] + px[5];
+                }
+                r = (r + 2) / 4;
+                g = (g + 2) / 4;
+                b = (b + 2) / 4;
+                size_t i = size_t(cy) * (w / 2) + size_t(cx);
+                u[i] = uint8_t(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+                v[i] = uint8_t(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+            }
+        }
+    }
+
+    // Remplace le premier %d, %05d... du motif ; faux s'il n'y en a pas
+    bool framePath(const std::string& pattern, int index, std::string& out) {
+        size_t at = pattern.find('%');
+        if (at == std::string::npos) return false;
+        size_t end = at + 1;
+        int width = 0;
+        bool zero = end < pattern.size() && pattern[end] == '0';
+        while (end < pattern.size() && std::isdigit((unsigned char)pattern[end])) width = width * 10 + (pattern[end++] - '0');
+        if (end >= pattern.size() || pattern[end] != 'd' || width > 12) return false;
+        std::string number = std::to_string(index);
+        if (int(number.size()) < width) number.insert(0, size_t(width) - number.size(), zero ? '0' : ' ');
+        out = pattern.substr(0, at) + number + pattern.substr(end + 1);
+        return true;
+    }
+}
+
+void rasterizePoints(const Point* points, size_t count, const FrameView& view, int width, int height, uint8_t* rgb) {
+    std::memset(rgb, 0, size_t(width) * height * 3);
+    const Projector projector(view, width, height);
+    uint8_t color[3];
+    viewColor(view, color);
+    for (size_t i = 0; i < count; i++) {
+        size_t index;
+        if (projector.pixel(points[i], index)) std::memcpy(rgb + 3 * index, color, 3);
+    }
+}
+
+void interpolateKeyframes(const std::vector<Keyframe>& keys, float frame, bool smooth, float* params, FrameView& view) {
+    if (keys.empty()) return;
+    auto copy = [&](const Keyframe& k) {
+        std::copy(k.params, k.params + kMaxParams, params);
+        view = k.view;
+    };
+    if (frame <= float(keys.front().frame)) return copy(keys.front());
+    if (frame >= float(keys.back().frame)) return copy(keys.back());
+
+    size_t i = 1;
+    while (float(keys[i].frame) <= frame) i++;
+    // Segment [k1, k2] et ses voisins, répétés aux extrémités
+    const Keyframe& k1 = keys[i - 1];
+    const Keyframe& k2 = keys[i];
+    const Keyframe& k0 = i >= 2 ? keys[i - 2] : k1;
+    const Keyframe& k3 = i + 1 < keys.size() ? keys[i + 1] : k2;
+    const float f0 = float(k0.frame), f1 = float(k1.frame), f2 = float(k2.frame), f3 = float(k3.frame);
+    const float t = (frame - f1) / (f2 - f1);
+    auto mix = [&](float a0, float a1, float a2, float a3) {
+        return smooth ? catmullRom(a0, a1, a2, a3, f0, f1, f2, f3, t) : a1 + (a2 - a1) * t;
+    };
+    for (int p = 0; p < kMaxParams; p++) params[p] = mix(k0.params[p], k1.params[p], k2.params[p], k3.params[p]);
+    view.yaw = mix(k0.view.yaw, k1.view.yaw, k2.view.yaw, k3.view.yaw);
+    view.pitch = mix(k0.view.pitch, k1.view.pitch, k2.view.pitch, k3.view.pitch);
+    view.zoom = mix(k0.view.zoom, k1.view.zoom, k2.view.zoom, k3.view.zoom);
+    // Couleur toujours linéaire : une spline sortirait de [0, 1]
+    for (int c = 0; c < 3; c++) view.color[c] = k1.view.color[c] + (k2.view.color[c] - k1.view.color[c]) * t;
+}
+
+AnimationSettings::AnimationSettings(int type) : type(type) {
+    const SystemInfo& sys = Attractor::info(type);
+    for (int i = 0; i < kMaxParams; i++) params[i] = sys.paramDefaults[i];
+    initial = sys.initial;
+    view.zoom = sys.zoom;
+    from = sys.paramDefaults[0];
+    to = sys.paramDefaults[0];
+}
+
+AnimationResult runAnimation(const AnimationSettings& settings, const AnimationOutput& output,
+                             AnimationProgress* progress) {
+    AnimationResult result;
+    const double start = now();
+    AnimationSettings s = settings;
+    s.param = std::clamp(s.param, 0, kMaxParams - 1);
+    const bool y4m = output.format == FrameFormat::Y4m;
+    std::string probe;
+    if (s.frames < 1 || s.width < 2 || s.height < 2 || s.width > 16384 || s.height > 16384) {
+        result.error = "nombre d'images ou dimensions invalides";
+        return result;
+    }
+    if (y4m && (s.width % 2 || s.height % 2)) {
+        result.error = "Y4M 4:2:0 : largeur et hauteur paires requises";
+        return result;
+    }
+    if (!y4m && s.frames > 1 && !framePath(output.path, 0, probe)) {
+        result.error = "motif de fichier sans %d (ex. image_%05d.png)";
+        return result;
+    }
+    if (s.mode == AnimationMode::Keyframes) {
+        if (s.keyframes.empty()) {
+            result.error = "aucune image clé";
+            return result;
+        }
+        // Triées, une seule par image (la dernière donnée l'emporte)
+        std::stable_sort(s.keyframes.begin(), s.keyframes.end(),
+                         [](const Keyframe& a, const Keyframe& b) { return a.frame < b.frame; });
+        std::vector<Keyframe> unique;
+        for (const Keyframe& k : s.keyframes) {
+            if (!unique.empty() && unique.back().frame == k.frame) unique.back() = k;
+            else unique.push_back(k);
+        }
+        s.keyframes.swap(unique);
+    }
+
+    FILE* stream = nullptr;
+    const bool piped = y4m && !output.command.empty();
+    if (y4m) {
+#ifndef _WIN32
+        // Encodeur arrêté en cours de route : erreur d'écriture plutôt que SIGPIPE
+        if (piped) std::signal(SIGPIPE, SIG_IGN);
+#endif
+        stream = piped ? popen(output.command.c_str(), kPipeMode) : std::fopen(output.path.c_str(), "wb");
+        if (!stream) {
+            result.error = "impossible d'ouvrir " + (piped ? output.command : output.path);
+            return result;
+        }
+        std::fprintf(stream, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", s.width, s.height, std::max(1, output.fps));
+    }
+
+    // Orbite : une seule trajectoire, partagée en lecture par tous les threads
+    std::vector<Point> shared;
+    if (s.mode == AnimationMode::Orbit) {
+        shared.reserve(size_t(std::max(0L, s.steps)));
+        simulate(s, s.params, [&](const Point& p) { shared.push_back(p); });
+    }
+
+    int threads = s.threads > 0 ? s.threads : int(std::thread::hardware_concurrency());
+    threads = std::clamp(threads, 1, s.frames);
+    const int window = 2 * threads;
+
+    std::mutex mutex;
+    std::condition_variable ready, room;
+    std::map<int, std::vector<uint8_t>> encoded;    // Images prêtes, pas encore écrites
+    int nextFrame = 0, written = 0;
+    bool stop = false;
+
+    auto worker = [&] {
+        Utils::FlushDenormals ftz;
+        const size_t pixels = size_t(s.width) * size_t(s.height);
+        std::vector<uint8_t> rgb(pixels * 3);
+        std::vector<uint8_t> rgba;
+        DensityImage density;
+        if (s.style == FrameStyle::Density) {
+            density.resize(s.width, s.height);
+            rgba.resize(pixels * 4);
+        }
+        float k[kMaxParams];
+        FrameView v;
+        for (;;) {
+            int index;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                room.wait(lock, [&] { return stop || nextFrame >= s.frames || nextFrame < written + window; });
+                if (stop || nextFrame >= s.frames) return;
+                index = nextFrame++;
+            }
+            frameState(s, index, k, v);
+            const Projector projector(v, s.width, s.height);
+            auto trace = [&](auto&& plot) {
+                if (s.mode == AnimationMode::Orbit) {
+                    for (const Point& p : shared) plot(p);
+                } else {
+                    simulate(s, k, plot);
+                }
+            };
+            if (s.style == FrameStyle::Density) {
+                // Accumulation complète de l'image, puis palette (échelle log globale)
+                density.clear();
+                uint32_t* counts = density.counts.data();
+                trace([&](const Point& p) {
+                    size_t i;
+                    if (projector.pixel(p, i)) counts[i]++;
+                });
+                densityToRgba(density, DensityScale::Global, 0, s.width, rgba.data());
+                for (size_t i = 0; i < pixels; i++) std::memcpy(&rgb[3 * i], &rgba[4 * i], 3);
+            } else {
+                std::fill(rgb.begin(), rgb.end(), uint8_t(0));
+                uint8_t color[3];
+                viewColor(v, color);
+                trace([&](const Point& p) {
+                    size_t i;
+                    if (projector.pixel(p, i)) std::memcpy(&rgb[3 * i], color, 3);
+                });
+            }
+            std::vector<uint8_t> bytes;
+            if (y4m) encodeY4mFrame(rgb.data(), s.width, s.height, bytes);
+            else encodePng(rgb.data(), s.width, s.height, 3, 0, bytes);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                encoded[index] = std::move(bytes);
+            }
+            ready.notify_one();
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) pool.emplace_back(worker);
+
+    // Écriture dans l'ordre par le thread appelant
+    for (int index = 0; index < s.frames; index++) {
+        std::vector<uint8_t> bytes;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (!encoded.count(index) && !(progress && progress->cancel)) {
+                ready.wait_for(lock, std::chrono::milliseconds(50));
+            }
+            if (!encoded.count(index)) break;       // Annulé
+            bytes = std::move(encoded[index]);
+            encoded.erase(index);
+        }
+        bool ok;
+        if (y4m) {
+            ok = std::fwrite(bytes.data(), 1, bytes.size(), stream) == bytes.size();
+        } else {
+            std::string path;
+            if (!framePath(output.path, index, path)) path = output.path;    // Image seule
+            FILE* f = std::fopen(path.c_str(), "wb");
+            ok = f && std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+            if (f) ok = std::fclose(f) == 0 && ok;
+            if (!ok) result.error = "écriture impossible : " + path;
+        }
+        if (!ok) {
+            if (result.error.empty()) result.error = piped ? "l'encodeur a cessé de lire le flux" : "écriture impossible : " + output.path;
+            break;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            written = index + 1;
+        }
+        room.notify_all();
+        if (progress) progress->framesDone = written;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    room.notify_all();
+    for (std::thread& t : pool) t.join();
+
+    if (stream) {
+        int status = piped ? pclose(stream) : std::fclose(stream);
+        if (status != 0 && result.error.empty()) {
+            result.error = piped ? "l'encodeur s'est terminé en erreur (" + std::to_string(status) + ")"
+                                 : "écriture impossible : " + output.path;
+        }
+    }
+    result.frames = written;
+    result.seconds = now() - start;
+    if (result.error.empty() && written < s.frames) result.error = "annulé";
+    return result;
+}
+
+AnimationExport::~AnimationExport() {
+    cancel();
+}
+
+void AnimationExport::start(const AnimationSettings& settings, const AnimationOutput& output) {
+    cancel();
+    progress.framesDone = 0;
+    progress.cancel = false;
+    total = settings.frames;
+    running = true;
+    thread = std::thread([this, settings, output] {
+        last = runAnimation(settings, output, &progress);
+        running = false;
+    });
+}
+
+void AnimationExport::cancel() {
+    progress.cancel = true;
+    if (thread.joinable()) thread.join();
+}
+/**
+ * Animation.cpp
+ *
+ * Contient le tracé hors écran, la simulation de chaque image, les threads de
+ * rendu et d'encodage et l'écriture ordonnée des images.
+ */
@@ -1,146 +1,130 @@
-#include <SDL/Graphics.hpp>
-#include <vector>
-#include <cmath>
 #include "Attractor.h"
-#include "Utils.h"
+#include <algorithm>
+#include <cctype>
+#include "CustomSystem.h"
+#include "Plugins.h"
 
-struct Point { float x, y, z; };
+namespace {
+    // Registre : index = type - 1 (points de départ et zooms de attracteurs.cpp)
+    const SystemInfo kSystems[Attractor::kSystemCount] = {
+        {"Lorenz",        {0.1f, 0.0f, 0.0f},  15.0f, 3, false, 3, {"sigma", "rho", "beta"}, {10.0f, 28.0f, 8.0f / 3.0f}},
+        {"Rössler",       {0.1f, 0.0f, 0.0f},  15.0f, 3, false, 3, {"a", "b", "c"}, {0.2f, 0.2f, 5.7f}},
+        {"Aizawa",        {0.1f, 1.0f, 0.0f}, 150.0f, 3, false, 6, {"a", "b", "c", "d", "e", "f"}, {0.95f, 0.7f, 0.6f, 3.5f, 0.25f, 0.1f}},
+        {"Thomas",        {0.1f, 1.0f, 0.0f}, 150.0f, 3, false, 1, {"b"}, {0.2081f}},
+        {"Hénon",         {0.1f, 0.1f, 0.0f}, 150.0f, 2, true,  2, {"a", "b"}, {1.4f, 0.3f}},
+        {"Ikeda",         {0.1f, 1.0f, 0.0f}, 150.0f, 2, true,  1, {"u"}, {0.9f}},
+        {"Duffing",       {0.1f, 1.0f, 0.0f}, 150.0f, 3, false, 3, {"delta", "gamma", "omega"}, {0.35f, 0.3f, 1.4f}},
+        {"Van der Pol",   {0.1f, 1.0f, 0.0f}, 150.0f, 2, false, 1, {"mu"}, {1.5f}},
+        {"Clifford",      {0.1f, 1.0f, 0.0f}, 150.0f, 2, true,  4, {"a", "b", "c", "d"}, {1.5f, -1.8f, 1.6f, 2.0f}},
+        {"Gumowski-Mira", {0.1f, 1.0f, 0.0f}, 150.0f, 2, true,  2, {"a", "mu"}, {0.05f, -0.75f}},
+        {"Chua",          {0.1f, 0.0f, 0.0f}, 150.0f, 3, false, 4, {"alpha", "beta", "m0", "m1"}, {15.6f, 28.0f, -1.143f, -0.714f}},
+        {"Tamari",        {0.1f, 1.0f, 0.0f}, 200.0f, 3, false, 0, {}, {}},
+        {"Kaplan-Yorke",  {0.1f, 0.1f, 1.0f}, 200.0f, 2, true,  1, {"alpha"}, {0.2f}},
+        {"Double Scroll", {0.1f, 0.1f, 0.1f},  10.0f, 3, false, 2, {"a", "b"}, {0.7f, 7.0f}},
+    };
 
-class Attractor {
-public:
-    int type = 1;
-    Point p = {0.1, 0.0, 0.0};
-    float dt = 0.05;
-
-    void update() {
-        float dx, dy, dz;
-        if (type == 1) { // Lorenz
-            dx = (10 * (p.y - p.x));
-            dy = (p.x * (28 - p.z) - p.y);
-            dz = (p.x * p.y - (8.0f/3.0f) * p.z);
-        } else if (type == 2) { // Rössler
-            dx = (-p.y - p.z);
-            dy = (p.x + 0.2f * p.y);
-            dz = (0.2f + p.z * (p.x - 5.7f));
-        } else if (type == 3) { // Aizawa
-            dx = (p.z - 0.7f) * p.x - 3.5f * p.y;
-            dy = 3.5f * p.x + (p.z - 0.7f) * p.y;
-            dz = 0.6f + 0.95f * p.z - (std::pow(p.z, 3)/3.0f) - (std::pow(p.x, 2) + std::pow(p.y, 2)) * (1.0f + 0.25f * p.z) + 0.1f * p.z * std::pow(p.x, 3);
-        } else if (type == 4) { // Thomas
-            dx = std::sin(p.y) - 0.2081f * p.x;
-            dy = std::sin(p.z) - 0.2081f * p.y;
-            dz = std::sin(p.x) - 0.2081f * p.z;
-            dt = 0.1; // Plus lent pour Thomas
-        } else if (type == 5) { // Hénon (Adapté en continu pour le tracé)
-            dx = (1.0f - 1.4f * p.x * p.x + p.y) - p.x;
-            dy = (0.3f * p.x) - p.y;
-            dz = 0;
-        } else if (type == 6) { // Ikeda
-    float t = 0.4f - 6.0f / (1.0f + p.x * p.x + p.y * p.y);
-    dx = (1.0f + 0.9f * (p.x * cos(t) - p.y * sin(t))) - p.x;
-    dy = (0.9f * (p.x * sin(t) + p.y * cos(t))) - p.y;
-    dz = 0;
-}
-else if (type == 7) { // Duffing
-    dx = p.y;
-    dy = (p.x - p.x * p.x * p.x - 0.35f * p.y + 0.3f * cos(p.z));
-    dz = 1.4f; // Évolution de la phase temporelle
-}
-else if (type == 8) { // Van der Pol
-    float mu = 1.5f;
-    dx = mu * (p.x - (1.0f/3.0f) * p.x * p.x * p.x - p.y);
-    dy = p.x / mu;
-    dz = 0;
-}
-else if (type == 9) { // Clifford (Pickover)
-    // Paramètres classiques : a=1.5, b=-1.8, c=1.6, d=2.0
-    dx = (sin(1.5f * p.y) + 1.6f * cos(1.5f * p.x)) - p.x;
-    dy = (sin(-1.8f * p.x) + 2.0f * cos(-1.8f * p.y)) - p.y;
-    dz = 0;
-}
-else if (type == 10) { // Gumowski-Mira
-    auto f_gm = [](float x) { return -0.75f * x + 2.0f * (1.0f + 0.75f) * x * x / (1.0f + x * x); };
-    float nextX = 0.05f * p.y + f_gm(p.x);
-    dx = nextX - p.x;
-    dy = (-p.x + f_gm(nextX)) - p.y;
-    dz = 0;
-}
-else if (type == 11) { // Chua (Circuit)
-    
-    float h = -0.714f * p.x + 0.5f * (-1.143f + 0.714f) * (abs(p.x + 1.0f) - abs(p.x - 1.0f));
-    dx = 15.6f * (p.y - p.x - h);
-    dy = p.x - p.y + p.z;
-    dz = -28.0f * p.y;
-}
-else if (type == 12) { // Tamari
-    dx = p.x - p.y * p.z;
-    dy = p.x * p.z - p.y;
-    dz = p.z + (p.x * p.y / 3.0f);
+    const SystemInfo kUndefined = {"Personnalisé", {0.1f, 0.0f, 0.0f}, 15.0f, 3, false, 0, {}, {}};
 }
-else if (type == 13) { // Kaplan-Yorke
-    dx = (2.0f * p.x - floor(2.0f * p.x)) - p.x; // Modulo 1 simplifié
-    dy = (0.2f * p.y + cos(4.0f * 3.14159f * p.x)) - p.y;
-    dz = 0;
-}
-else (type == 14) { // Double Scroll
-    dx = 0.7f * (p.y - p.x);
-    dy = p.x - p.x * p.z + 7.0f * p.y;
-    dz = p.x * p.y - 0.7f * p.z;
+
+const char* integratorName(Integrator integrator) {
+    if (integrator == Integrator::RK4) return "rk4";
+    if (integrator == Integrator::Exact) return "exact";
+    if (integrator == Integrator::Taylor) return "taylor";
+    return "euler";
 }
 
-        p.x += dx * dt; p.y += dy * dt; p.z += dz * dt;
+bool findIntegrator(const std::string& name, Integrator& out) {
+    for (Integrator i : {Integrator::Euler, Integrator::RK4, Integrator::Exact, Integrator::Taylor}) {
+        if (name == integratorName(i)) {
+            out = i;
+            return true;
+        }
     }
-};
-
-int main() {
-    sf::RenderWindow window(sf::VideoMode(1000, 800), "Attracteurs Etranges 2026");
-    window.setFramerateLimit(144);
-    
-    Attractor att;
-    std::vector<sf::Vertex> points;
-    float zoom = 15.0f;
+    return false;
+}
 
-    while (window.isOpen()) {
-        sf::Event event;
-        while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) window.close();
-            if (event.type == sf::Event::KeyPressed) {
-                points.clear();
-                
-                if (event.key.code == sf::Keyboard::Num1) { att.type = 1; points.clear(); att.p = {0.1, 0, 0}; zoom = 15; }
-                if (event.key.code == sf::Keyboard::Num2) { att.type = 2; points.clear(); att.p = {0.1, 0, 0}; zoom = 15; }
-                if (event.key.code == sf::Keyboard::Num3) { att.type = 3; points.clear(); att.p = {0.1, 1, 0}; zoom = 150; }
-                if (event.key.code == sf::Keyboard::Num4) { att.type = 4; points.clear(); att.p = {0.1, 1, 0}; zoom = 150; }
-                if (event.key.code == sf::Keyboard::Num5) { att.type = 5; points.clear(); att.p = {0.1, 1, 0}; zoom = 150; }
-                if (event.key.code == sf::Keyboard::Num6) { att.type = 6; points.clear(); att.p = {0.1, 1, 0}; zoom = 150; }
-                if (event.key.code == sf::Keyboard::Num7) { att.type = 7; points.clear(); att.p = {0.1, 1, 0}; zoom = 150; }
-                if (event.key.code == sf::Keyboard::Num8) { att.type = 8; points.clear(); att.p = {0.1, 1, 0}; zoom = 150; }
-                if (event.key.code == sf::Keyboard::Num9) { att.type = 9; points.clear(); att.p = {0.1, 1, 0}; zoom = 150; }
-                if (event.key.code == sf::Keyboard::Num10) { att.type = 10; points.clear(); att.p = {0.1, 1, 0}; zoom = 150; }
-                if (event.key.code == sf::Keyboard::Num11) { att.type = 11; points.clear(); att.p = {0.1, 1, 0}; zoom = 150; }
-                if (event.key.code == sf::Keyboard::Num12) { att.type = 12; points.clear(); att.p = {0.1, 1, 0}; zoom = 200; }
-                if (event.key.code == sf::Keyboard::Num13) { att.type = 13; points.clear(); att.p = {0.1, 0.1, 1}; zoom = 200; }
+const SystemInfo& Attractor::info(int type) {
+    if (type == kCustomType) {
+        const SystemInfo* custom = customSystemInfo();
+        return custom ? *custom : kUndefined;
+    }
+    if (const SystemInfo* plugin = pluginSystemInfo(type - kFirstPluginType)) return *plugin;
+    if (type < 1 || type > kSystemCount) type = 1;
+    return kSystems[type - 1];
+}
 
-                /Modification de l attracteur 14 (Double scroll)
-                 if (event.key.code == sf::Keyboard::Num1) { 
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::LShift)) { // Utilise Shift+1 pour le 14
-            att.type = 14; att.p = {0.1, 0.1, 0.1}; zoom = 10;
+int Attractor::find(const std::string& name) {
+    auto same = [](const char* a, const char* b) {
+        for (; *a && *b; a++, b++) {
+            if (std::tolower((unsigned char)*a) != std::tolower((unsigned char)*b)) return false;
+        }
+        return *a == *b;
+    };
+    for (int t = 1; t <= kSystemCount; t++) {
+        if (same(kSystems[t - 1].name, name.c_str())) return t;
+    }
+    // Sans accents
+    if (same(name.c_str(), "rossler")) return 2;
+    if (same(name.c_str(), "henon")) return 5;
+    const SystemInfo* custom = customSystemInfo();
+    if (custom && (same(name.c_str(), "custom") || same(name.c_str(), kUndefined.name) || same(name.c_str(), custom->name))) {
+        return kCustomType;
+    }
+    for (int slot = 0; slot < kPluginSlots; slot++) {
+        const SystemInfo* plugin = pluginSystemInfo(slot);
+        if (plugin && same(name.c_str(), plugin->name)) return kFirstPluginType + slot;
+    }
+    return 0;
+}
 
+bool Attractor::available(int type) {
+    return (type >= 1 && type <= kSystemCount) || (type == kCustomType && customSystemInfo())
+        || pluginSystemInfo(type - kFirstPluginType);
+}
 
+void Attractor::reset() {
+    p = info(type).initial;
+}
 
+void Attractor::select(int newType) {
+    type = newType;
+    const SystemInfo& sys = info(type);
+    for (int i = 0; i < kMaxParams; i++) params[i] = sys.paramDefaults[i];
+    reset();
+}
 
-            }
-        }
+Vec3<double> Attractor::state() const {
+    const bool current = p.x == rounded.x && p.y == rounded.y && p.z == rounded.z;
+    return precision == Precision::Double && current ? exact : vecCast<double>(p);
+}
 
-        for(int i=0; i<5; i++) { // Calculer 5 points par frame pour la vitesse
-            att.update();
-            sf::Color col = sf::Color::Cyan;
-            points.push_back(sf::Vertex(sf::Vector2f(500 + att.p.x * zoom, 400 + att.p.y * zoom), col));
-        }
+void Attractor::setState(const Vec3<double>& s) {
+    exact = s;
+    p = rounded = vecCast<float>(s);
+}
 
-        window.clear(sf::Color::Black);
-        window.draw(&points[0], points.size(), sf::Points);
-        window.display();
+void Attractor::update() {
+    // Les équations des 14 systèmes sont dans Systems.h, celles du système
+    // personnalisé dans ses programmes compilés (CustomSystem.h), celles des
+    // greffons dans leurs bibliothèques (Plugins.h)
+    const Integrator used = info(type).isMap ? Integrator::Euler : integrator;
+    if (precision == Precision::Single) {
+        dispatchSystem(type, [&](auto tag) {
+            advance<decltype(tag)::value>(used, params, p, dt, taylorOrder);
+        });
+        return;
     }
-    return 0;
+    if (p.x != rounded.x || p.y != rounded.y || p.z != rounded.z) exact = vecCast<double>(p);
+    double k[kMaxParams];
+    std::copy(params, params + kMaxParams, k);
+    dispatchSystem(type, [&](auto tag) {
+        advance<decltype(tag)::value>(used, k, exact, double(dt), taylorOrder);
+    });
+    p = rounded = vecCast<float>(exact);
 }
+/**
+ * Attractor.cpp
+ *
+ * Contient le registre des 14 systèmes, du système personnalisé et des
+ * greffons et l'intégration (Euler ou RK4, en simple ou double précision).
+ */
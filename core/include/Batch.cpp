@@ -0,0 +1,264 @@
+#include "Batch.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include "Toml.h"
+
+namespace {
+    double now() {
+        using namespace std::chrono;
+        return duration<double>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Valeur TOML -> texte d'option : entiers sans exposant (--steps 10000000),
+    // tableaux séparés par des virgules (--color 0,1,1)
+    bool optionText(const Json& v, std::string& out) {
+        char buffer[32];
+        switch (v.kind) {
+        case Json::Kind::String: out = v.text; return true;
+        case Json::Kind::Bool: out = v.boolean ? "1" : "0"; return true;
+        case Json::Kind::Number:
+            if (v.number == std::floor(v.number) && std::fabs(v.number) < 9.0e15) std::snprintf(buffer, sizeof(buffer), "%.0f", v.number);
+            else std::snprintf(buffer, sizeof(buffer), "%.9g", v.number);
+            out = buffer;
+            return true;
+        case Json::Kind::Array:
+            out.clear();
+            for (size_t i = 0; i < v.items.size(); i++) {
+                std::string item;
+                if (v.items[i].isArray() || !optionText(v.items[i], item)) return false;
+                out += (i ? "," : "") + item;
+            }
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool readJob(const Json& table, size_t index, BatchJob& job, std::string& error) {
+        const std::string where = "tâche " + std::to_string(index + 1);
+        job.name = "job-" + std::to_string(index + 1);
+        for (const auto& [key, value] : table.members) {
+            if (key == "name" || key == "command") {
+                if (!value.isString() || value.text.empty()) {
+                    error = where + " : " + key + " doit être une chaîne non vide";
+                    return false;
+                }
+                (key == "name" ? job.name : job.command) = value.text;
+            } else if (key == "after") {
+                bool ok = value.isArray();
+                for (size_t i = 0; ok && i < value.items.size(); i++) {
+                    ok = value.items[i].isString();
+                    if (ok) job.after.push_back(value.items[i].text);
+                }
+                if (!ok) {
+                    error = where + " : after doit être un tableau de noms";
+                    return false;
+                }
+            } else {
+                std::string text;
+                if (!optionText(value, text)) {
+                    error = where + " : valeur de " + key + " non prise en charge";
+                    return false;
+                }
+                if (key == "threads") {
+                    if (!value.isNumber() || value.number < 1) {
+                        error = where + " : threads doit être un entier positif";
+                        return false;
+                    }
+                    // Passé à la commande par commandBatch, borné au budget
+                    job.threads = int(value.number);
+                    continue;
+                }
+                if (key == "system" || key == "equations") job.customSystem = true;
+                job.options.emplace_back(key, text);
+            }
+        }
+        if (job.command.empty()) {
+            error = where + " (" + job.name + ") : command manquant";
+            return false;
+        }
+        return true;
+    }
+
+    // Noms uniques, dépendances existantes et sans cycle
+    bool checkGraph(const std::vector<BatchJob>& jobs, std::string& error) {
+        std::map<std::string, size_t> index;
+        for (size_t i = 0; i < jobs.size(); i++) {
+            if (!index.emplace(jobs[i].name, i).second) {
+                error = "tâche " + jobs[i].name + " définie deux fois";
+                return false;
+            }
+        }
+        for (const BatchJob& job : jobs) {
+            for (const std::string& dep : job.after) {
+                if (!index.count(dep)) {
+                    error = job.name + " : tâche inconnue dans after : " + dep;
+                    return false;
+                }
+            }
+        }
+        // Parcours en profondeur : 1 en cours, 2 terminé
+        std::vector<int> mark(jobs.size(), 0);
+        std::function<bool(size_t)> visit = [&](size_t i) {
+            if (mark[i] == 2) return true;
+            if (mark[i] == 1) {
+                error = "dépendance circulaire autour de " + jobs[i].name;
+                return false;
+            }
+            mark[i] = 1;
+            for (const std::string& dep : jobs[i].after) {
+                if (!visit(index[dep])) return false;
+            }
+            mark[i] = 2;
+            return true;
+        };
+        for (size_t i = 0; i < jobs.size(); i++) {
+            if (!visit(i)) return false;
+        }
+        return true;
+    }
+}
+
+bool parseBatch(const std::string& text, BatchFile& out, std::string& error) {
+    out = BatchFile();
+    Json doc;
+    if (!parseToml(text, doc, error)) return false;
+    for (const auto& [key, value] : doc.members) {
+        if (key == "threads") {
+            if (!value.isNumber() || value.number < 0) {
+                error = "threads doit être un entier positif ou nul";
+                return false;
+            }
+            out.threads = int(value.number);
+        } else if (key == "job" && value.isArray()) {
+            for (size_t i = 0; i < value.items.size(); i++) {
+                BatchJob job;
+                if (!readJob(value.items[i], i, job, error)) return false;
+                out.jobs.push_back(std::move(job));
+            }
+        } else {
+            error = "clé inconnue : " + key + " (threads ou [[job]] attendus)";
+            return false;
+        }
+    }
+    if (out.jobs.empty()) {
+        error = "aucune tâche [[job]]";
+        return false;
+    }
+    return checkGraph(out.jobs, error);
+}
+
+bool readBatchFile(const std::string& path, BatchFile& out, std::string& error) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        error = "lecture impossible";
+        return false;
+    }
+    std::ostringstream text;
+    text << in.rdbuf();
+    return parseBatch(text.str(), out, error);
+}
+
+BatchReport runBatch(const std::vector<BatchJob>& jobs, int budget, const std::function<int(const BatchJob&)>& run,
+                     const std::function<void(size_t, const BatchJobResult&)>& finished) {
+    enum class State { Pending, Running, Over };
+    BatchReport report;
+    report.budget = std::max(1, budget);
+    report.jobs.resize(jobs.size());
+    std::map<std::string, size_t> index;
+    for (size_t i = 0; i < jobs.size(); i++) index.emplace(jobs[i].name, i);
+
+    std::vector<State> state(jobs.size(), State::Pending);
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable changed;
+    int freeThreads = report.budget;
+    int running = 0;
+    bool customRunning = false;     // Une tâche installe le système personnalisé
+    const double start = now();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        // Nouvelle passe après chaque abandon : les tâches qui en dépendent
+        // peuvent le précéder dans le fichier
+        for (bool again = true; again;) {
+            again = false;
+            for (size_t i = 0; i < jobs.size(); i++) {
+                if (state[i] != State::Pending) continue;
+                bool ready = true, blocked = false;
+                for (const std::string& dep : jobs[i].after) {
+                    auto it = index.find(dep);
+                    if (it == index.end()) continue;
+                    const size_t d = it->second;
+                    if (state[d] != State::Over) ready = false;
+                    else if (report.jobs[d].status != BatchStatus::Done) blocked = true;
+                }
+                BatchJobResult& r = report.jobs[i];
+                if (blocked) {
+                    state[i] = State::Over;
+                    r.status = BatchStatus::Skipped;
+                    r.start = now() - start;
+                    if (finished) finished(i, r);
+                    again = true;
+                    continue;
+                }
+                r.threads = std::clamp(jobs[i].threads, 1, report.budget);
+                if (!ready || r.threads > freeThreads || (jobs[i].customSystem && customRunning)) continue;
+
+                state[i] = State::Running;
+                freeThreads -= r.threads;
+                customRunning = customRunning || jobs[i].customSystem;
+                running++;
+                report.peakThreads = std::max(report.peakThreads, report.budget - freeThreads);
+                r.start = now() - start;
+                workers.emplace_back([&, i] {
+                    int code = 1;
+                    try {
+                        code = run(jobs[i]);
+                    } catch (const std::exception& e) {
+                        std::fprintf(stderr, "%s : %s\n", jobs[i].name.c_str(), e.what());
+                    }
+                    std::lock_guard<std::mutex> done(mutex);
+                    BatchJobResult& result = report.jobs[i];
+                    result.code = code;
+                    result.status = code == 0 ? BatchStatus::Done : BatchStatus::Failed;
+                    result.seconds = now() - start - result.start;
+                    state[i] = State::Over;
+                    freeThreads += result.threads;
+                    running--;
+                    if (jobs[i].customSystem) customRunning = false;
+                    if (finished) finished(i, result);
+                    changed.notify_one();
+                });
+            }
+        }
+        bool pending = std::find(state.begin(), state.end(), State::Pending) != state.end();
+        if (!running) {
+            // Reste en attente sans rien en cours : dépendances impossibles
+            for (size_t i = 0; pending && i < jobs.size(); i++) {
+                if (state[i] == State::Pending) state[i] = State::Over;
+            }
+            break;
+        }
+        changed.wait(lock);
+    }
+    lock.unlock();
+    for (std::thread& t : workers) t.join();
+    report.seconds = now() - start;
+    return report;
+}
+/**
+ * Batch.cpp
+ *
+ * Contient la lecture des fichiers de tâches et l'ordonnanceur qui les
+ * exécute en parallèle dans la limite d'un budget de cœurs.
+ */
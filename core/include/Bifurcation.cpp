@@ -0,0 +1,228 @@
+#include "Bifurcation.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include "Utils.h"
+
+namespace {
+    double now() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    float coord(const Point& p, int axis) {
+        return axis == 0 ? p.x : axis == 1 ? p.y : p.z;
+    }
+
+    float columnParam(const BifurcationSettings& s, int col) {
+        return s.columns > 1 ? s.pMin + (s.pMax - s.pMin) * float(col) / float(s.columns - 1) : s.pMin;
+    }
+
+    // Appelle sink(v) pour chaque valeur enregistrée après le transitoire
+    template <int Type, typename Sink>
+    void sampleColumn(const BifurcationSettings& s, float paramValue, long steps, Sink&& sink) {
+        const SystemInfo& sys = Attractor::info(Type);
+        float k[kMaxParams];
+        for (int i = 0; i < kMaxParams; i++) k[i] = s.params[i];
+        k[s.param] = paramValue;
+        const float dt = sys.isMap ? 1.0f : s.dt;
+
+        Point p = s.initial;
+        for (long i = 0; i < s.transient; i++) step<Type>(k, p, dt);
+
+        if (sys.isMap) {
+            for (long n = 0; n < steps; n++) {
+                step<Type>(k, p, dt);
+                if (!std::isfinite(p.x) || !std::isfinite(p.y)) return;
+                sink(coord(p, s.axis));
+            }
+        } else if (s.record == BifurcationRecord::Maxima) {
+            float a0 = coord(p, s.axis);
+            step<Type>(k, p, dt);
+            float a1 = coord(p, s.axis);
+            for (long n = 0; n < steps; n++) {
+                step<Type>(k, p, dt);
+                float a2 = coord(p, s.axis);
+                if (a1 > a0 && a1 >= a2) {
+                    // Sommet de la parabole passant par les trois derniers points
+                    float a = 0.5f * (a0 + a2) - a1;
+                    float b = 0.5f * (a2 - a0);
+                    sink(a < 0.0f ? a1 - b * b / (4.0f * a) : a1);
+                }
+                a0 = a1;
+                a1 = a2;
+                if ((n & 1023) == 0 && !std::isfinite(a2)) return;
+            }
+        } else {
+            for (long n = 0; n < steps; n++) {
+                Point prev = p;
+                step<Type>(k, p, dt);
+                float g0 = coord(prev, s.sectionAxis) - s.sectionLevel;
+                float g1 = coord(p, s.sectionAxis) - s.sectionLevel;
+                if (g0 < 0.0f && g1 >= 0.0f) {
+                    float t = g0 / (g0 - g1);
+                    sink(coord(prev, s.axis) + t * (coord(p, s.axis) - coord(prev, s.axis)));
+                }
+                if ((n & 1023) == 0 && !std::isfinite(g1)) return;
+            }
+        }
+    }
+
+    // Plage automatique : quelques colonnes réparties, trajectoires plus courtes
+    template <int Type>
+    void estimateRange(const BifurcationSettings& s, float& lo, float& hi) {
+        lo = INFINITY;
+        hi = -INFINITY;
+        const int probes = std::min(16, std::max(1, s.columns));
+        for (int i = 0; i < probes; i++) {
+            int col = probes > 1 ? i * (s.columns - 1) / (probes - 1) : 0;
+            sampleColumn<Type>(s, columnParam(s, col), std::max(1000L, s.steps / 4), [&](float v) {
+                if (!std::isfinite(v) || std::fabs(v) > 1e6f) return;
+                lo = std::min(lo, v);
+                hi = std::max(hi, v);
+            });
+        }
+        if (!(lo < hi)) {
+            float c = std::isfinite(lo) ? lo : 0.0f;
+            lo = c - 1.0f;
+            hi = c + 1.0f;
+        }
+        float margin = 0.05f * (hi - lo);
+        lo -= margin;
+        hi += margin;
+    }
+}
+
+BifurcationSettings::BifurcationSettings(int type) : type(type) {
+    const SystemInfo& sys = Attractor::info(type);
+    for (int i = 0; i < kMaxParams; i++) params[i] = sys.paramDefaults[i];
+    initial = sys.initial;
+    param = std::max(0, sys.paramCount - 1);
+    pMin = sys.paramDefaults[param] * 0.5f;
+    pMax = sys.paramDefaults[param] * 1.5f;
+}
+
+BifurcationDiagram::~BifurcationDiagram() {
+    cancel();
+}
+
+void BifurcationDiagram::start(const BifurcationSettings& settings) {
+    launch(settings, nullptr);
+}
+
+bool BifurcationDiagram::resume(const BifurcationCheckpoint& checkpoint) {
+    const BifurcationSettings& s = checkpoint.settings;
+    if (s.columns < 1 || checkpoint.image.width != s.columns || checkpoint.image.height != s.rows ||
+        checkpoint.columns.size() != size_t(s.columns) || !(s.vMin < s.vMax)) return false;
+    launch(s, &checkpoint);
+    return true;
+}
+
+void BifurcationDiagram::launch(const BifurcationSettings& settings, const BifurcationCheckpoint* from) {
+    cancel();
+    current = settings;
+    current.columns = std::max(1, current.columns);
+    current.rows = std::max(1, current.rows);
+    current.param = std::clamp(current.param, 0, kMaxParams - 1);
+    density.resize(current.columns, current.rows);
+    columnFlags.reset(new std::atomic<uint8_t>[current.columns]);
+    for (int c = 0; c < current.columns; c++) columnFlags[c] = 0;
+    nextColumn = 0;
+    done = 0;
+    cancelRequested = false;
+    rangeMin = current.vMin;
+    rangeMax = current.vMax;
+    rangeOnce.reset(new std::once_flag);
+    startTime = now();
+    previousSeconds = 0.0;
+    int remaining = current.columns;
+    if (from) {
+        density = from->image;
+        for (int c = 0; c < current.columns; c++) columnFlags[c] = from->columns[size_t(c)] ? 1 : 0;
+        remaining -= done = int(std::count(from->columns.begin(), from->columns.end(), uint8_t(1)));
+        previousSeconds = from->seconds;
+        elapsed = from->seconds;
+        if (remaining == 0) return;
+    }
+
+    int threads = current.threads > 0 ? current.threads : int(std::thread::hardware_concurrency());
+    threads = std::clamp(threads, 1, remaining);
+    activeThreads = threads;
+    for (int t = 0; t < threads; t++) pool.emplace_back(&BifurcationDiagram::worker, this);
+}
+
+void BifurcationDiagram::worker() {
+    Utils::FlushDenormals ftz;
+    const BifurcationSettings& s = current;
+    dispatchSystem(s.type, [&](auto tag) {
+        constexpr int Type = decltype(tag)::value;
+        // Un seul thread estime la plage, les autres l'attendent
+        std::call_once(*rangeOnce, [&] {
+            if (s.vMin == s.vMax) {
+                float lo, hi;
+                estimateRange<Type>(s, lo, hi);
+                rangeMin = lo;
+                rangeMax = hi;
+            }
+        });
+        const float lo = rangeMin, hi = rangeMax;
+        const float scale = float(s.rows) / (hi - lo);
+
+        for (int col = nextColumn++; col < s.columns && !cancelRequested; col = nextColumn++) {
+            if (columnDone(col)) continue;      // Déjà calculée (reprise)
+            sampleColumn<Type>(s, columnParam(s, col), s.steps, [&](float v) {
+                float r = (hi - v) * scale;   // Valeurs hautes en haut de l'image
+                if (r >= 0.0f && r < float(s.rows)) density.counts[size_t(r) * s.columns + col]++;
+            });
+            columnFlags[col].store(1, std::memory_order_release);
+            done++;
+        }
+    });
+    if (--activeThreads == 0) elapsed = previousSeconds + now() - startTime;
+}
+
+void BifurcationDiagram::cancel() {
+    cancelRequested = true;
+    wait();
+}
+
+void BifurcationDiagram::wait() {
+    for (std::thread& t : pool) t.join();
+    pool.clear();
+}
+
+double BifurcationDiagram::seconds() const {
+    return isRunning() ? previousSeconds + now() - startTime : elapsed.load();
+}
+
+void BifurcationDiagram::snapshot(BifurcationCheckpoint& out) const {
+    out.settings = current;
+    out.settings.vMin = rangeMin;
+    out.settings.vMax = rangeMax;
+    out.seconds = seconds();
+    out.columns.assign(size_t(current.columns), 0);
+    out.image.resize(density.width, density.height);
+    if (!columnFlags) return;
+    // Seules les colonnes terminées sont lues : les autres sont en cours d'écriture
+    for (int c = 0; c < current.columns; c++) {
+        if (!columnDone(c)) continue;
+        out.columns[size_t(c)] = 1;
+        for (int r = 0; r < density.height; r++) {
+            size_t i = size_t(r) * size_t(density.width) + size_t(c);
+            out.image.counts[i] = density.counts[i];
+        }
+    }
+}
+
+DensityImage computeBifurcation(BifurcationSettings settings) {
+    BifurcationDiagram diagram;
+    diagram.start(settings);
+    diagram.wait();
+    return diagram.image();
+}
+/**
+ * Bifurcation.cpp
+ *
+ * Contient le calcul des colonnes du diagramme de bifurcation : chaque thread
+ * prend la prochaine valeur du paramètre, ignore le transitoire puis accumule
+ * les maxima locaux, les passages par une section ou les itérés.
+ */
@@ -0,0 +1,56 @@
+#include "Checksum.h"
+#include <cstring>
+
+namespace {
+    // Quatre tables : quatre octets par tour
+    struct CrcTables {
+        uint32_t t[4][256];
+        CrcTables() {
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; k++) c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                t[0][i] = c;
+            }
+            for (uint32_t i = 0; i < 256; i++) {
+                for (int s = 1; s < 4; s++) t[s][i] = (t[s - 1][i] >> 8) ^ t[0][t[s - 1][i] & 0xFF];
+            }
+        }
+    };
+}
+
+uint32_t crc32(uint32_t crc, const void* data, size_t bytes) {
+    static const CrcTables tables;
+    const auto& t = tables.t;
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    for (; bytes >= 4; bytes -= 4, p += 4) {
+        uint32_t w;
+        std::memcpy(&w, p, sizeof(w));
+        crc ^= w;
+        crc = t[3][crc & 0xFF] ^ t[2][(crc >> 8) & 0xFF] ^ t[1][(crc >> 16) & 0xFF] ^ t[0][crc >> 24];
+    }
+    while (bytes--) crc = t[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+uint32_t adler32(uint32_t adler, const void* data, size_t bytes) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    uint32_t a = adler & 0xFFFF, b = adler >> 16;
+    while (bytes > 0) {
+        // 5552 octets au plus entre deux réductions : b reste < 2^32
+        size_t n = bytes < 5552 ? bytes : 5552;
+        bytes -= n;
+        while (n--) {
+            a += *p++;
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    return b << 16 | a;
+}
+/**
+ * Checksum.cpp
+ *
+ * Contient le CRC-32 par tables et l'Adler-32.
+ */
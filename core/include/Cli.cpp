@@ -0,0 +1,1272 @@
+#include "Cli.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Animation.h"
+#include "Attractor.h"
+#include "Batch.h"
+#include "Bifurcation.h"
+#include "Control.h"
+#include "ControlServer.h"
+#include "CustomSystem.h"
+#include "LiveFeed.h"
+#include "Lyapunov.h"
+#include "Plugins.h"
+#include "Poincare.h"
+#include "Session.h"
+#include "Sweep.h"
+#include "TrajectoryRecorder.h"
+
+namespace {
+    // Options "--clé valeur" qui suivent la commande
+    class Args {
+    public:
+        Args(int argc, char* argv[], int first) {
+            for (int i = first; i < argc; i++) {
+                if (std::strncmp(argv[i], "--", 2) != 0 || i + 1 >= argc) {
+                    std::fprintf(stderr, "Option invalide : %s\n", argv[i]);
+                    valid = false;
+                    continue;
+                }
+                values[argv[i] + 2] = argv[i + 1];
+                i++;
+            }
+        }
+
+        // Options d'une tâche de fichier --batch
+        explicit Args(const std::vector<std::pair<std::string, std::string>>& options)
+            : values(options.begin(), options.end()) {}
+
+        bool valid = true;
+
+        bool has(const char* key) const { return values.count(key) != 0; }
+        std::string str(const char* key, const std::string& def = "") const {
+            auto it = values.find(key);
+            return it == values.end() ? def : it->second;
+        }
+        long integer(const char* key, long def) const { return has(key) ? std::atol(str(key).c_str()) : def; }
+        float real(const char* key, float def) const { return has(key) ? float(std::atof(str(key).c_str())) : def; }
+
+    private:
+        std::map<std::string, std::string> values;
+    };
+
+    // Type par numéro ou par nom ("rossler", "Rössler", "3")
+    int parseType(const std::string& text) {
+        if (text.empty()) return 1;
+        if (std::isdigit((unsigned char)text[0])) return std::atoi(text.c_str());
+        return Attractor::find(text);
+    }
+
+    // Paramètre par nom ou par indice ; -1 si inconnu
+    int parseParam(int type, const std::string& text) {
+        const SystemInfo& sys = Attractor::info(type);
+        for (int i = 0; i < sys.paramCount; i++) {
+            if (text == sys.paramNames[i]) return i;
+        }
+        if (!text.empty() && std::isdigit((unsigned char)text[0])) {
+            int i = std::atoi(text.c_str());
+            if (i < sys.paramCount) return i;
+        }
+        return -1;
+    }
+
+    bool parseRange(const std::string& text, float& lo, float& hi) {
+        return std::sscanf(text.c_str(), "%f:%f", &lo, &hi) == 2;
+    }
+
+    // "--set a=0.2,c=5.7" : valeurs des paramètres non balayés
+    bool parseAssignments(int type, const std::string& text, float* params) {
+        size_t pos = 0;
+        while (pos < text.size()) {
+            size_t end = text.find(',', pos);
+            if (end == std::string::npos) end = text.size();
+            std::string item = text.substr(pos, end - pos);
+            size_t eq = item.find('=');
+            int index = eq == std::string::npos ? -1 : parseParam(type, item.substr(0, eq));
+            if (index < 0) {
+                std::fprintf(stderr, "Paramètre inconnu : %s\n", item.c_str());
+                return false;
+            }
+            params[index] = float(std::atof(item.c_str() + eq + 1));
+            pos = end + 1;
+        }
+        return true;
+    }
+
+    // --integrator euler|rk4|exact|taylor (défaut def) et --order N (Taylor) ;
+    // faux (message affiché) si invalide
+    bool integratorOption(const Args& args, const char* def, Integrator& out, int& order) {
+        if (!findIntegrator(args.str("integrator", def), out)) {
+            std::fprintf(stderr, "--integrator : euler, rk4, exact ou taylor\n");
+            return false;
+        }
+        order = int(args.integer("order", order));
+        if (order < 2 || order > kMaxTaylorOrder) {
+            std::fprintf(stderr, "--order : entier de 2 à %d\n", kMaxTaylorOrder);
+            return false;
+        }
+        return true;
+    }
+
+    // x, y ou z ; -1 si invalide
+    int parseAxis(const std::string& text) {
+        if (text == "x") return 0;
+        if (text == "y") return 1;
+        if (text == "z") return 2;
+        return -1;
+    }
+
+    // Système personnalisé : --system fichier.toml, ou --equations "dx;dy;dz"
+    // avec --params a=1,b=2 --map 1 --name nom ; --jit 1 : noyaux natifs.
+    // Installé, puis kCustomType
+    int customOption(const Args& args) {
+        CustomDefinition def;
+        std::string error;
+        if (args.has("system")) {
+            if (!readCustomSystem(args.str("system"), def, error)) {
+                std::fprintf(stderr, "%s : %s\n", args.str("system").c_str(), error.c_str());
+                return 0;
+            }
+        } else {
+            std::string text = args.str("equations");
+            for (int i = 0; i < 3; i++) {
+                size_t end = std::min(text.find(';'), text.size());
+                def.equations[i] = text.substr(0, end);
+                text = end < text.size() ? text.substr(end + 1) : "";
+            }
+            if (!parseCustomParams(args.str("params"), def.params, error)) {
+                std::fprintf(stderr, "--params : %s\n", error.c_str());
+                return 0;
+            }
+            def.isMap = args.integer("map", 0) != 0;
+            def.name = args.str("name", def.name);
+        }
+        if (args.has("jit")) def.native = args.integer("jit", 0) != 0;
+        if (!defineCustomSystem(def, error)) {
+            std::fprintf(stderr, "Système personnalisé : %s\n", error.c_str());
+            return 0;
+        }
+        if (def.native) std::fprintf(stderr, "%s : %s\n", def.name.c_str(), customBackend().c_str());
+        return Attractor::kCustomType;
+    }
+
+    int typeOption(const Args& args, const char* def) {
+        if (args.has("system") || args.has("equations")) return customOption(args);
+        int type = parseType(args.str("type", def));
+        if (!Attractor::available(type)) {
+            std::fprintf(stderr, "Système inconnu : %s\n", args.str("type").c_str());
+            return 0;
+        }
+        return type;
+    }
+
+    // --clé single|double ; faux (message affiché) si invalide
+    bool precisionOption(const Args& args, const char* key, Precision def, Precision& out) {
+        std::string name = args.str(key, def == Precision::Double ? "double" : "single");
+        if (name != "single" && name != "double") {
+            std::fprintf(stderr, "--%s : single ou double\n", key);
+            return false;
+        }
+        out = name == "double" ? Precision::Double : Precision::Single;
+        return true;
+    }
+
+    const char* precisionName(Precision precision) {
+        return precision == Precision::Double ? "double" : "single";
+    }
+
+    int commandSweep(const Args& args) {
+        int type = typeOption(args, "2");
+        if (!type) return 2;
+        const SystemInfo& sys = Attractor::info(type);
+        SweepSettings s(type);
+        s.paramX = parseParam(type, args.str("px", "0"));
+        s.paramY = parseParam(type, args.str("py", "1"));
+        if (s.paramX < 0 || s.paramY < 0 || s.paramX == s.paramY) {
+            std::fprintf(stderr, "--px/--py : deux paramètres distincts de %s attendus\n", sys.name);
+            return 2;
+        }
+        float def = sys.paramDefaults[s.paramX];
+        s.xMin = def * 0.5f; s.xMax = def * 1.5f;
+        def = sys.paramDefaults[s.paramY];
+        s.yMin = def * 0.5f; s.yMax = def * 1.5f;
+        if (args.has("x") && !parseRange(args.str("x"), s.xMin, s.xMax)) return 2;
+        if (args.has("y") && !parseRange(args.str("y"), s.yMin, s.yMax)) return 2;
+        if (args.has("set") && !parseAssignments(type, args.str("set"), s.params)) return 2;
+        if (args.has("size") && std::sscanf(args.str("size").c_str(), "%dx%d", &s.width, &s.height) != 2) return 2;
+
+        std::string mode = args.str("mode", "lyapunov");
+        if (mode == "period") s.mode = SweepMode::Period;
+        else if (mode != "lyapunov") {
+            std::fprintf(stderr, "--mode : lyapunov ou period\n");
+            return 2;
+        }
+        s.dt = args.real("dt", s.dt);
+        s.transient = args.integer("transient", s.transient);
+        s.steps = args.integer("steps", s.steps);
+        s.threads = int(args.integer("threads", 0));
+        s.maxPeriod = int(args.integer("max-period", s.maxPeriod));
+        s.periodTolerance = args.real("tol", s.periodTolerance);
+        if (!precisionOption(args, "precision", Precision::Single, s.precision)) return 2;
+
+        std::printf("Balayage %s : %s [%g, %g] x %s [%g, %g], %dx%d, %s, %s\n", sys.name,
+                    sys.paramNames[s.paramX], s.xMin, s.xMax, sys.paramNames[s.paramY], s.yMin, s.yMax,
+                    s.width, s.height, mode.c_str(), precisionName(s.precision));
+        SweepResult r = runSweep(s);
+        double cells = double(r.width) * r.height;
+        std::printf("%.0f cellules en %.2f s (%.0f cellules/s)\n", cells, r.seconds, cells / r.seconds);
+
+        std::string out = args.str("out", "sweep.ppm");
+        if (!writeSweepImage(r, out)) { std::fprintf(stderr, "Écriture impossible : %s\n", out.c_str()); return 1; }
+        std::printf("Image : %s\n", out.c_str());
+        if (args.has("raw")) {
+            if (!writeSweepRaw(r, args.str("raw"))) { std::fprintf(stderr, "Écriture impossible : %s\n", args.str("raw").c_str()); return 1; }
+            std::printf("Tableau float32 %dx%d : %s\n", r.height, r.width, args.str("raw").c_str());
+        }
+        if (args.has("npy")) {
+            if (!writeSweepNpy(r, args.str("npy"))) { std::fprintf(stderr, "Écriture impossible : %s\n", args.str("npy").c_str()); return 1; }
+            std::printf("Tableau .npy %dx%d : %s\n", r.height, r.width, args.str("npy").c_str());
+        }
+        return 0;
+    }
+
+    // --npy : comptes bruts de l'accumulation, en plus de l'image
+    int writeDensityOption(const Args& args, const DensityImage& image) {
+        if (!args.has("npy")) return 0;
+        std::string path = args.str("npy");
+        if (!writeDensityNpy(image, path)) {
+            std::fprintf(stderr, "Écriture impossible : %s\n", path.c_str());
+            return 1;
+        }
+        std::printf("Comptes uint32 %dx%d : %s\n", image.height, image.width, path.c_str());
+        return 0;
+    }
+
+    int commandBifurcation(const Args& args) {
+        int type = typeOption(args, "2");
+        if (!type) return 2;
+        const SystemInfo& sys = Attractor::info(type);
+        BifurcationSettings s(type);
+        if (args.has("param")) s.param = parseParam(type, args.str("param"));
+        if (s.param < 0 || sys.paramCount == 0) {
+            std::fprintf(stderr, "--param : paramètre de %s attendu\n", sys.name);
+            return 2;
+        }
+        s.pMin = sys.paramDefaults[s.param] * 0.5f;
+        s.pMax = sys.paramDefaults[s.param] * 1.5f;
+        if (args.has("range") && !parseRange(args.str("range"), s.pMin, s.pMax)) return 2;
+        if (args.has("values") && !parseRange(args.str("values"), s.vMin, s.vMax)) return 2;
+        if (args.has("set") && !parseAssignments(type, args.str("set"), s.params)) return 2;
+        if (args.has("size") && std::sscanf(args.str("size").c_str(), "%dx%d", &s.columns, &s.rows) != 2) return 2;
+        s.axis = parseAxis(args.str("axis", "x"));
+        if (s.axis < 0) return 2;
+
+        std::string record = args.str("record", "maxima");
+        if (record == "section") {
+            s.record = BifurcationRecord::Section;
+            // --section y=0 : passage montant de y par 0
+            std::string section = args.str("section", "y=0");
+            size_t eq = section.find('=');
+            s.sectionAxis = parseAxis(section.substr(0, eq));
+            if (eq == std::string::npos || s.sectionAxis < 0) {
+                std::fprintf(stderr, "--section : axe=niveau attendu (ex. y=0)\n");
+                return 2;
+            }
+            s.sectionLevel = float(std::atof(section.c_str() + eq + 1));
+        } else if (record != "maxima") {
+            std::fprintf(stderr, "--record : maxima ou section\n");
+            return 2;
+        }
+        s.dt = args.real("dt", s.dt);
+        s.transient = args.integer("transient", s.transient);
+        s.steps = args.integer("steps", s.steps);
+        s.threads = int(args.integer("threads", 0));
+
+        std::printf("Bifurcation %s : %s [%g, %g], %dx%d\n", sys.name, sys.paramNames[s.param],
+                    s.pMin, s.pMax, s.columns, s.rows);
+        BifurcationDiagram diagram;
+        diagram.start(s);
+        diagram.wait();
+        std::printf("%d colonnes en %.2f s, valeurs [%g, %g]\n", diagram.columnsDone(), diagram.seconds(),
+                    diagram.valueMin(), diagram.valueMax());
+
+        std::string out = args.str("out", "bifurcation.ppm");
+        if (!writeDensityImage(diagram.image(), DensityScale::PerColumn, out)) {
+            std::fprintf(stderr, "Écriture impossible : %s\n", out.c_str());
+            return 1;
+        }
+        std::printf("Image : %s\n", out.c_str());
+        return writeDensityOption(args, diagram.image());
+    }
+
+    int commandPoincare(const Args& args) {
+        int type = typeOption(args, "1");
+        if (!type) return 2;
+        const SystemInfo& sys = Attractor::info(type);
+        if (!poincareSupported(type)) {
+            std::fprintf(stderr, "Section de Poincaré indisponible pour %s\n", sys.name);
+            return 2;
+        }
+        PoincareSettings s(type);
+        if (args.has("normal") && std::sscanf(args.str("normal").c_str(), "%f,%f,%f",
+                                              &s.normal[0], &s.normal[1], &s.normal[2]) != 3) {
+            std::fprintf(stderr, "--normal : trois composantes attendues (ex. 0,0,1)\n");
+            return 2;
+        }
+        s.offset = args.real("offset", s.offset);
+        std::string direction = args.str("direction", "up");
+        s.bothDirections = direction == "both";
+        if (direction != "up" && direction != "both") {
+            std::fprintf(stderr, "--direction : up ou both\n");
+            return 2;
+        }
+        if (args.has("set") && !parseAssignments(type, args.str("set"), s.params)) return 2;
+        if (args.has("size") && std::sscanf(args.str("size").c_str(), "%dx%d", &s.width, &s.height) != 2) return 2;
+        if (args.has("u") && !parseRange(args.str("u"), s.uMin, s.uMax)) return 2;
+        if (args.has("v") && !parseRange(args.str("v"), s.vMin, s.vMax)) return 2;
+        if (args.has("u") != args.has("v")) {
+            std::fprintf(stderr, "--u et --v vont ensemble\n");
+            return 2;
+        }
+        if (!integratorOption(args, "rk4", s.integrator, s.taylorOrder)) return 2;
+        s.dt = args.real("dt", s.dt);
+        s.transient = args.integer("transient", s.transient);
+        s.maxCrossings = std::max(1L, args.integer("crossings", 1000000));
+        s.threads = int(args.integer("threads", 0));
+
+        std::printf("Section %s : (%g, %g, %g).p = %g, %dx%d\n", sys.name, s.normal[0], s.normal[1],
+                    s.normal[2], s.offset, s.width, s.height);
+        PoincareSection section;
+        if (!section.start(s)) {
+            std::fprintf(stderr, "--normal : vecteur non nul attendu\n");
+            return 2;
+        }
+        section.wait();
+        float r[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        section.range(r);
+        double seconds = section.seconds();
+        std::printf("%ld passages en %.2f s (%.2f M/s), u [%g, %g], v [%g, %g]\n", section.crossings(), seconds,
+                    section.crossings() / seconds * 1e-6, r[0], r[1], r[2], r[3]);
+
+        DensityImage image;
+        section.copyImage(image);
+        std::string out = args.str("out", "section.ppm");
+        if (!writeDensityImage(image, DensityScale::Global, out)) {
+            std::fprintf(stderr, "Écriture impossible : %s\n", out.c_str());
+            return 1;
+        }
+        std::printf("Image : %s\n", out.c_str());
+        return writeDensityOption(args, image);
+    }
+
+    int commandRecord(const Args& args) {
+        int type = typeOption(args, "1");
+        if (!type) return 2;
+        const SystemInfo& sys = Attractor::info(type);
+        Attractor att;
+        att.select(type);
+        if (args.has("set") && !parseAssignments(type, args.str("set"), att.params)) return 2;
+        att.dt = args.real("dt", att.dt);
+        Integrator integrator = Integrator::Euler;
+        if (!integratorOption(args, "euler", integrator, att.taylorOrder)) return 2;
+        if (sys.isMap) integrator = Integrator::Euler;
+        // Calcul et stockage : le second suit le premier sauf --storage
+        Precision precision, storage;
+        if (!precisionOption(args, "precision", Precision::Single, precision)) return 2;
+        if (!precisionOption(args, "storage", precision, storage)) return 2;
+        long steps = args.integer("steps", 10000000);
+        long chunk = std::max(1L, args.integer("chunk", 65536));
+        long bufferCount = std::max(2L, args.integer("buffers", 16));
+        TrajectoryRecorder recorder{size_t(bufferCount), size_t(chunk)};
+        std::string policy = args.str("policy", "block");
+        if (policy == "drop") recorder.policy = RecordPolicy::Drop;
+        else if (policy == "downsample") recorder.policy = RecordPolicy::Downsample;
+        else if (policy != "block") {
+            std::fprintf(stderr, "--policy : block, drop ou downsample\n");
+            return 2;
+        }
+
+        TrajectoryHeader header = makeTrajectoryHeader(att, integrator, storage);
+        std::string codec = args.str("codec", "raw");
+        if (codec == "delta") {
+            header.codec = uint32_t(ChunkCodec::Delta);
+            header.quantum = args.real("quantum", 1e-3f);
+            if (!(header.quantum > 0.0)) {
+                std::fprintf(stderr, "--quantum : pas strictement positif attendu\n");
+                return 2;
+            }
+        } else if (codec != "raw") {
+            std::fprintf(stderr, "--codec : raw ou delta\n");
+            return 2;
+        }
+        recorder.encodeThreads = int(args.integer("threads", 0));
+
+        std::string out = args.str("out", "trajectoire.atr");
+        if (!recorder.open(out, header)) {
+            std::fprintf(stderr, "Écriture impossible : %s\n", out.c_str());
+            return 1;
+        }
+        std::printf("Enregistrement %s : %ld pas en %s (stockage %s) -> %s\n", sys.name, steps,
+                    precisionName(precision), precisionName(storage), out.c_str());
+
+        // --check : x de chaque point = son pas de simulation, comparé au pas
+        // que donne le fichier relu (trous et décimation des politiques compris)
+        const bool check = args.has("check");
+        auto t0 = std::chrono::steady_clock::now();
+        if (check) {
+            for (long i = 0; i < steps; i++) recorder.push(Vec3<double>{double(i), 0.0, 0.0});
+        } else {
+            dispatchPrecision(precision, [&](auto scalar) {
+                using T = decltype(scalar);
+                T k[kMaxParams];
+                std::copy(att.params, att.params + kMaxParams, k);
+                dispatchSystem(type, [&](auto tag) {
+                    constexpr int Type = decltype(tag)::value;
+                    const T dt = sys.isMap ? T(1) : T(att.dt);
+                    Vec3<T> p = vecCast<T>(att.p);
+                    for (long i = 0; i < steps; i++) {
+                        advance<Type>(integrator, k, p, dt, att.taylorOrder);
+                        recorder.push(p);
+                    }
+                });
+            });
+        }
+        double simulated = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        recorder.close();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        RecorderStats st = recorder.stats();
+        if (st.failed) {
+            std::fprintf(stderr, "Écriture interrompue (disque plein ?) après %llu points\n",
+                         (unsigned long long)st.written);
+            return 1;
+        }
+        std::printf("%llu points, %.1f Mo en %.2f s (%.1f Mpoints/s, %.0f Mo/s)\n", (unsigned long long)st.written,
+                    st.bytes / 1e6, seconds, st.written / seconds * 1e-6, st.bytes / seconds * 1e-6);
+        std::printf("Simulation %.2f s dont %.2f s d'attente, %llu points perdus, pas final %u\n", simulated,
+                    st.blockedSeconds, (unsigned long long)st.dropped, st.stride);
+        if (!check) return 0;
+
+        TrajectoryReader reader;
+        if (!reader.open(out)) {
+            std::fprintf(stderr, "%s : %s\n", out.c_str(), reader.error().c_str());
+            return 1;
+        }
+        // Pas exacts en float jusqu'à 2^24
+        uint64_t read = 0, wrong = 0;
+        std::vector<Point> points(65536);
+        for (uint64_t first = 0; first < reader.pointCount(); first += points.size()) {
+            size_t n = reader.read(first, points.size(), points.data());
+            if (n == 0) break;
+            for (size_t i = 0; i < n; i++) wrong += double(points[i].x) != double(reader.stepOf(first + i));
+            read += n;
+        }
+        std::printf("Vérification : %llu points relus sur %llu, %llu au mauvais pas\n", (unsigned long long)read,
+                    (unsigned long long)st.written, (unsigned long long)wrong);
+        return read == st.written && wrong == 0 ? 0 : 1;
+    }
+
+    int commandInspect(const Args& args) {
+        std::string path = args.str("in", "trajectoire.atr");
+        TrajectoryReader reader;
+        if (!reader.open(path)) {
+            std::fprintf(stderr, "%s : %s\n", path.c_str(), reader.error().c_str());
+            return 1;
+        }
+        const TrajectoryHeader& h = reader.header();
+        const SystemInfo& sys = Attractor::info(h.systemType);
+        std::printf("%s : format %u, %s, %s", path.c_str(), h.version, sys.name, integratorName(Integrator(h.integrator)));
+        if (h.taylorOrder > 0) std::printf(" (ordre %u)", h.taylorOrder);
+        std::printf(", dt %g, %d coordonnées %s\n", h.dt, h.dims, h.scalarSize == 8 ? "double" : "float");
+        for (int i = 0; i < sys.paramCount; i++) std::printf("  %s = %g\n", sys.paramNames[i], h.params[i]);
+        std::printf("%llu points en %zu blocs\n", (unsigned long long)reader.pointCount(), reader.chunks().size());
+        size_t compressed = 0;
+        for (const TrajectoryReader::Chunk& c : reader.chunks()) compressed += c.codec == ChunkCodec::Delta;
+        double rawBytes = double(h.scalarSize) * h.dims;
+        std::printf("%.2f octets par point (%.1fx)", reader.bytesPerPoint(),
+                    reader.bytesPerPoint() > 0.0 ? rawBytes / reader.bytesPerPoint() : 1.0);
+        if (compressed > 0) std::printf(", %zu blocs compressés au pas %g", compressed, h.quantum);
+        std::printf("\n");
+        if (!reader.contiguous()) {
+            // Blocs décimés (un point tous les stride pas) ou précédés de blocs abandonnés
+            size_t downsampled = 0, gaps = 0;
+            uint64_t next = 0;
+            for (const TrajectoryReader::Chunk& c : reader.chunks()) {
+                downsampled += c.stride > 1;
+                gaps += c.firstStep > next;
+                next = c.firstStep + c.count * c.stride;
+            }
+            std::printf("%zu blocs sous-échantillonnés (un point sur %u au plus), %zu trous, %llu pas de simulation\n",
+                        downsampled, reader.maxStride(), gaps, (unsigned long long)reader.stepOf(reader.pointCount()));
+        }
+
+        // Boîte englobante, lue bloc par bloc dans la projection
+        Point lo = {INFINITY, INFINITY, INFINITY}, hi = {-INFINITY, -INFINITY, -INFINITY};
+        std::vector<Point> points(65536);
+        for (uint64_t first = 0; first < reader.pointCount(); first += points.size()) {
+            size_t n = reader.read(first, points.size(), points.data());
+            if (n == 0) break;
+            for (size_t i = 0; i < n; i++) {
+                const Point& p = points[i];
+                lo = {std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z)};
+                hi = {std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z)};
+            }
+        }
+        if (reader.pointCount() > 0) {
+            std::printf("x [%g, %g]  y [%g, %g]  z [%g, %g]\n", lo.x, hi.x, lo.y, hi.y, lo.z, hi.z);
+        }
+        return 0;
+    }
+
+    int commandExport(const Args& args) {
+        std::string in = args.str("in", "trajectoire.atr");
+        std::string out = args.str("out", "trajectoire.npy");
+        TrajectoryReader reader;
+        if (!reader.open(in)) {
+            std::fprintf(stderr, "%s : %s\n", in.c_str(), reader.error().c_str());
+            return 1;
+        }
+        auto t0 = std::chrono::steady_clock::now();
+        if (!writeTrajectoryNpy(reader, out)) {
+            std::fprintf(stderr, "Écriture impossible : %s\n", out.c_str());
+            return 1;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        const TrajectoryHeader& h = reader.header();
+        std::printf("%s : tableau (%llu, %d) %s en %.2f s\n", out.c_str(), (unsigned long long)reader.pointCount(),
+                    h.dims, h.scalarSize == 8 ? "float64" : "float32", seconds);
+        // Points non équidistants : leur pas de simulation à côté
+        if (!reader.contiguous()) {
+            const std::string steps = trajectoryStepsPath(out);
+            if (!writeTrajectoryStepsNpy(reader, steps)) {
+                std::fprintf(stderr, "Écriture impossible : %s\n", steps.c_str());
+                return 1;
+            }
+            std::printf("%s : pas de simulation de chaque point (uint64, pas non contigus)\n", steps.c_str());
+        }
+        return 0;
+    }
+
+    // "--keys 0:a=-1.4,b=1.6;300:a=-1.7,yaw=0.5" : images clés ; yaw, pitch et
+    // zoom règlent la vue, une valeur absente reprend celle de l'image clé
+    // précédente (ou de base pour la première)
+    bool parseKeyframes(int type, const std::string& text, const Keyframe& base, std::vector<Keyframe>& keys) {
+        Keyframe previous = base;
+        size_t pos = 0;
+        while (pos < text.size()) {
+            size_t end = text.find(';', pos);
+            if (end == std::string::npos) end = text.size();
+            std::string item = text.substr(pos, end - pos);
+            pos = end + 1;
+            size_t colon = item.find(':');
+            if (colon == std::string::npos || colon == 0 || !std::isdigit((unsigned char)item[0])) {
+                std::fprintf(stderr, "Image clé invalide : %s (image:nom=valeur,...)\n", item.c_str());
+                return false;
+            }
+            Keyframe k = previous;
+            k.frame = std::atoi(item.c_str());
+            std::string assignments;
+            for (size_t at = colon + 1; at < item.size();) {
+                size_t comma = item.find(',', at);
+                if (comma == std::string::npos) comma = item.size();
+                std::string one = item.substr(at, comma - at);
+                at = comma + 1;
+                size_t eq = one.find('=');
+                std::string name = one.substr(0, eq);
+                float value = eq == std::string::npos ? 0.0f : float(std::atof(one.c_str() + eq + 1));
+                if (name == "yaw") k.view.yaw = value;
+                else if (name == "pitch") k.view.pitch = value;
+                else if (name == "zoom") k.view.zoom = value;
+                else assignments += (assignments.empty() ? "" : ",") + one;
+            }
+            if (!parseAssignments(type, assignments, k.params)) return false;
+            keys.push_back(k);
+            previous = k;
+        }
+        return !keys.empty();
+    }
+
+    int commandAnimate(const Args& args) {
+        int type = typeOption(args, "1");
+        if (!type) return 2;
+        const SystemInfo& sys = Attractor::info(type);
+        AnimationSettings s(type);
+        if (args.has("set") && !parseAssignments(type, args.str("set"), s.params)) return 2;
+        s.dt = args.real("dt", s.dt);
+        if (!integratorOption(args, "euler", s.integrator, s.taylorOrder)) return 2;
+        if (sys.isMap) s.integrator = Integrator::Euler;
+        if (!precisionOption(args, "precision", Precision::Single, s.precision)) return 2;
+        s.transient = args.integer("transient", s.transient);
+        s.steps = args.integer("steps", s.steps);
+        s.frames = int(args.integer("frames", s.frames));
+        if (args.has("size") && std::sscanf(args.str("size").c_str(), "%dx%d", &s.width, &s.height) != 2) return 2;
+        s.threads = int(args.integer("threads", 0));
+        s.view.yaw = args.real("yaw", 0.0f);
+        s.view.pitch = args.real("pitch", 0.0f);
+        s.view.zoom = args.real("zoom", s.view.zoom);
+        if (args.has("color") && std::sscanf(args.str("color").c_str(), "%f,%f,%f", &s.view.color[0],
+                                             &s.view.color[1], &s.view.color[2]) != 3) {
+            std::fprintf(stderr, "--color : trois composantes entre 0 et 1 (ex. 0,1,1)\n");
+            return 2;
+        }
+        std::string mode = args.str("mode", "orbit");
+        if (mode == "morph") {
+            s.mode = AnimationMode::Morph;
+            s.param = parseParam(type, args.str("param", "0"));
+            if (s.param < 0) {
+                std::fprintf(stderr, "Paramètre inconnu : %s\n", args.str("param").c_str());
+                return 2;
+            }
+            if (!parseRange(args.str("range"), s.from, s.to)) {
+                std::fprintf(stderr, "--range a:b attendu en mode morph\n");
+                return 2;
+            }
+        } else if (mode == "orbit") {
+            s.turns = args.real("turns", 1.0f);
+        } else if (mode == "keys") {
+            s.mode = AnimationMode::Keyframes;
+            s.smooth = args.str("interpolation", "smooth") != "linear";
+            Keyframe base;
+            std::copy(s.params, s.params + kMaxParams, base.params);
+            base.view = s.view;
+            if (!parseKeyframes(type, args.str("keys"), base, s.keyframes)) {
+                std::fprintf(stderr, "--keys \"0:a=1,yaw=0;119:a=2\" attendu en mode keys\n");
+                return 2;
+            }
+        } else {
+            std::fprintf(stderr, "--mode : orbit, morph ou keys\n");
+            return 2;
+        }
+        std::string style = args.str("style", "points");
+        if (style == "density") s.style = FrameStyle::Density;
+        else if (style != "points") {
+            std::fprintf(stderr, "--style : points ou density\n");
+            return 2;
+        }
+
+        AnimationOutput out;
+        out.fps = int(args.integer("fps", 30));
+        out.path = args.str("out", "image_%05d.png");
+        if (args.has("pipe")) {
+            out.format = FrameFormat::Y4m;
+            out.command = args.str("pipe");
+        } else if (out.path.size() >= 4 && out.path.compare(out.path.size() - 4, 4, ".y4m") == 0) {
+            out.format = FrameFormat::Y4m;
+        }
+
+        std::printf("Animation %s (%s) : %d images %dx%d, %ld points par image -> %s\n", sys.name, mode.c_str(),
+                    s.frames, s.width, s.height, s.steps, out.command.empty() ? out.path.c_str() : out.command.c_str());
+        AnimationResult r = runAnimation(s, out);
+        if (!r.error.empty()) {
+            std::fprintf(stderr, "Animation interrompue après %d images : %s\n", r.frames, r.error.c_str());
+            return 1;
+        }
+        std::printf("%d images en %.2f s (%.1f images/s)\n", r.frames, r.seconds, r.frames / r.seconds);
+        return 0;
+    }
+
+    // Affiche le flux d'une application lancée avec --live pendant --seconds.
+    // --publish N : publie N pas d'une simulation et les relit depuis un
+    // second thread par le même chemin qu'un autre processus ; chaque état
+    // reçu est comparé à la simulation refaite par le lecteur.
+    int commandLive(const Args& args) {
+        const std::string name = args.str("name", "/attracteurs");
+        if (args.has("publish")) {
+            int type = typeOption(args, "1");
+            if (!type) return 2;
+            const SystemInfo& sys = Attractor::info(type);
+            Attractor att;
+            att.select(type);
+            if (args.has("set") && !parseAssignments(type, args.str("set"), att.params)) return 2;
+            const long steps = args.integer("publish", 1000000);
+            LiveFeedWriter writer;
+            if (!writer.open(name, uint32_t(args.integer("capacity", 1 << 16)))) {
+                std::fprintf(stderr, "Mémoire partagée %s impossible à créer\n", name.c_str());
+                return 1;
+            }
+            LiveSnapshot description;
+            description.type = type;
+            description.dt = att.dt;
+            std::copy(att.params, att.params + kMaxParams, description.params);
+            description.zoom = sys.zoom;
+
+            std::atomic<bool> done{false};
+            uint64_t received = 0, lost = 0, mismatches = 0;
+            LiveSnapshot last;
+            bool reader = true;
+            std::thread consumer([&] {
+                LiveFeedReader feed;
+                if (!feed.open(name)) { reader = false; return; }
+                Attractor check;
+                check.select(type);
+                std::copy(att.params, att.params + kMaxParams, check.params);
+                uint64_t next = 0, simulated = 0;
+                std::vector<Point> buffer(4096);
+                dispatchSystem(type, [&](auto tag) {
+                    constexpr int Type = decltype(tag)::value;
+                    const float dt = sys.isMap ? 1.0f : check.dt;
+                    for (;;) {
+                        const bool finished = done.load();
+                        uint64_t from = next;
+                        size_t n = feed.read(from, buffer.data(), buffer.size(), lost);
+                        const uint64_t first = from - n;
+                        for (size_t i = 0; i < n; i++) {
+                            while (simulated <= first + i) {
+                                advance<Type>(Integrator::Euler, check.params, check.p, dt);
+                                simulated++;
+                            }
+                            if (std::memcmp(&buffer[i], &check.p, sizeof(Point)) != 0) mismatches++;
+                        }
+                        received += n;
+                        next = from;
+                        if (n == 0 && finished && next == feed.head()) break;
+                        if (n == 0) std::this_thread::yield();
+                    }
+                });
+                feed.snapshot(last);
+            });
+
+            auto t0 = std::chrono::steady_clock::now();
+            dispatchSystem(type, [&](auto tag) {
+                constexpr int Type = decltype(tag)::value;
+                const float dt = sys.isMap ? 1.0f : att.dt;
+                // Par 5 pas, comme la boucle de l'application
+                Point batch[5];
+                for (long i = 0; i < steps; i += 5) {
+                    const int n = int(std::min(5L, steps - i));
+                    for (int j = 0; j < n; j++) {
+                        advance<Type>(Integrator::Euler, att.params, att.p, dt);
+                        batch[j] = att.p;
+                    }
+                    writer.publish(batch, size_t(n), description);
+                }
+            });
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            done = true;
+            consumer.join();
+            if (!reader) {
+                std::fprintf(stderr, "%s : relecture impossible\n", name.c_str());
+                return 1;
+            }
+            std::printf("%llu états publiés en %.2f s (%.0f ns par état), %llu lus, %llu perdus\n",
+                        (unsigned long long)writer.published(), seconds, seconds * 1e9 / std::max(1L, steps),
+                        (unsigned long long)received, (unsigned long long)lost);
+            if (received + lost != writer.published() || mismatches || last.head != writer.published()
+                || last.type != type) {
+                std::fprintf(stderr, "Flux incohérent : %llu états différents de la simulation\n",
+                             (unsigned long long)mismatches);
+                return 1;
+            }
+            return 0;
+        }
+
+        LiveFeedReader feed;
+        if (!feed.open(name)) {
+            std::fprintf(stderr, "%s\n", feed.error().c_str());
+            return 1;
+        }
+        LiveSnapshot s;
+        if (!feed.snapshot(s)) {
+            std::fprintf(stderr, "%s : résumé illisible (écriture en continu)\n", name.c_str());
+            return 1;
+        }
+        const SystemInfo& sys = Attractor::info(s.type);
+        std::printf("%s : %s, dt %g, anneau de %u états, %llu publiés\n", name.c_str(), sys.name, s.dt,
+                    feed.capacity(), (unsigned long long)s.head);
+        for (int i = 0; i < sys.paramCount; i++) std::printf("  %s = %g\n", sys.paramNames[i], s.params[i]);
+        std::printf("Point courant (%g, %g, %g) ; sur %llu états : moyenne (%g, %g, %g),\n"
+                    "  min (%g, %g, %g), max (%g, %g, %g)\n",
+                    s.current.x, s.current.y, s.current.z, (unsigned long long)s.samples, s.mean.x, s.mean.y,
+                    s.mean.z, s.min.x, s.min.y, s.min.z, s.max.x, s.max.y, s.max.z);
+
+        // Suivi : états reçus chaque seconde depuis la position actuelle
+        const double duration = args.real("seconds", 0.0f);
+        uint64_t next = feed.head(), lost = 0, received = 0;
+        std::vector<Point> buffer(size_t(feed.capacity()));
+        auto start = std::chrono::steady_clock::now();
+        double report = 1.0;
+        for (;;) {
+            double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (t >= duration) break;
+            size_t n = feed.read(next, buffer.data(), buffer.size(), lost);
+            received += n;
+            if (t >= report) {
+                std::printf("%.0f s : %llu états reçus, %llu perdus\n", t, (unsigned long long)received,
+                            (unsigned long long)lost);
+                report += 1.0;
+            }
+            if (n == 0) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return 0;
+    }
+
+    // Envoie des requêtes à une application lancée avec --control : --send
+    // pour une ligne JSON, --file pour un fichier (une requête par ligne, "-" :
+    // entrée standard). --check : dialogue complet avec un serveur lancé ici,
+    // sur une simulation sans fenêtre.
+    int commandControl(const Args& args) {
+        const std::string socketPath = args.str("socket", "attracteurs.sock");
+        std::vector<std::string> lines;
+        if (args.has("send")) lines.push_back(args.str("send"));
+        if (args.has("file")) {
+            std::ifstream file;
+            std::istream* in = &std::cin;
+            if (args.str("file") != "-") {
+                file.open(args.str("file"));
+                if (!file) {
+                    std::fprintf(stderr, "Lecture impossible : %s\n", args.str("file").c_str());
+                    return 1;
+                }
+                in = &file;
+            }
+            for (std::string line; std::getline(*in, line);) lines.push_back(line);
+        }
+
+        if (args.has("check")) {
+            // Requêtes et réponse attendue (ok, puis un extrait du texte)
+            const struct { const char* request; bool ok; const char* expect; } script[] = {
+                {R"({"id": 1, "cmd": "status"})", true, "\"system\":\"Lorenz\""},
+                {R"({"id": 2, "cmd": "set", "type": "rossler", "params": {"c": 9}, "integrator": "rk4"})", true, "\"c\":9"},
+                {R"({"id": 3, "cmd": "set", "dt": 0.02, "params": {"rho": 1}})", false, "paramètre inconnu"},
+                {R"({"id": 4, "cmd": "set", "camera": {"yaw": 0.5}, "color": [1, 0.5, 0]})", true, "\"yaw\":0.5"},
+                {"pas du JSON", false, "JSON invalide"},
+                {R"([1, 2])", false, "objet JSON attendu"},
+                {R"({"id": 7, "cmd": "inconnue"})", false, "commande inconnue"},
+                {R"({"id": 8, "cmd": "status"})", true, "\"dt\":0.00999999978,\"integrator\":\"rk4\""},
+            };
+            for (const auto& step : script) lines.push_back(step.request);
+
+            Attractor att;
+            FrameView view;
+            AnimationExport animation;
+            ControlTarget target{att, view, animation};
+            ControlServer server;
+            if (!server.start(socketPath)) {
+                std::fprintf(stderr, "%s\n", server.error().c_str());
+                return 1;
+            }
+            std::vector<std::string> replies;
+            std::string error;
+            std::atomic<bool> done{false};
+            bool sent = false;
+            std::thread client([&] {
+                sent = controlRequest(socketPath, lines, replies, error);
+                done = true;
+            });
+            // Boucle principale de l'application, en plus court
+            long frames = 0;
+            while (!done) {
+                server.poll([&](const Json& request, Json& reply) {
+                    if (!handleControl(request, reply, target)) reply.set("error", "commande inconnue");
+                });
+                for (int i = 0; i < 5; i++) att.update();
+                frames++;
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            client.join();
+            server.stop();
+            if (!sent) {
+                std::fprintf(stderr, "%s\n", error.c_str());
+                return 1;
+            }
+            int failures = 0;
+            for (size_t i = 0; i < replies.size(); i++) {
+                Json reply;
+                const Json* ok = nullptr;
+                bool good = parseJson(replies[i], reply, error) && (ok = reply.find("ok"))
+                            && ok->boolean == script[i].ok && replies[i].find(script[i].expect) != std::string::npos;
+                if (!good) {
+                    std::fprintf(stderr, "Réponse %zu inattendue : %s\n", i + 1, replies[i].c_str());
+                    failures++;
+                }
+            }
+            std::printf("%zu réponses dans l'ordre en %ld images, %d inattendues\n", replies.size(), frames, failures);
+            return failures ? 1 : 0;
+        }
+
+        if (lines.empty()) {
+            std::fprintf(stderr, "--send '{\"cmd\": \"status\"}' ou --file requetes.jsonl attendu\n");
+            return 2;
+        }
+        std::vector<std::string> replies;
+        std::string error;
+        bool ok = controlRequest(socketPath, lines, replies, error, int(args.integer("timeout", 10000)));
+        for (const std::string& r : replies) std::printf("%s\n", r.c_str());
+        if (!ok) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        // Code 1 si une requête a échoué
+        for (const std::string& r : replies) {
+            if (r.find("\"ok\":false") != std::string::npos) return 1;
+        }
+        return 0;
+    }
+
+    // Exposants de Lyapunov d'un système (méthode de Benettin, voir Lyapunov.h)
+    int commandLyapunov(const Args& args) {
+        int type = typeOption(args, "1");
+        if (!type) return 2;
+        const SystemInfo& sys = Attractor::info(type);
+        Attractor att;
+        att.select(type);
+        if (args.has("set") && !parseAssignments(type, args.str("set"), att.params)) return 2;
+        att.dt = args.real("dt", att.dt);
+        if (!integratorOption(args, "euler", att.integrator, att.taylorOrder)) return 2;
+        if (!precisionOption(args, "precision", Precision::Single, att.precision)) return 2;
+        LyapunovSettings s;
+        s.transient = args.integer("transient", s.transient);
+        s.maxSteps = args.integer("steps", 2000000);
+        s.batch = std::max(1L, s.maxSteps / 100);
+
+        auto t0 = std::chrono::steady_clock::now();
+        LyapunovResult r = estimateLyapunov(att, s);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        if (r.diverged) {
+            std::fprintf(stderr, "%s : la trajectoire diverge, réduire --dt\n", sys.name);
+            return 1;
+        }
+        std::printf("%s, %ld pas %s en %s en %.2f s\n", sys.name, r.steps,
+                    integratorName(sys.isMap ? Integrator::Euler : att.integrator), precisionName(att.precision), seconds);
+        Json exponents = Json::array();
+        for (int i = 0; i < r.count; i++) {
+            std::printf("lambda%d = %+.5f\n", i + 1, r.exponents[i]);
+            exponents.push(r.exponents[i]);
+        }
+        double dimension = r.count > 1 ? kaplanYorkeDimension(r) : 0.0;
+        if (r.count > 1) std::printf("Dimension de Kaplan-Yorke = %.4f\n", dimension);
+
+        // --out : résultat en JSON, pour les fichiers de tâches
+        if (args.has("out")) {
+            Json out = Json::object();
+            out.set("system", sys.name);
+            out.set("steps", double(r.steps));
+            out.set("dt", sys.isMap ? 1.0 : double(att.dt));
+            out.set("precision", precisionName(att.precision));
+            out.set("exponents", exponents);
+            if (r.count > 1) out.set("kaplanYorke", dimension);
+            std::ofstream file(args.str("out"));
+            if (!(file << toJson(out) << "\n")) {
+                std::fprintf(stderr, "Écriture impossible : %s\n", args.str("out").c_str());
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+    // --out : écrit une session (trajectoire et section de Poincaré à moitié
+    // calculée) comme le ferait l'application ; puis relit --in ou --out
+    int commandSession(const Args& args) {
+        std::string path = args.str("in", args.str("out", "session.atrs"));
+        if (args.has("out")) {
+            int type = typeOption(args, "1");
+            if (!type) return 2;
+            const SystemInfo& sys = Attractor::info(type);
+            Attractor att;
+            att.select(type);
+            if (args.has("set") && !parseAssignments(type, args.str("set"), att.params)) return 2;
+            att.dt = args.real("dt", att.dt);
+            if (!integratorOption(args, "euler", att.integrator, att.taylorOrder)) return 2;
+            if (!precisionOption(args, "precision", Precision::Single, att.precision)) return 2;
+            long steps = args.integer("steps", 1000000);
+
+            // Pas de l'application (Attractor::update), intégrateur et précision compris
+            SessionState state;
+            state.hasView = true;
+            state.resetPoints = true;
+            state.points.reserve(size_t(std::max(0L, steps)));
+            for (long i = 0; i < steps; i++) {
+                att.update();
+                state.points.push_back(att.p);
+            }
+            SessionView& v = state.view;
+            v.type = att.type;
+            state.system = sys.name;
+            state.hasCustom = hasCustomSystem();
+            if (state.hasCustom) state.custom = customDefinition();
+            v.integrator = int32_t(att.integrator);
+            v.taylorOrder = att.taylorOrder;
+            v.precision = int32_t(att.precision);
+            const Vec3<double> p = att.state();
+            v.p[0] = p.x; v.p[1] = p.y; v.p[2] = p.z;
+            v.dt = att.dt;
+            std::copy(att.params, att.params + kMaxParams, v.params);
+            v.zoom = sys.zoom;
+
+            long crossings = args.integer("crossings", 0);
+            if (crossings > 0 && poincareSupported(type)) {
+                PoincareSettings ps(type);
+                std::copy(att.params, att.params + kMaxParams, ps.params);
+                ps.maxCrossings = crossings;
+                PoincareSection section;
+                section.start(ps);
+                section.wait();
+                section.snapshot(state.poincare);
+                state.hasPoincare = true;
+            }
+
+            auto t0 = std::chrono::steady_clock::now();
+            SessionWriter writer;
+            writer.open(path);
+            writer.save(std::move(state));
+            writer.close();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            SessionStats st = writer.stats();
+            if (st.failed) {
+                std::fprintf(stderr, "Écriture impossible : %s\n", path.c_str());
+                return 1;
+            }
+            std::printf("Session écrite : %s, %.1f Mo en %.2f s\n", path.c_str(), st.fileBytes / 1e6, seconds);
+        }
+
+        auto t0 = std::chrono::steady_clock::now();
+        SessionState state;
+        if (!loadSession(path, state)) {
+            std::fprintf(stderr, "%s : pas une session lisible\n", path.c_str());
+            return 1;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        std::printf("Session relue en %.3f s\n", seconds);
+        if (state.hasView) {
+            const SessionView& v = state.view;
+            std::printf("%s, point (%.17g, %.17g, %.17g), dt %g, %s en %s\n",
+                        state.system.empty() ? Attractor::info(v.type).name : state.system.c_str(), v.p[0],
+                        v.p[1], v.p[2], v.dt, integratorName(Integrator(v.integrator)),
+                        precisionName(Precision(v.precision)));
+        }
+        if (state.hasCustom) {
+            const CustomDefinition& def = state.custom;
+            std::printf("Système personnalisé %s%s : %s ; %s ; %s\n", def.name.c_str(),
+                        def.isMap ? " (application)" : "", def.equations[0].c_str(), def.equations[1].c_str(),
+                        def.equations[2].c_str());
+        }
+        std::printf("%zu points\n", state.points.size());
+        if (state.hasPoincare) {
+            const PoincareCheckpoint& c = state.poincare;
+            std::printf("Section de Poincaré %dx%d : %ld passages, %zu trajectoires%s\n", c.image.width,
+                        c.image.height, c.crossings, c.trajectories.size(), c.running ? " (en cours)" : "");
+        }
+        if (state.hasBifurcation) {
+            const BifurcationCheckpoint& c = state.bifurcation;
+            long done = long(std::count(c.columns.begin(), c.columns.end(), uint8_t(1)));
+            std::printf("Diagramme de bifurcation : %ld / %zu colonnes\n", done, c.columns.size());
+        }
+        return 0;
+    }
+
+    using Command = int (*)(const Args&);
+    int commandBatch(const Args& args);
+
+    Command findCommand(const std::string& name) {
+        if (name == "sweep") return commandSweep;
+        if (name == "bifurcation") return commandBifurcation;
+        if (name == "poincare") return commandPoincare;
+        if (name == "lyapunov") return commandLyapunov;
+        if (name == "record") return commandRecord;
+        if (name == "inspect") return commandInspect;
+        if (name == "export") return commandExport;
+        if (name == "animate") return commandAnimate;
+        if (name == "session") return commandSession;
+        if (name == "live") return commandLive;
+        if (name == "control") return commandControl;
+        if (name == "batch") return commandBatch;
+        return nullptr;
+    }
+
+    const char* statusName(BatchStatus status) {
+        switch (status) {
+        case BatchStatus::Done: return "réussie";
+        case BatchStatus::Failed: return "échec";
+        default: return "non lancée";
+        }
+    }
+
+    // Fichier de tâches (--jobs, ou --batch pour "attracteurs --batch f.toml") :
+    // chaque tâche est une commande ci-dessus, lancée dans un thread quand
+    // ses dépendances ont réussi et que ses cœurs tiennent dans --threads
+    int commandBatch(const Args& args) {
+        const std::string path = args.str("jobs", args.str("batch"));
+        if (path.empty()) {
+            std::fprintf(stderr, "--jobs taches.toml attendu\n");
+            return 2;
+        }
+        BatchFile file;
+        std::string error;
+        if (!readBatchFile(path, file, error)) {
+            std::fprintf(stderr, "%s : %s\n", path.c_str(), error.c_str());
+            return 2;
+        }
+        std::vector<Command> commands;
+        for (const BatchJob& job : file.jobs) {
+            Command command = findCommand(job.command);
+            if (!command || job.command == "batch" || job.command == "live" || job.command == "control") {
+                std::fprintf(stderr, "%s : commande %s impossible dans un fichier de tâches\n", job.name.c_str(),
+                             job.command.c_str());
+                return 2;
+            }
+            commands.push_back(command);
+        }
+        int budget = int(args.integer("threads", file.threads));
+        if (budget <= 0) budget = int(std::max(1u, std::thread::hardware_concurrency()));
+
+        std::printf("%zu tâches, %d cœurs\n", file.jobs.size(), budget);
+        std::fflush(stdout);
+        BatchReport report = runBatch(file.jobs, budget, [&](const BatchJob& job) {
+            // Sans threads, une commande prendrait tous les cœurs
+            std::vector<std::pair<std::string, std::string>> options = job.options;
+            options.emplace_back("threads", std::to_string(std::clamp(job.threads, 1, budget)));
+            Args jobArgs(options);
+            return commands[size_t(&job - file.jobs.data())](jobArgs);
+        }, [&](size_t i, const BatchJobResult& r) {
+            std::printf("[%s] %s en %.2f s\n", file.jobs[i].name.c_str(), statusName(r.status), r.seconds);
+            std::fflush(stdout);
+        });
+
+        int failed = 0;
+        double busy = 0.0;
+        // Largeurs en octets : un de plus par lettre accentuée des en-têtes
+        std::printf("\n%-25s %-12s %7s %11s %11s  %s\n", "Tâche", "Commande", "Cœurs", "Début (s)", "Durée (s)", "État");
+        Json jobs = Json::array();
+        for (size_t i = 0; i < file.jobs.size(); i++) {
+            const BatchJob& job = file.jobs[i];
+            const BatchJobResult& r = report.jobs[i];
+            failed += r.status != BatchStatus::Done;
+            busy += r.seconds;
+            std::printf("%-24s %-12s %6d %10.2f %10.2f  %s", job.name.c_str(), job.command.c_str(), r.threads,
+                        r.start, r.seconds, statusName(r.status));
+            if (r.status == BatchStatus::Failed) std::printf(" (code %d)", r.code);
+            std::printf("\n");
+            Json item = Json::object();
+            item.set("name", job.name);
+            item.set("command", job.command);
+            item.set("threads", r.threads);
+            item.set("start", r.start);
+            item.set("seconds", r.seconds);
+            item.set("status", r.status == BatchStatus::Done ? "done" : r.status == BatchStatus::Failed ? "failed" : "skipped");
+            item.set("code", r.code);
+            jobs.push(item);
+        }
+        std::printf("%zu tâches réussies sur %zu en %.2f s (%.2f s cumulées, au plus %d cœurs sur %d)\n",
+                    file.jobs.size() - size_t(failed), file.jobs.size(), report.seconds, busy, report.peakThreads,
+                    report.budget);
+
+        // --report : les mêmes mesures en JSON
+        if (args.has("report")) {
+            Json out = Json::object();
+            out.set("budget", report.budget);
+            out.set("peakThreads", report.peakThreads);
+            out.set("seconds", report.seconds);
+            out.set("jobs", jobs);
+            std::ofstream file(args.str("report"));
+            if (!(file << toJson(out) << "\n")) {
+                std::fprintf(stderr, "Écriture impossible : %s\n", args.str("report").c_str());
+                return 1;
+            }
+        }
+        return failed ? 1 : 0;
+    }
+}
+
+void printCommandLineUsage(const char* program) {
+    std::fprintf(stderr,
+        "Usage : %s <commande> [--option valeur]...\n"
+        "\n"
+        "  sweep   carte de Lyapunov / de périodicité sur deux paramètres\n"
+        "          --type rossler --px a --py c --x 0.05:0.45 --y 2:12 --size 512x512\n"
+        "          --mode lyapunov|period --steps N --transient N --dt f --threads N\n"
+        "          --set b=0.2 --max-period N --tol f --out carte.ppm --raw carte.f32\n"
+        "          --npy carte.npy --precision single|double\n"
+        "\n"
+        "  bifurcation  diagramme de bifurcation sur un paramètre\n"
+        "          --type rossler --param c --range 2:12 --size 800x500 --axis x\n"
+        "          --record maxima|section --section y=0 --values a:b --steps N\n"
+        "          --transient N --dt f --set a=0.2 --threads N --out diagramme.ppm\n"
+        "          --npy comptes.npy\n"
+        "\n"
+        "  poincare     section de Poincaré d'un flot 3D par le plan n.p = offset\n"
+        "          --type lorenz --normal 0,0,1 --offset 27 --direction up|both --size 800x800\n"
+        "          --crossings N --u a:b --v a:b --integrator rk4|euler|exact|taylor --order N --dt f\n"
+        "          --transient N --set rho=28 --threads N --out section.ppm\n"
+        "          --npy comptes.npy\n"
+        "\n"
+        "  lyapunov     exposants de Lyapunov et dimension de Kaplan-Yorke\n"
+        "          --type lorenz --steps N --transient N --dt f --set rho=28 --out exposants.json\n"
+        "          --integrator euler|rk4|exact|taylor --order N --precision single|double\n"
+        "\n"
+        "  record       enregistre une trajectoire (format .atr)\n"
+        "          --type lorenz --steps N --integrator euler|rk4|exact|taylor --order N --dt f --set rho=28\n"
+        "          --chunk N --buffers N --policy block|drop|downsample --out trajectoire.atr\n"
+        "          --codec raw|delta --quantum 1e-3 --threads N\n"
+        "          --precision single|double (calcul) --storage single|double (fichier, comme le calcul)\n"
+        "          --check 1 (x = pas de chaque point, vérifié à la relecture)\n"
+        "\n"
+        "  inspect      affiche l'en-tête et l'étendue d'un fichier .atr\n"
+        "          --in trajectoire.atr\n"
+        "\n"
+        "  export       convertit un fichier .atr en tableau NumPy (n, dims)\n"
+        "          --in trajectoire.atr --out trajectoire.npy\n"
+        "\n"
+        "  animate      rend une animation hors écran, à toute résolution\n"
+        "          --type lorenz --mode orbit|morph|keys --frames N --size 1920x1080 --steps N\n"
+        "          --turns 1 (orbit) --param rho --range 20:30 (morph) --yaw f --pitch f\n"
+        "          --keys \"0:rho=20,yaw=0;119:rho=30,zoom=20\" --interpolation smooth|linear (keys)\n"
+        "          --style points|density --zoom f --color 0,1,1 --integrator euler|rk4|exact|taylor --order N --dt f --set rho=28\n"
+        "          --threads N --out image_%%05d.png | --out film.y4m | --pipe \"ffmpeg -i - film.mp4\"\n"
+        "          --fps 30 (--frames 1 : --out image.png sans motif) --precision single|double\n"
+        "\n"
+        "  session      relit une session sauvegardée (--in), ou en écrit une (--out)\n"
+        "          --in session.atrs | --out session.atrs --type lorenz --steps N --crossings N\n"
+        "          --integrator euler|rk4|exact|taylor --order N --precision single|double (--out)\n"
+        "\n"
+        "  live         lit le flux en mémoire partagée d'une application lancée avec --live\n"
+        "          --name /attracteurs --seconds N | --publish N --type lorenz --capacity N\n"
+        "\n"
+        "  control      envoie des requêtes JSON à une application lancée avec --control\n"
+        "          --socket attracteurs.sock --send '{\"cmd\": \"set\", \"params\": {\"rho\": 30}}'\n"
+        "          --file requetes.jsonl (- : entrée standard) --timeout ms | --check 1\n"
+        "\n"
+        "  batch        exécute un fichier de tâches (aussi : attracteurs --batch taches.toml)\n"
+        "          --jobs taches.toml --threads N (budget de cœurs) --report mesures.json\n"
+        "\n"
+        "  Système personnalisé, à la place de --type dans toutes les commandes :\n"
+        "          --system systeme.toml | --equations \"s*(y-x);x*(r-z)-y;x*y-b*z\"\n"
+        "          --params s=10,r=28,b=2.667 --map 0|1 (équations = point suivant) --name nom\n"
+        "          --jit 1 (noyaux compilés par le compilateur local, cache dans ATTRACTEUR_JIT_CACHE)\n"
+        "\n"
+        "  Greffons : bibliothèques du dossier ATTRACTEUR_PLUGINS (par défaut plugins/),\n"
+        "          chargées au démarrage ; --type <nom du système> ou 16, 17...\n",
+        program);
+}
+
+int runCommandLine(int argc, char* argv[]) {
+    if (argc < 2) return -1;
+    const char* command = argv[1];
+    if (!std::strcmp(command, "help") || !std::strcmp(command, "--help")) {
+        printCommandLineUsage(argv[0]);
+        return 0;
+    }
+    // "attracteurs --batch taches.toml" : --batch est lu comme une option
+    const bool batch = !std::strcmp(command, "--batch");
+    Command handler = batch ? commandBatch : findCommand(command);
+    if (!handler) return -1;
+    loadStartupPlugins();
+
+    Args args(argc, argv, batch ? 1 : 2);
+    if (!args.valid) return 2;
+    return handler(args);
+}
+/**
+ * Cli.cpp
+ *
+ * Contient l'implémentation des commandes en ligne de commande.
+ */
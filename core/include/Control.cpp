@@ -0,0 +1,326 @@
+#include "Control.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    bool real(const Json* v, float& out) {
+        if (!v || !v->isNumber()) return false;
+        out = float(v->number);
+        return true;
+    }
+
+    bool triple(const Json* v, float out[3]) {
+        if (!v || !v->isArray() || v->items.size() != 3) return false;
+        for (int i = 0; i < 3; i++) {
+            if (!real(&v->items[size_t(i)], out[i])) return false;
+        }
+        return true;
+    }
+
+    // Type disponible (Attractor::available), par numéro ou par nom ; 0 si inconnu
+    int systemType(const Json& v) {
+        int type = v.isNumber() ? int(v.number) : v.isString() ? Attractor::find(v.text) : 0;
+        return Attractor::available(type) ? type : 0;
+    }
+
+    // {"rho": 30} (noms du registre) ou [10, 28, 2.67]
+    bool readParams(const Json& v, int type, float* params, std::string& error) {
+        const SystemInfo& sys = Attractor::info(type);
+        if (v.isArray()) {
+            if (v.items.size() > size_t(kMaxParams)) {
+                error = "trop de paramètres";
+                return false;
+            }
+            for (size_t i = 0; i < v.items.size(); i++) {
+                if (!real(&v.items[i], params[i])) {
+                    error = "paramètre " + std::to_string(i) + " : nombre attendu";
+                    return false;
+                }
+            }
+            return true;
+        }
+        if (!v.isObject()) {
+            error = "params : objet ou tableau attendu";
+            return false;
+        }
+        for (const auto& [name, value] : v.members) {
+            int index = -1;
+            for (int i = 0; i < sys.paramCount; i++) {
+                if (name == sys.paramNames[i]) index = i;
+            }
+            if (index < 0) {
+                error = std::string("paramètre inconnu pour ") + sys.name + " : " + name;
+                return false;
+            }
+            if (!real(&value, params[index])) {
+                error = name + " : nombre attendu";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Json paramsJson(int type, const float* params) {
+        const SystemInfo& sys = Attractor::info(type);
+        Json out = Json::object();
+        for (int i = 0; i < sys.paramCount; i++) out.set(sys.paramNames[i], double(params[i]));
+        return out;
+    }
+
+    Json tripleJson(float a, float b, float c) {
+        Json out = Json::array();
+        out.push(double(a));
+        out.push(double(b));
+        out.push(double(c));
+        return out;
+    }
+
+    void commandSet(const Json& request, Json& reply, ControlTarget& target) {
+        // Copies modifiées puis appliquées d'un bloc : une requête invalide ne
+        // laisse rien à moitié changé
+        Attractor att = target.attractor;
+        FrameView view = target.view;
+        bool reset = false;
+        std::string error;
+
+        if (const Json* v = request.find("type")) {
+            int type = systemType(*v);
+            if (!type) {
+                reply.set("error", "système inconnu");
+                return;
+            }
+            if (type != att.type) {
+                att.select(type);
+                view.zoom = Attractor::info(type).zoom;
+                reset = true;
+            }
+        }
+        if (const Json* v = request.find("params")) {
+            if (!readParams(*v, att.type, att.params, error)) {
+                reply.set("error", error);
+                return;
+            }
+        }
+        if (const Json* v = request.find("dt")) {
+            if (!real(v, att.dt) || !(att.dt > 0.0f)) {
+                reply.set("error", "dt : nombre positif attendu");
+                return;
+            }
+        }
+        if (const Json* v = request.find("integrator")) {
+            if (!v->isString() || !findIntegrator(v->text, att.integrator)) {
+                reply.set("error", "integrator : \"euler\", \"rk4\", \"exact\" ou \"taylor\"");
+                return;
+            }
+        }
+        if (const Json* v = request.find("order")) {
+            float order;
+            if (!real(v, order) || order < 2.0f || order > float(kMaxTaylorOrder)) {
+                reply.set("error", "order : entier de 2 à " + std::to_string(kMaxTaylorOrder) + " attendu");
+                return;
+            }
+            att.taylorOrder = int(order);
+        }
+        if (const Json* v = request.find("precision")) {
+            if (v->isString() && v->text == "single") att.precision = Precision::Single;
+            else if (v->isString() && v->text == "double") att.precision = Precision::Double;
+            else {
+                reply.set("error", "precision : \"single\" ou \"double\"");
+                return;
+            }
+        }
+        if (const Json* v = request.find("point")) {
+            float p[3];
+            if (!triple(v, p)) {
+                reply.set("error", "point : [x, y, z] attendu");
+                return;
+            }
+            att.p = {p[0], p[1], p[2]};
+            reset = true;
+        }
+        if (const Json* v = request.find("camera")) {
+            bool ok = v->isObject();
+            if (ok && v->find("yaw")) ok = real(v->find("yaw"), view.yaw);
+            if (ok && v->find("pitch")) ok = real(v->find("pitch"), view.pitch);
+            if (ok && v->find("zoom")) ok = real(v->find("zoom"), view.zoom);
+            if (!ok) {
+                reply.set("error", "camera : {\"yaw\", \"pitch\", \"zoom\"} en nombres attendu");
+                return;
+            }
+        }
+        if (const Json* v = request.find("color")) {
+            if (!triple(v, view.color)) {
+                reply.set("error", "color : [r, g, b] entre 0 et 1 attendu");
+                return;
+            }
+        }
+        if (const Json* v = request.find("reset"); v && v->kind == Json::Kind::Bool && v->boolean) {
+            att.reset();
+            reset = true;
+        }
+
+        target.attractor = att;
+        target.view = view;
+        target.resetPoints = target.resetPoints || reset;
+        controlStatus(target, reply);
+    }
+
+    // Images clés : chaque valeur absente reprend celle de la précédente
+    bool readKeyframes(const Json& v, const AnimationSettings& s, std::vector<Keyframe>& keys, std::string& error) {
+        if (!v.isArray() || v.items.empty()) {
+            error = "keys : tableau d'images clés attendu";
+            return false;
+        }
+        Keyframe previous;
+        std::copy(s.params, s.params + kMaxParams, previous.params);
+        previous.view = s.view;
+        for (const Json& item : v.items) {
+            Keyframe k = previous;
+            float frame;
+            if (!item.isObject() || !real(item.find("frame"), frame)) {
+                error = "image clé : {\"frame\": n, ...} attendu";
+                return false;
+            }
+            k.frame = int(frame);
+            if (const Json* p = item.find("params"); p && !readParams(*p, s.type, k.params, error)) return false;
+            if (item.find("yaw") && !real(item.find("yaw"), k.view.yaw)) error = "yaw : nombre attendu";
+            if (item.find("pitch") && !real(item.find("pitch"), k.view.pitch)) error = "pitch : nombre attendu";
+            if (item.find("zoom") && !real(item.find("zoom"), k.view.zoom)) error = "zoom : nombre attendu";
+            if (!error.empty()) return false;
+            keys.push_back(k);
+            previous = k;
+        }
+        return true;
+    }
+
+    void commandAnimate(const Json& request, Json& reply, ControlTarget& target) {
+        if (target.animation.isRunning()) {
+            reply.set("error", "une animation est déjà en cours");
+            return;
+        }
+        const Attractor& att = target.attractor;
+        const SystemInfo& sys = Attractor::info(att.type);
+        AnimationSettings s(att.type);
+        std::copy(att.params, att.params + kMaxParams, s.params);
+        s.dt = att.dt;
+        s.initial = sys.initial;
+        s.integrator = sys.isMap ? Integrator::Euler : att.integrator;
+        s.taylorOrder = att.taylorOrder;
+        s.precision = att.precision;
+        s.view = target.view;
+        std::string error;
+        float value;
+
+        std::string mode = request.find("mode") && request.find("mode")->isString() ? request.find("mode")->text : "orbit";
+        if (mode == "morph") {
+            s.mode = AnimationMode::Morph;
+            float range[2];
+            const Json* param = request.find("param");
+            const Json* r = request.find("range");
+            s.param = -1;
+            for (int i = 0; param && param->isString() && i < sys.paramCount; i++) {
+                if (param->text == sys.paramNames[i]) s.param = i;
+            }
+            if (s.param < 0 || !r || !r->isArray() || r->items.size() != 2 || !real(&r->items[0], range[0])
+                || !real(&r->items[1], range[1])) {
+                reply.set("error", "morph : \"param\" (nom) et \"range\" [a, b] attendus");
+                return;
+            }
+            s.from = range[0];
+            s.to = range[1];
+        } else if (mode == "keys") {
+            s.mode = AnimationMode::Keyframes;
+            const Json* keys = request.find("keys");
+            if (!keys || !readKeyframes(*keys, s, s.keyframes, error)) {
+                reply.set("error", error.empty() ? "keys attendu en mode keys" : error);
+                return;
+            }
+            if (const Json* v = request.find("smooth"); v && v->kind == Json::Kind::Bool) s.smooth = v->boolean;
+        } else if (mode == "orbit") {
+            if (real(request.find("turns"), value)) s.turns = value;
+        } else {
+            reply.set("error", "mode : \"orbit\", \"morph\" ou \"keys\"");
+            return;
+        }
+        if (real(request.find("frames"), value)) s.frames = int(value);
+        if (real(request.find("steps"), value)) s.steps = long(value);
+        if (real(request.find("transient"), value)) s.transient = long(value);
+        if (real(request.find("threads"), value)) s.threads = int(value);
+        if (const Json* v = request.find("size")) {
+            float size[2];
+            if (!v->isArray() || v->items.size() != 2 || !real(&v->items[0], size[0]) || !real(&v->items[1], size[1])) {
+                reply.set("error", "size : [largeur, hauteur] attendu");
+                return;
+            }
+            s.width = int(size[0]);
+            s.height = int(size[1]);
+        }
+        if (const Json* v = request.find("style"); v && v->isString()) {
+            if (v->text == "density") s.style = FrameStyle::Density;
+            else if (v->text != "points") {
+                reply.set("error", "style : \"points\" ou \"density\"");
+                return;
+            }
+        }
+
+        AnimationOutput output;
+        if (const Json* v = request.find("out"); v && v->isString()) output.path = v->text;
+        if (const Json* v = request.find("pipe"); v && v->isString()) {
+            output.format = FrameFormat::Y4m;
+            output.command = v->text;
+        } else if (output.path.size() >= 4 && output.path.compare(output.path.size() - 4, 4, ".y4m") == 0) {
+            output.format = FrameFormat::Y4m;
+        }
+        if (real(request.find("fps"), value)) output.fps = std::max(1, int(value));
+
+        target.animation.start(s, output);
+        reply.set("frames", s.frames);
+    }
+}
+
+void controlStatus(const ControlTarget& target, Json& reply) {
+    const Attractor& att = target.attractor;
+    const SystemInfo& sys = Attractor::info(att.type);
+    reply.set("type", att.type);
+    reply.set("system", sys.name);
+    reply.set("params", paramsJson(att.type, att.params));
+    reply.set("dt", double(att.dt));
+    reply.set("integrator", integratorName(sys.isMap ? Integrator::Euler : att.integrator));
+    reply.set("order", att.taylorOrder);
+    reply.set("precision", att.precision == Precision::Double ? "double" : "single");
+    reply.set("point", tripleJson(att.p.x, att.p.y, att.p.z));
+    Json camera = Json::object();
+    camera.set("yaw", double(target.view.yaw));
+    camera.set("pitch", double(target.view.pitch));
+    camera.set("zoom", double(target.view.zoom));
+    reply.set("camera", camera);
+    reply.set("color", tripleJson(target.view.color[0], target.view.color[1], target.view.color[2]));
+
+    const AnimationExport& a = target.animation;
+    Json animation = Json::object();
+    animation.set("running", a.isRunning());
+    animation.set("done", a.framesDone());
+    animation.set("frames", a.frames());
+    if (!a.isRunning() && a.frames() > 0) {
+        animation.set("seconds", a.result().seconds);
+        if (!a.result().error.empty()) animation.set("error", a.result().error);
+    }
+    reply.set("animation", animation);
+}
+
+bool handleControl(const Json& request, Json& reply, ControlTarget& target) {
+    const Json* cmd = request.find("cmd");
+    const std::string name = cmd && cmd->isString() ? cmd->text : "";
+    if (name == "status") controlStatus(target, reply);
+    else if (name == "set") commandSet(request, reply, target);
+    else if (name == "animate") commandAnimate(request, reply, target);
+    else if (name == "cancel") target.animation.cancel();
+    else return false;
+    return true;
+}
+/**
+ * Control.cpp
+ *
+ * Contient la lecture et la validation des requêtes de contrôle communes et
+ * leur application à la simulation, à la vue et à l'animation.
+ */
@@ -0,0 +1,368 @@
+#include "ControlServer.h"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+ControlServer::~ControlServer() {
+    stop();
+}
+
+int ControlServer::poll(const Handler& handler, int max) {
+    int done = 0;
+    for (; done < max; done++) {
+        Request request;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (requests.empty()) break;
+            request = std::move(requests.front());
+            requests.pop_front();
+        }
+        Json answer = Json::object();
+        if (request.error.empty()) handler(request.body, answer);
+        else answer.set("error", request.error);
+        Json line = Json::object();
+        if (const Json* id = request.body.find("id")) line.set("id", *id);
+        line.set("ok", answer.find("error") == nullptr);
+        for (auto& m : answer.members) line.set(m.first, std::move(m.second));
+        reply(request.client, toJson(line) + "\n");
+    }
+    return done;
+}
+
+#ifdef _WIN32
+
+bool ControlServer::start(const std::string& path) {
+    socketPath = path;
+    lastError = "socket Unix non pris en charge sous Windows";
+    return false;
+}
+
+void ControlServer::stop() {}
+void ControlServer::reply(int, const std::string&) {}
+void ControlServer::serve() {}
+
+bool controlRequest(const std::string&, const std::vector<std::string>&, std::vector<std::string>& replies,
+                    std::string& error, int) {
+    replies.clear();
+    error = "socket Unix non pris en charge sous Windows";
+    return false;
+}
+
+#else
+
+namespace {
+    constexpr size_t kMaxLine = 1 << 20;        // Ligne plus longue : client déconnecté
+    constexpr size_t kMaxQueued = 256;          // Requêtes en attente du thread principal
+
+    std::string errorLine(const std::string& message) {
+        Json reply = Json::object();
+        reply.set("ok", false);
+        reply.set("error", message);
+        return toJson(reply) + "\n";
+    }
+
+    bool fillAddress(const std::string& path, sockaddr_un& address) {
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (path.empty() || path.size() >= sizeof(address.sun_path)) return false;
+        std::memcpy(address.sun_path, path.c_str(), path.size());
+        return true;
+    }
+
+    void nonBlocking(int fd) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+
+    // Envoi sans SIGPIPE si le client est parti
+    ssize_t sendSome(int fd, const char* data, size_t bytes) {
+#ifdef MSG_NOSIGNAL
+        return send(fd, data, bytes, MSG_NOSIGNAL);
+#else
+        return send(fd, data, bytes, 0);
+#endif
+    }
+}
+
+bool ControlServer::start(const std::string& path) {
+    stop();
+    socketPath = path;
+    sockaddr_un address;
+    if (!fillAddress(path, address)) {
+        lastError = "chemin de socket vide ou trop long : " + path;
+        return false;
+    }
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        lastError = std::string("socket : ") + std::strerror(errno);
+        return false;
+    }
+    // Socket créé réservé à l'utilisateur (umask 0077 le temps de bind) : un
+    // chmod après coup laisserait une fenêtre où un autre compte local peut
+    // se connecter et envoyer des commandes qui écrivent des fichiers
+    auto bindPrivate = [&] {
+        const mode_t mask = umask(0077);
+        const int result = bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        const int error = errno;
+        umask(mask);
+        errno = error;
+        return result;
+    };
+    int bound = bindPrivate();
+    if (bound != 0 && errno == EADDRINUSE) {
+        // Instance active, ou socket laissé par une instance arrêtée
+        // brutalement ; un fichier qui n'est pas un socket n'est pas touché
+        struct stat st;
+        int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+        bool alive = probe >= 0 && connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        if (probe >= 0) ::close(probe);
+        if (!alive && lstat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+            unlink(path.c_str());
+            bound = bindPrivate();
+        } else {
+            errno = EADDRINUSE;
+        }
+    }
+    if (bound != 0 || listen(listener, 8) != 0) {
+        lastError = path + " : " + (errno == EADDRINUSE ? "déjà utilisé (autre instance ?)" : std::strerror(errno));
+        ::close(listener);
+        listener = -1;
+        return false;
+    }
+    chmod(path.c_str(), 0600);      // 0700 à la création : lecture et écriture suffisent
+    nonBlocking(listener);
+    if (pipe(wake) != 0) {
+        lastError = std::string("pipe : ") + std::strerror(errno);
+        ::close(listener);
+        listener = -1;
+        unlink(path.c_str());
+        return false;
+    }
+    nonBlocking(wake[0]);
+    nonBlocking(wake[1]);
+    lastError.clear();
+    stopRequested = false;
+    thread = std::thread(&ControlServer::serve, this);
+    return true;
+}
+
+void ControlServer::stop() {
+    if (thread.joinable()) {
+        stopRequested = true;
+        char c = 0;
+        (void)!write(wake[1], &c, 1);
+        thread.join();
+    }
+    if (listener >= 0) {
+        ::close(listener);
+        unlink(socketPath.c_str());
+    }
+    listener = -1;
+    for (int& fd : wake) {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    requests.clear();
+    replies.clear();
+}
+
+void ControlServer::reply(int client, const std::string& line) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        replies.emplace_back(client, line);
+    }
+    char c = 0;
+    (void)!write(wake[1], &c, 1);   // Tube plein : le thread est déjà réveillé
+}
+
+void ControlServer::serve() {
+    struct Client {
+        int fd;
+        std::string in, out;
+        int pending = 0;            // Requêtes en file, réponse pas encore reçue
+        bool eof = false;           // Le client n'enverra plus rien
+    };
+    std::map<int, Client> clients;  // Par identifiant, jamais réutilisé
+    int nextId = 0;
+    std::vector<pollfd> fds;
+    std::vector<int> ids;
+
+    while (!stopRequested) {
+        // Lignes complètes : analysées ici, exécutées par poll(). File pleine :
+        // le reste attend dans in et le client n'est plus lu (contre-pression),
+        // les réponses gardent ainsi l'ordre des requêtes
+        bool full = false;
+        for (auto& [id, c] : clients) {
+            size_t start = 0;
+            for (size_t end; (end = c.in.find('\n', start)) != std::string::npos; start = end + 1) {
+                std::string line = c.in.substr(start, end - start);
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                if (line.find_first_not_of(" \t") == std::string::npos) continue;
+                Request request{id, Json(), ""};
+                if (!parseJson(line, request.body, request.error)) request.error = "JSON invalide : " + request.error;
+                else if (!request.body.isObject()) request.error = "objet JSON attendu";
+                std::lock_guard<std::mutex> lock(mutex);
+                if (requests.size() >= kMaxQueued) {
+                    full = true;
+                    break;
+                }
+                requests.push_back(std::move(request));
+                c.pending++;
+            }
+            c.in.erase(0, start);
+        }
+
+        fds.clear();
+        ids.clear();
+        fds.push_back({wake[0], POLLIN, 0});
+        fds.push_back({listener, POLLIN, 0});
+        for (auto& [id, c] : clients) {
+            short events = short((c.eof || full ? 0 : POLLIN) | (c.out.empty() ? 0 : POLLOUT));
+            if (!events) continue;
+            fds.push_back({c.fd, events, 0});
+            ids.push_back(id);
+        }
+        if (::poll(fds.data(), nfds_t(fds.size()), -1) < 0 && errno != EINTR) break;
+
+        if (fds[0].revents & POLLIN) {
+            char drain[64];
+            while (read(wake[0], drain, sizeof(drain)) > 0) {}
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto& [id, line] : replies) {
+                auto it = clients.find(id);
+                if (it == clients.end()) continue;
+                it->second.out += line;
+                it->second.pending--;
+            }
+            replies.clear();
+        }
+        if (fds[1].revents & POLLIN) {
+            for (int fd; (fd = accept(listener, nullptr, nullptr)) >= 0;) {
+                nonBlocking(fd);
+                clients[nextId++] = {fd, {}, {}};
+            }
+        }
+
+        for (size_t i = 2; i < fds.size(); i++) {
+            Client& c = clients.at(ids[i - 2]);
+            if (fds[i].revents & (POLLERR | POLLNVAL)) {
+                c.eof = true;
+                c.out.clear();
+                continue;
+            }
+            if (fds[i].revents & (POLLIN | POLLHUP)) {
+                char buffer[65536];
+                ssize_t n;
+                while ((n = read(c.fd, buffer, sizeof(buffer))) > 0) c.in.append(buffer, size_t(n));
+                // Fin d'envoi : les requêtes déjà reçues obtiennent leur réponse
+                if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) c.eof = true;
+                if (c.in.size() > kMaxLine && c.in.find('\n') == std::string::npos) {
+                    c.eof = true;
+                    c.in.clear();
+                    c.out += errorLine("ligne trop longue");
+                }
+            }
+            if (!c.out.empty()) {
+                ssize_t n = sendSome(c.fd, c.out.data(), c.out.size());
+                if (n > 0) c.out.erase(0, size_t(n));
+                else if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+                    c.eof = true;
+                    c.out.clear();
+                }
+            }
+        }
+        for (auto it = clients.begin(); it != clients.end();) {
+            const Client& c = it->second;
+            if (c.eof && c.pending == 0 && c.out.empty() && c.in.find('\n') == std::string::npos) {
+                ::close(c.fd);
+                it = clients.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        connected = int(clients.size());
+    }
+    for (auto& [id, c] : clients) ::close(c.fd);
+    connected = 0;
+}
+
+bool controlRequest(const std::string& path, const std::vector<std::string>& requests,
+                    std::vector<std::string>& replies, std::string& error, int timeoutMs) {
+    replies.clear();
+    sockaddr_un address;
+    if (!fillAddress(path, address)) {
+        error = "chemin de socket vide ou trop long : " + path;
+        return false;
+    }
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        error = path + " : " + std::strerror(errno);
+        if (fd >= 0) ::close(fd);
+        return false;
+    }
+    std::string out;
+    size_t expected = 0;
+    for (const std::string& line : requests) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;    // Sans réponse
+        out += line + "\n";
+        expected++;
+    }
+    bool ok = true;
+    for (size_t sent = 0; ok && sent < out.size();) {
+        ssize_t n = sendSome(fd, out.data() + sent, out.size() - sent);
+        if (n <= 0) {
+            error = "envoi interrompu";
+            ok = false;
+        } else {
+            sent += size_t(n);
+        }
+    }
+
+    std::string in;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (ok && replies.size() < expected) {
+        size_t end = in.find('\n');
+        if (end != std::string::npos) {
+            replies.push_back(in.substr(0, end));
+            in.erase(0, end + 1);
+            continue;
+        }
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        pollfd p = {fd, POLLIN, 0};
+        if (left.count() <= 0 || ::poll(&p, 1, int(left.count())) <= 0) {
+            error = "pas de réponse";
+            ok = false;
+            break;
+        }
+        char buffer[4096];
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if (n <= 0) {
+            error = "connexion fermée par l'application";
+            ok = false;
+        } else {
+            in.append(buffer, size_t(n));
+        }
+    }
+    ::close(fd);
+    return ok;
+}
+
+#endif
+/**
+ * ControlServer.cpp
+ *
+ * Contient le thread du serveur de contrôle (poll sur le socket d'écoute,
+ * les clients et le tube de réveil), la file des requêtes et le client.
+ */
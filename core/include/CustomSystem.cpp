@@ -0,0 +1,217 @@
+#include "CustomSystem.h"
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include "Jit.h"
+#include "Toml.h"
+
+namespace {
+    // Version installée : définition, registre et programmes compilés
+    struct Compiled {
+        CustomDefinition def;
+        SystemInfo info;
+        ExpressionProgram field;     // Entrées x, y, z, paramètres ; sorties dx, dy, dz
+        ExpressionProgram tangent;   // Entrées suivies de la direction ; sorties suivies de J v
+        std::string backend;
+    };
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Compiled>> versions;   // Jamais libérées
+    std::atomic<const Compiled*> current{nullptr};
+
+    bool identifier(const std::string& name) {
+        if (name.empty() || std::isdigit((unsigned char)name[0])) return false;
+        for (char c : name) {
+            if (!std::isalnum((unsigned char)c) && c != '_') return false;
+        }
+        return true;
+    }
+
+    bool sameDefinition(const CustomDefinition& a, const CustomDefinition& b) {
+        return a.name == b.name && a.equations[0] == b.equations[0] && a.equations[1] == b.equations[1]
+            && a.equations[2] == b.equations[2] && a.params == b.params && a.isMap == b.isMap
+            && a.initial.x == b.initial.x && a.initial.y == b.initial.y && a.initial.z == b.initial.z && a.zoom == b.zoom
+            && a.native == b.native;
+    }
+
+    bool checkParams(const std::vector<std::pair<std::string, float>>& params, std::string& error) {
+        if (params.size() > size_t(kMaxParams)) {
+            error = "au plus " + std::to_string(kMaxParams) + " paramètres";
+            return false;
+        }
+        for (size_t i = 0; i < params.size(); i++) {
+            const std::string& name = params[i].first;
+            if (!identifier(name) || name == "x" || name == "y" || name == "z") {
+                error = "nom de paramètre invalide : " + name;
+                return false;
+            }
+            for (size_t j = 0; j < i; j++) {
+                if (params[j].first == name) {
+                    error = "paramètre défini deux fois : " + name;
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+bool defineCustomSystem(const CustomDefinition& def, std::string& error) {
+    if (!checkParams(def.params, error)) return false;
+    const Compiled* installed = current.load();
+    if (installed && sameDefinition(installed->def, def)) return true;
+
+    auto c = std::make_unique<Compiled>();
+    c->def = def;
+    std::vector<std::string> variables = {"x", "y", "z"};
+    for (const auto& [name, value] : def.params) variables.push_back(name);
+    const bool plane = def.equations[2].find_first_not_of(" \t") == std::string::npos;
+    std::vector<ExpressionSource> sources = {
+        {"dx", def.equations[0], def.isMap ? 0 : -1},
+        {"dy", def.equations[1], def.isMap ? 1 : -1},
+        {"dz", plane ? "0" : def.equations[2], def.isMap && !plane ? 2 : -1},
+    };
+    if (!compileExpressions(sources, variables, 0, c->field, error)) return false;
+    if (!compileExpressions(sources, variables, 3, c->tangent, error)) return false;
+    c->backend = "machine virtuelle";
+    if (def.native) {
+        // Avant la publication : les calculs en cours ne voient jamais un
+        // programme à moitié branché
+        JitResult jit = compileNative({&c->field, &c->tangent});
+        char seconds[32];
+        std::snprintf(seconds, sizeof(seconds), "%.2f", jit.seconds);
+        if (!jit.ok) c->backend += " (" + jit.error + ")";
+        else c->backend = jit.cached ? "natif (cache)" : "natif (compilé en " + std::string(seconds) + " s)";
+    }
+
+    Compiled& v = *c;
+    v.info = {v.def.name.c_str(), def.initial, def.zoom, plane ? 2 : 3, def.isMap, int(def.params.size()), {}, {}};
+    for (size_t i = 0; i < def.params.size(); i++) {
+        v.info.paramNames[i] = v.def.params[i].first.c_str();
+        v.info.paramDefaults[i] = v.def.params[i].second;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    versions.push_back(std::move(c));
+    current.store(&v);
+    return true;
+}
+
+bool hasCustomSystem() {
+    return current.load() != nullptr;
+}
+
+std::string customBackend() {
+    const Compiled* c = current.load();
+    return c ? c->backend : "";
+}
+
+CustomDefinition customDefinition() {
+    const Compiled* c = current.load();
+    return c ? c->def : CustomDefinition();
+}
+
+const SystemInfo* customSystemInfo() {
+    const Compiled* c = current.load();
+    return c ? &c->info : nullptr;
+}
+
+const ExpressionProgram* customProgram(bool tangent) {
+    const Compiled* c = current.load(std::memory_order_acquire);
+    if (!c) return nullptr;
+    return tangent ? &c->tangent : &c->field;
+}
+
+bool parseCustomParams(const std::string& text, std::vector<std::pair<std::string, float>>& out, std::string& error) {
+    out.clear();
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find(',', pos);
+        if (end == std::string::npos) end = text.size();
+        std::string item = text.substr(pos, end - pos);
+        size_t eq = item.find('=');
+        char* rest = nullptr;
+        float value = eq == std::string::npos ? 0.0f : std::strtof(item.c_str() + eq + 1, &rest);
+        if (eq == std::string::npos || rest == item.c_str() + eq + 1) {
+            error = "nom=valeur attendu : " + item;
+            return false;
+        }
+        out.emplace_back(item.substr(0, eq), value);
+        pos = end + 1;
+    }
+    return checkParams(out, error);
+}
+
+bool parseCustomSystem(const std::string& text, CustomDefinition& out, std::string& error) {
+    out = CustomDefinition();
+    Json doc;
+    if (!parseToml(text, doc, error)) return false;
+    for (const auto& [key, value] : doc.members) {
+        if (key == "name" || key == "dx" || key == "dy" || key == "dz") {
+            if (!value.isString()) {
+                error = key + " doit être une chaîne";
+                return false;
+            }
+            if (key == "name") out.name = value.text;
+            else out.equations[key[1] - 'x'] = value.text;
+        } else if (key == "map" || key == "native") {
+            if (value.kind != Json::Kind::Bool) {
+                error = key + " doit valoir true ou false";
+                return false;
+            }
+            (key == "map" ? out.isMap : out.native) = value.boolean;
+        } else if (key == "zoom") {
+            if (!value.isNumber() || value.number <= 0.0) {
+                error = "zoom doit être un nombre positif";
+                return false;
+            }
+            out.zoom = float(value.number);
+        } else if (key == "initial") {
+            bool ok = value.isArray() && value.items.size() >= 2 && value.items.size() <= 3;
+            for (size_t i = 0; ok && i < value.items.size(); i++) ok = value.items[i].isNumber();
+            if (!ok) {
+                error = "initial doit être un tableau de 2 ou 3 nombres";
+                return false;
+            }
+            out.initial = {float(value.items[0].number), float(value.items[1].number),
+                           value.items.size() == 3 ? float(value.items[2].number) : 0.0f};
+        } else if (key == "params" && value.isObject()) {
+            for (const auto& [name, v] : value.members) {
+                if (!v.isNumber()) {
+                    error = "params." + name + " doit être un nombre";
+                    return false;
+                }
+                out.params.emplace_back(name, float(v.number));
+            }
+        } else {
+            error = "clé inconnue : " + key;
+            return false;
+        }
+    }
+    if (out.equations[0].empty() || out.equations[1].empty()) {
+        error = "dx et dy sont obligatoires";
+        return false;
+    }
+    return checkParams(out.params, error);
+}
+
+bool readCustomSystem(const std::string& path, CustomDefinition& out, std::string& error) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        error = "lecture impossible";
+        return false;
+    }
+    std::ostringstream text;
+    text << in.rdbuf();
+    return parseCustomSystem(text.str(), out, error);
+}
+/**
+ * CustomSystem.cpp
+ *
+ * Contient la compilation et l'installation des systèmes personnalisés et la
+ * lecture de leurs fichiers.
+ */
@@ -0,0 +1,287 @@
+#include "DeltaCodec.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+    // Quotient de Rice à partir duquel la valeur est écrite telle quelle (64 bits)
+    constexpr uint64_t kEscape = 24;
+    // Au-delà, la prédiction d'ordre 3 pourrait déborder d'un int64
+    constexpr double kMaxQuantized = 4503599627370496.0;    // 2^52
+
+    int trailingZeros(uint64_t v) {
+#ifdef _MSC_VER
+        unsigned long i;
+        _BitScanForward64(&i, v);
+        return int(i);
+#else
+        return __builtin_ctzll(v);
+#endif
+    }
+
+    uint64_t lowBits(uint64_t v, int n) {
+        return n >= 64 ? v : v & ((uint64_t(1) << n) - 1);
+    }
+
+    uint64_t zigzag(int64_t v) { return (uint64_t(v) << 1) ^ uint64_t(v >> 63); }
+    int64_t unzigzag(uint64_t u) { return int64_t(u >> 1) ^ -int64_t(u & 1); }
+
+    // Arrondi au plus proche (llround n'est pas développé en ligne)
+    int64_t quantize(double v) {
+        return int64_t(v < 0.0 ? v - 0.5 : v + 0.5);
+    }
+
+    // Prédiction d'ordre order à partir des trois valeurs précédentes
+    int64_t predict(int order, int64_t q1, int64_t q2, int64_t q3) {
+        switch (order) {
+        case 1: return q1;
+        case 2: return 2 * q1 - q2;
+        case 3: return 3 * q1 - 3 * q2 + q3;
+        default: return 0;
+        }
+    }
+
+    // Bits écrits du poids faible au poids fort, par mots de 64 bits
+    // petit-boutistes (comme le reste du format), dans une zone déjà allouée
+    class BitWriter {
+    public:
+        explicit BitWriter(uint8_t* out) : begin(out), p(out) {}
+
+        // n <= 64, value < 2^n
+        void put(uint64_t value, int n) {
+            acc |= value << fill;
+            fill += n;
+            if (fill >= 64) {
+                emit(acc);
+                fill -= 64;
+                acc = fill > 0 ? value >> (n - fill) : 0;
+            }
+        }
+
+        // Octets écrits (multiple de 8)
+        size_t finish() {
+            if (fill > 0) emit(acc);
+            acc = 0;
+            fill = 0;
+            return size_t(p - begin);
+        }
+
+    private:
+        void emit(uint64_t word) {
+            std::memcpy(p, &word, sizeof(word));
+            p += sizeof(word);
+        }
+
+        uint8_t* begin;
+        uint8_t* p;
+        uint64_t acc = 0;
+        int fill = 0;
+    };
+
+    class BitReader {
+    public:
+        BitReader(const uint8_t* data, size_t bytes) : p(data), end(data + bytes) {}
+
+        bool ok() const { return !overrun; }
+
+        // n <= 32
+        uint64_t get(int n) {
+            refill();
+            uint64_t v = lowBits(acc, n);
+            consume(n);
+            return v;
+        }
+
+        uint64_t get64() {
+            uint64_t lo = get(32);
+            uint64_t hi = get(32);
+            return lo | hi << 32;
+        }
+
+        // Nombre de 1 avant le 0 de fin (kEscape : pas de 0, valeur brute)
+        int unary() {
+            refill();
+            uint64_t inverted = ~acc;
+            int ones = inverted ? trailingZeros(inverted) : 64;
+            if (ones >= int(kEscape)) {
+                consume(int(kEscape));
+                return int(kEscape);
+            }
+            consume(ones + 1);
+            return ones;
+        }
+
+    private:
+        void refill() {
+            if (fill > 32) return;
+            if (end - p >= 4) {
+                uint32_t w;
+                std::memcpy(&w, p, sizeof(w));
+                acc |= uint64_t(w) << fill;
+                fill += 32;
+                p += 4;
+            } else {
+                while (p < end && fill <= 56) {
+                    acc |= uint64_t(*p++) << fill;
+                    fill += 8;
+                }
+            }
+        }
+
+        void consume(int n) {
+            if (n > fill) {
+                overrun = true;
+                n = fill;
+            }
+            acc = n >= 64 ? 0 : acc >> n;
+            fill -= n;
+        }
+
+        const uint8_t* p;
+        const uint8_t* end;
+        uint64_t acc = 0;
+        int fill = 0;
+        bool overrun = false;
+    };
+
+    // Taille en bits des valeurs u codées en Rice de paramètre k
+    uint64_t riceBits(const uint64_t* u, size_t n, int k) {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < n; i++) {
+            uint64_t quotient = u[i] >> k;
+            bits += quotient < kEscape ? quotient + 1 + uint64_t(k) : kEscape + 64;
+        }
+        return bits;
+    }
+}
+
+template <typename T>
+bool deltaEncodable(const T* values, size_t count, double quantum) {
+    if (!(quantum > 0.0)) return false;
+    const double inv = 1.0 / quantum;
+    for (size_t i = 0; i < count; i++) {
+        // Faux aussi pour NaN et l'infini
+        if (!(std::abs(double(values[i]) * inv) < kMaxQuantized)) return false;
+    }
+    return true;
+}
+
+template <typename T>
+void deltaEncode(const T* values, size_t count, double quantum, std::vector<uint8_t>& out) {
+    const double inv = 1.0 / quantum;
+    // Pire cas : un octet d'en-tête par paquet, 88 bits par valeur échappée
+    const size_t at = out.size();
+    out.resize(at + count * 11 + count / kDeltaBlock + 16);
+    BitWriter bits(out.data() + at);
+
+    // d[order][3 + i] : différence d'ordre order de q en i, c'est-à-dire le
+    // résidu de la prédiction polynomiale d'ordre order ; les trois premières
+    // cases gardent l'historique du paquet précédent
+    int64_t d[4][kDeltaBlock + 3] = {};
+    uint64_t residuals[4][kDeltaBlock];
+
+    for (size_t base = 0; base < count; base += kDeltaBlock) {
+        const size_t n = std::min(kDeltaBlock, count - base);
+        for (size_t i = 0; i < n; i++) d[0][3 + i] = quantize(double(values[base + i]) * inv);
+        for (int order = 1; order < 4; order++) {
+            for (size_t i = 0; i < n; i++) d[order][3 + i] = d[order - 1][3 + i] - d[order - 1][2 + i];
+        }
+
+        // L'ordre retenu est celui de plus petite somme des résidus (bon
+        // indicateur de la taille en Rice)
+        uint64_t sums[4];
+        for (int order = 0; order < 4; order++) {
+            uint64_t sum = 0;
+            for (size_t i = 0; i < n; i++) {
+                uint64_t u = zigzag(d[order][3 + i]);
+                residuals[order][i] = u;
+                sum += u;           // < 64 x 2^56 : pas de débordement
+            }
+            sums[order] = sum;
+        }
+        int order = int(std::min_element(sums, sums + 4) - sums);
+        const uint64_t* u = residuals[order];
+
+        // Paramètre de Rice : autour de log2 de la moyenne, ajusté au bit près
+        uint64_t mean = sums[order] / n;
+        int k = 0;
+        while (k < 63 && (mean >> (k + 1)) != 0) k++;
+        uint64_t best = riceBits(u, n, k);
+        for (int candidate : {k - 1, k + 1}) {
+            if (candidate < 0 || candidate > 63) continue;
+            uint64_t size = riceBits(u, n, candidate);
+            if (size < best) {
+                best = size;
+                k = candidate;
+            }
+        }
+
+        bits.put(uint64_t(order) | uint64_t(k) << 2, 8);
+        for (size_t i = 0; i < n; i++) {
+            uint64_t quotient = u[i] >> k;
+            if (quotient >= kEscape) {
+                bits.put((uint64_t(1) << kEscape) - 1, int(kEscape));
+                bits.put(u[i], 64);
+            } else if (int(quotient) + 1 + k <= 64) {
+                // Unaire et bits de poids faible en une seule écriture
+                bits.put(((uint64_t(1) << quotient) - 1) | lowBits(u[i], k) << (quotient + 1), int(quotient) + 1 + k);
+            } else {
+                bits.put((uint64_t(1) << quotient) - 1, int(quotient) + 1);
+                bits.put(lowBits(u[i], k), k);
+            }
+        }
+
+        // Historique des différences pour le paquet suivant
+        for (int o = 0; o < 4; o++) {
+            for (int i = 0; i < 3; i++) d[o][i] = d[o][n + i];
+        }
+    }
+    out.resize(at + bits.finish());
+}
+
+template <typename T>
+bool deltaDecode(const uint8_t* data, size_t bytes, size_t count, double quantum, T* out) {
+    BitReader bits(data, bytes);
+    int64_t q1 = 0, q2 = 0, q3 = 0;
+    for (size_t base = 0; base < count; base += kDeltaBlock) {
+        const size_t n = std::min(kDeltaBlock, count - base);
+        uint64_t header = bits.get(8);
+        int order = int(header & 3);
+        int k = int(header >> 2);
+        for (size_t i = 0; i < n; i++) {
+            int quotient = bits.unary();
+            uint64_t u;
+            if (quotient == int(kEscape)) {
+                u = bits.get64();
+            } else {
+                uint64_t low = bits.get(std::min(k, 32));
+                if (k > 32) low |= bits.get(k - 32) << 32;
+                u = uint64_t(quotient) << k | low;
+            }
+            int64_t q = unzigzag(u) + predict(order, q1, q2, q3);
+            out[base + i] = T(double(q) * quantum);
+            q3 = q2;
+            q2 = q1;
+            q1 = q;
+        }
+        if (!bits.ok()) return false;
+    }
+    return true;
+}
+
+template bool deltaEncodable<float>(const float*, size_t, double);
+template bool deltaEncodable<double>(const double*, size_t, double);
+template void deltaEncode<float>(const float*, size_t, double, std::vector<uint8_t>&);
+template void deltaEncode<double>(const double*, size_t, double, std::vector<uint8_t>&);
+template bool deltaDecode<float>(const uint8_t*, size_t, size_t, double, float*);
+template bool deltaDecode<double>(const uint8_t*, size_t, size_t, double, double*);
+/**
+ * DeltaCodec.cpp
+ *
+ * Contient le codage par prédiction et le codage de Rice des colonnes, et leur
+ * décodage.
+ */
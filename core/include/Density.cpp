@@ -0,0 +1,71 @@
+#include "Density.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include "Npy.h"
+#include "Png.h"
+
+namespace {
+    // Noir -> rouge -> jaune -> blanc
+    void fire(float t, uint8_t* px) {
+        t = std::clamp(t, 0.0f, 1.0f);
+        px[0] = (uint8_t)(255.0f * std::min(1.0f, 3.0f * t));
+        px[1] = (uint8_t)(255.0f * std::clamp(3.0f * t - 1.0f, 0.0f, 1.0f));
+        px[2] = (uint8_t)(255.0f * std::clamp(3.0f * t - 2.0f, 0.0f, 1.0f));
+        px[3] = 255;
+    }
+
+    uint32_t columnMax(const DensityImage& image, int col) {
+        uint32_t m = 0;
+        for (int row = 0; row < image.height; row++) m = std::max(m, image.counts[size_t(row) * image.width + col]);
+        return m;
+    }
+}
+
+void densityToRgba(const DensityImage& image, DensityScale scale, int col0, int col1, uint8_t* rgba) {
+    float globalNorm = 0.0f;
+    if (scale == DensityScale::Global) {
+        uint32_t m = 0;
+        for (uint32_t c : image.counts) m = std::max(m, c);
+        globalNorm = m > 0 ? 1.0f / std::log1p(float(m)) : 0.0f;
+    }
+    for (int col = col0; col < col1; col++) {
+        float norm = globalNorm;
+        if (scale == DensityScale::PerColumn) {
+            uint32_t m = columnMax(image, col);
+            norm = m > 0 ? 1.0f / std::log1p(float(m)) : 0.0f;
+        }
+        for (int row = 0; row < image.height; row++) {
+            size_t i = size_t(row) * image.width + col;
+            fire(std::log1p(float(image.counts[i])) * norm, rgba + i * 4);
+        }
+    }
+}
+
+bool writeDensityImage(const DensityImage& image, DensityScale scale, const std::string& path) {
+    std::vector<uint8_t> rgba(size_t(image.width) * image.height * 4);
+    densityToRgba(image, scale, 0, image.width, rgba.data());
+    std::vector<uint8_t> rgb(size_t(image.width) * image.height * 3);
+    for (size_t i = 0; i < size_t(image.width) * image.height; i++) {
+        rgb[i * 3] = rgba[i * 4];
+        rgb[i * 3 + 1] = rgba[i * 4 + 1];
+        rgb[i * 3 + 2] = rgba[i * 4 + 2];
+    }
+    if (path.size() >= 4 && path.compare(path.size() - 4, 4, ".png") == 0) {
+        return writePng(path, rgb.data(), image.width, image.height, 3);
+    }
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    std::fprintf(f, "P6\n%d %d\n255\n", image.width, image.height);
+    size_t n = std::fwrite(rgb.data(), 1, rgb.size(), f);
+    return std::fclose(f) == 0 && n == rgb.size();
+}
+
+bool writeDensityNpy(const DensityImage& image, const std::string& path) {
+    return writeNpy(path, NpyType::UInt32, {uint64_t(image.height), uint64_t(image.width)}, image.counts.data());
+}
+/**
+ * Density.cpp
+ *
+ * Contient la mise en couleurs (échelle logarithmique) des images d'accumulation.
+ */
@@ -0,0 +1,644 @@
+#include "Expression.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <tuple>
+#include <type_traits>
+
+using Op = ExpressionProgram::Op;
+
+namespace {
+    constexpr double kPi = 3.14159265358979323846;
+    // Parenthèses, signes, puissances et appels imbriqués : l'analyse est
+    // récursive, une saisie hostile ne doit pas épuiser la pile
+    constexpr int kMaxNesting = 256;
+    // Profondeur du graphe (x + x + ... compris) : la dérivation est récursive
+    constexpr int kMaxGraphDepth = 4096;
+
+    bool unary(Op op) {
+        return op != Op::Add && op != Op::Sub && op != Op::Mul && op != Op::Div && op != Op::Pow
+            && op != Op::Min && op != Op::Max;
+    }
+
+    bool commutative(Op op) {
+        return op == Op::Add || op == Op::Mul || op == Op::Min || op == Op::Max;
+    }
+
+    // Sémantique de chaque opération, partagée par la machine virtuelle et le
+    // calcul des constantes à la compilation
+    template <typename T>
+    inline T compute(Op op, T a, T b) {
+        switch (op) {
+        case Op::Add: return a + b;
+        case Op::Sub: return a - b;
+        case Op::Mul: return a * b;
+        case Op::Div: return a / b;
+        case Op::Neg: return -a;
+        case Op::Pow: return std::pow(a, b);
+        case Op::Min: return b < a ? b : a;
+        case Op::Max: return a < b ? b : a;
+        case Op::Sin: return std::sin(a);
+        case Op::Cos: return std::cos(a);
+        case Op::Tan: return std::tan(a);
+        case Op::Tanh: return std::tanh(a);
+        case Op::Atan: return std::atan(a);
+        case Op::Exp: return std::exp(a);
+        case Op::Log: return std::log(a);
+        case Op::Sqrt: return std::sqrt(a);
+        case Op::Abs: return std::abs(a);
+        case Op::Floor: return std::floor(a);
+        case Op::Sign: return T((a > T(0)) - (a < T(0)));
+        case Op::Step: return a > T(0) ? T(1) : T(0);
+        }
+        return T(0);
+    }
+
+    // Une instruction sur tout le lot : O connu à la compilation, la boucle
+    // se vectorise
+    template <Op O, typename T>
+    inline void each(T* d, const T* a, const T* b, int n) {
+        for (int l = 0; l < n; l++) d[l] = compute(O, a[l], b[l]);
+    }
+
+    struct Function {
+        const char* name;
+        Op op;
+        int arity;
+    };
+
+    const Function kFunctions[] = {
+        {"sin", Op::Sin, 1}, {"cos", Op::Cos, 1}, {"tan", Op::Tan, 1}, {"tanh", Op::Tanh, 1},
+        {"atan", Op::Atan, 1}, {"exp", Op::Exp, 1}, {"log", Op::Log, 1}, {"sqrt", Op::Sqrt, 1},
+        {"abs", Op::Abs, 1}, {"floor", Op::Floor, 1}, {"sign", Op::Sign, 1}, {"step", Op::Step, 1},
+        {"min", Op::Min, 2}, {"max", Op::Max, 2}, {"pow", Op::Pow, 2},
+    };
+}
+
+// Graphe des expressions : chaque nœud n'existe qu'une fois (clé opération +
+// opérandes), les nœuds constants sont calculés et les cas neutres (x + 0,
+// x * 1...) simplifiés dès la construction. Les opérandes d'un nœud le
+// précèdent toujours : l'ordre des nœuds est un ordre d'exécution.
+class ExpressionCompiler {
+public:
+    explicit ExpressionCompiler(const std::vector<std::string>& variables) : variables(variables) {}
+
+    struct Node {
+        enum Kind : uint8_t { Input, Constant, Apply } kind;
+        Op op;
+        int a, b;
+        int index;          // Entrée
+        double value;       // Constante
+        int depth;          // Plus long chemin vers une feuille (0 : entrée, constante)
+    };
+
+    std::vector<Node> nodes;
+    const std::vector<std::string>& variables;
+
+    int input(int index) {
+        auto it = inputNodes.find(index);
+        if (it != inputNodes.end()) return it->second;
+        nodes.push_back({Node::Input, Op::Add, -1, -1, index, 0.0, 0});
+        return inputNodes[index] = int(nodes.size() - 1);
+    }
+
+    int constant(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        auto it = constantNodes.find(bits);
+        if (it != constantNodes.end()) return it->second;
+        nodes.push_back({Node::Constant, Op::Add, -1, -1, -1, value, 0});
+        return constantNodes[bits] = int(nodes.size() - 1);
+    }
+
+    int depthOf(int a, int b) const {
+        return 1 + std::max(nodes[size_t(a)].depth, b >= 0 ? nodes[size_t(b)].depth : 0);
+    }
+
+    bool isConstant(int n, double value) const {
+        return nodes[size_t(n)].kind == Node::Constant && nodes[size_t(n)].value == value;
+    }
+
+    int apply(Op op, int a, int b = -1) {
+        const Node& na = nodes[size_t(a)];
+        const bool single = unary(op);
+        if (single) b = -1;
+        // Constantes calculées tout de suite
+        if (na.kind == Node::Constant && (single || nodes[size_t(b)].kind == Node::Constant)) {
+            return constant(compute(op, na.value, single ? 0.0 : nodes[size_t(b)].value));
+        }
+        switch (op) {
+        case Op::Add:
+            if (isConstant(a, 0.0)) return b;
+            if (isConstant(b, 0.0)) return a;
+            break;
+        case Op::Sub:
+            if (isConstant(b, 0.0)) return a;
+            if (isConstant(a, 0.0)) return apply(Op::Neg, b);
+            break;
+        case Op::Mul:
+            // 0 * x = 0 : x supposé fini (les dérivées nulles disparaissent)
+            if (isConstant(a, 0.0) || isConstant(b, 0.0)) return constant(0.0);
+            if (isConstant(a, 1.0)) return b;
+            if (isConstant(b, 1.0)) return a;
+            if (isConstant(a, -1.0)) return apply(Op::Neg, b);
+            if (isConstant(b, -1.0)) return apply(Op::Neg, a);
+            break;
+        case Op::Div:
+            if (isConstant(a, 0.0)) return constant(0.0);
+            if (isConstant(b, 1.0)) return a;
+            break;
+        case Op::Neg:
+            if (na.kind == Node::Apply && na.op == Op::Neg) return na.a;
+            break;
+        case Op::Pow:
+            if (nodes[size_t(b)].kind == Node::Constant) return power(a, nodes[size_t(b)].value);
+            break;
+        default:
+            break;
+        }
+        if (commutative(op) && b < a) std::swap(a, b);
+        auto key = std::make_tuple(int(op), a, b);
+        auto it = applyNodes.find(key);
+        if (it != applyNodes.end()) return it->second;
+        nodes.push_back({Node::Apply, op, a, b, -1, 0.0, depthOf(a, b)});
+        return applyNodes[key] = int(nodes.size() - 1);
+    }
+
+    // a^c : puissances entières développées en produits, 1/2 en racine
+    int power(int a, double c) {
+        if (c == 0.0) return constant(1.0);
+        if (c == 0.5) return apply(Op::Sqrt, a);
+        if (c == std::floor(c) && std::fabs(c) <= 4.0) {
+            int n = int(std::fabs(c));
+            int square = n >= 2 ? apply(Op::Mul, a, a) : a;
+            int r = n == 1 ? a : n == 2 ? square : n == 3 ? apply(Op::Mul, square, a) : apply(Op::Mul, square, square);
+            return c < 0.0 ? apply(Op::Div, constant(1.0), r) : r;
+        }
+        int b = constant(c);
+        auto key = std::make_tuple(int(Op::Pow), a, b);
+        auto it = applyNodes.find(key);
+        if (it != applyNodes.end()) return it->second;
+        nodes.push_back({Node::Apply, Op::Pow, a, b, -1, 0.0, depthOf(a, b)});
+        return applyNodes[key] = int(nodes.size() - 1);
+    }
+
+    // Dérivée du nœud n dans la direction des entrées seeds (seeds[i] : nœud
+    // de la direction de l'entrée i, -1 : entrée constante)
+    int derivative(int n, const std::vector<int>& seeds) {
+        auto it = derivatives.find(n);
+        if (it != derivatives.end()) return it->second;
+        const Node node = nodes[size_t(n)];     // Copie : apply() agrandit nodes
+        int d = constant(0.0);
+        if (node.kind == Node::Input) {
+            if (node.index < int(seeds.size()) && seeds[size_t(node.index)] >= 0) d = seeds[size_t(node.index)];
+        } else if (node.kind == Node::Apply) {
+            const int a = node.a, b = node.b;
+            const int da = derivative(a, seeds);
+            const int db = b >= 0 ? derivative(b, seeds) : constant(0.0);
+            auto mul = [&](int x, int y) { return apply(Op::Mul, x, y); };
+            auto add = [&](int x, int y) { return apply(Op::Add, x, y); };
+            auto sub = [&](int x, int y) { return apply(Op::Sub, x, y); };
+            auto div = [&](int x, int y) { return apply(Op::Div, x, y); };
+            const int one = constant(1.0);
+            switch (node.op) {
+            case Op::Add: d = add(da, db); break;
+            case Op::Sub: d = sub(da, db); break;
+            case Op::Mul: d = add(mul(da, b), mul(a, db)); break;
+            case Op::Div: d = div(sub(da, mul(n, db)), b); break;
+            case Op::Neg: d = apply(Op::Neg, da); break;
+            case Op::Pow:
+                // a^b (b - 1 évité : a^b * b / a) ; b constant : d(log a) seul
+                d = mul(n, add(mul(db, apply(Op::Log, a)), div(mul(b, da), a)));
+                break;
+            case Op::Min: d = add(mul(da, apply(Op::Step, sub(b, a))), mul(db, sub(one, apply(Op::Step, sub(b, a))))); break;
+            case Op::Max: d = add(mul(da, apply(Op::Step, sub(a, b))), mul(db, sub(one, apply(Op::Step, sub(a, b))))); break;
+            case Op::Sin: d = mul(apply(Op::Cos, a), da); break;
+            case Op::Cos: d = mul(apply(Op::Neg, apply(Op::Sin, a)), da); break;
+            case Op::Tan: d = mul(add(one, mul(n, n)), da); break;
+            case Op::Tanh: d = mul(sub(one, mul(n, n)), da); break;
+            case Op::Atan: d = div(da, add(one, mul(a, a))); break;
+            case Op::Exp: d = mul(n, da); break;
+            case Op::Log: d = div(da, a); break;
+            case Op::Sqrt: d = div(da, add(n, n)); break;
+            case Op::Abs: d = mul(apply(Op::Sign, a), da); break;
+            case Op::Floor: case Op::Sign: case Op::Step: break;    // Nulle presque partout
+            }
+        }
+        return derivatives[n] = d;
+    }
+
+    // Registres et instructions des sorties
+    bool emit(const std::vector<int>& outputs, int inputCount, ExpressionProgram& out, std::string& error) {
+        std::vector<int> lastUse(nodes.size(), -1);
+        std::vector<char> live(nodes.size(), 0);
+        for (int o : outputs) live[size_t(o)] = 1;
+        for (size_t i = nodes.size(); i-- > 0;) {
+            if (!live[i] || nodes[i].kind != Node::Apply) continue;
+            live[size_t(nodes[i].a)] = 1;
+            if (nodes[i].b >= 0) live[size_t(nodes[i].b)] = 1;
+        }
+        for (size_t i = 0; i < nodes.size(); i++) {
+            if (!live[i] || nodes[i].kind != Node::Apply) continue;
+            lastUse[size_t(nodes[i].a)] = int(i);
+            if (nodes[i].b >= 0) lastUse[size_t(nodes[i].b)] = int(i);
+        }
+        for (int o : outputs) lastUse[size_t(o)] = std::numeric_limits<int>::max();
+
+        static std::atomic<uint64_t> compilations{0};
+        out = ExpressionProgram();
+        out.id = ++compilations;
+        out.inputs = inputCount;
+        std::vector<int> reg(nodes.size(), -1);
+        for (size_t i = 0; i < nodes.size(); i++) {
+            if (!live[i]) continue;
+            if (nodes[i].kind == Node::Input) reg[i] = nodes[i].index;
+            else if (nodes[i].kind == Node::Constant) {
+                reg[i] = inputCount + int(out.constants.size());
+                out.constants.push_back(nodes[i].value);
+            }
+        }
+        int next = inputCount + int(out.constants.size());
+        std::vector<int> free;
+        for (size_t i = 0; i < nodes.size(); i++) {
+            const Node& node = nodes[i];
+            if (!live[i] || node.kind != Node::Apply) continue;
+            // Opérandes lus pour la dernière fois : leur registre peut recevoir
+            // le résultat (lecture et écriture du même élément)
+            for (int operand : {node.a, node.b}) {
+                if (operand < 0 || lastUse[size_t(operand)] != int(i) || nodes[size_t(operand)].kind != Node::Apply) continue;
+                if (std::find(free.begin(), free.end(), reg[size_t(operand)]) == free.end()) free.push_back(reg[size_t(operand)]);
+            }
+            if (!free.empty()) {
+                reg[i] = free.back();
+                free.pop_back();
+            } else {
+                reg[i] = next++;
+            }
+            if (next > 65535) {
+                error = "expressions trop longues";
+                return false;
+            }
+            const int ra = reg[size_t(node.a)];
+            out.code.push_back({node.op, uint16_t(reg[i]), uint16_t(ra), uint16_t(node.b >= 0 ? reg[size_t(node.b)] : ra)});
+        }
+        out.registers = next;
+        for (int o : outputs) out.outputs.push_back(uint16_t(reg[size_t(o)]));
+        return true;
+    }
+
+private:
+    std::map<int, int> inputNodes;
+    std::map<uint64_t, int> constantNodes;
+    std::map<std::tuple<int, int, int>, int> applyNodes;
+    std::map<int, int> derivatives;
+};
+
+namespace {
+    class Parser {
+    public:
+        Parser(const std::string& text, ExpressionCompiler& graph) : s(text), g(graph) {}
+
+        bool parse(int& out) {
+            if (!sum(out)) return false;
+            spaces();
+            if (at < s.size()) return fail(s[at] == ')' ? "')' sans '(' correspondante" : "opérateur attendu");
+            if (g.nodes[size_t(out)].depth > kMaxGraphDepth) {
+                at = 0;
+                return fail("imbrication trop profonde");
+            }
+            return true;
+        }
+
+        std::string error;
+
+    private:
+        bool fail(const std::string& message) {
+            if (error.empty()) error = "position " + std::to_string(at + 1) + " : " + message;
+            return false;
+        }
+
+        void spaces() {
+            while (at < s.size() && std::isspace((unsigned char)s[at])) at++;
+        }
+
+        bool accept(char c) {
+            spaces();
+            if (at < s.size() && s[at] == c) {
+                at++;
+                return true;
+            }
+            return false;
+        }
+
+        bool sum(int& out) {
+            if (!product(out)) return false;
+            for (;;) {
+                Op op;
+                if (accept('+')) op = Op::Add;
+                else if (accept('-')) op = Op::Sub;
+                else return true;
+                int rhs;
+                if (!product(rhs)) return false;
+                out = g.apply(op, out, rhs);
+            }
+        }
+
+        bool product(int& out) {
+            if (!unaryTerm(out)) return false;
+            for (;;) {
+                Op op;
+                if (accept('*')) op = Op::Mul;
+                else if (accept('/')) op = Op::Div;
+                else return true;
+                int rhs;
+                if (!unaryTerm(rhs)) return false;
+                out = g.apply(op, out, rhs);
+            }
+        }
+
+        // Toute récursion de l'analyse passe par ici
+        bool unaryTerm(int& out) {
+            if (nesting >= kMaxNesting) return fail("imbrication trop profonde");
+            nesting++;
+            bool ok;
+            if (accept('-')) {
+                ok = unaryTerm(out);
+                if (ok) out = g.apply(Op::Neg, out);
+            } else if (accept('+')) {
+                ok = unaryTerm(out);
+            } else {
+                ok = power(out);
+            }
+            nesting--;
+            return ok;
+        }
+
+        bool power(int& out) {
+            if (!primary(out)) return false;
+            if (!accept('^')) return true;
+            int exponent;
+            if (!unaryTerm(exponent)) return false;
+            out = g.apply(Op::Pow, out, exponent);
+            return true;
+        }
+
+        bool primary(int& out) {
+            spaces();
+            if (at >= s.size()) return fail("expression incomplète");
+            const char c = s[at];
+            if (c == '(') {
+                at++;
+                if (!sum(out)) return false;
+                if (!accept(')')) return fail("')' attendue");
+                return true;
+            }
+            if (std::isdigit((unsigned char)c) || c == '.') {
+                const char* begin = s.c_str() + at;
+                char* end = nullptr;
+                double v = std::strtod(begin, &end);
+                if (end == begin) return fail("nombre invalide");
+                at += size_t(end - begin);
+                out = g.constant(v);
+                return true;
+            }
+            if (!std::isalpha((unsigned char)c) && c != '_') return fail(std::string("caractère inattendu '") + c + "'");
+            const size_t begin = at;
+            while (at < s.size() && (std::isalnum((unsigned char)s[at]) || s[at] == '_')) at++;
+            const std::string name = s.substr(begin, at - begin);
+            spaces();
+            if (at < s.size() && s[at] == '(') return call(name, begin, out);
+            for (size_t i = 0; i < g.variables.size(); i++) {
+                if (g.variables[i] == name) {
+                    out = g.input(int(i));
+                    return true;
+                }
+            }
+            if (name == "pi") out = g.constant(kPi);
+            else if (name == "e") out = g.constant(std::exp(1.0));
+            else {
+                at = begin;
+                return fail("variable inconnue : " + name);
+            }
+            return true;
+        }
+
+        bool call(const std::string& name, size_t begin, int& out) {
+            const Function* f = nullptr;
+            for (const Function& candidate : kFunctions) {
+                if (name == candidate.name) f = &candidate;
+            }
+            if (!f) {
+                at = begin;
+                return fail("fonction inconnue : " + name);
+            }
+            at++;   // '('
+            int args[2] = {-1, -1};
+            int count = 0;
+            for (;;) {
+                int arg;
+                if (!sum(arg)) return false;
+                if (count < 2) args[count] = arg;
+                count++;
+                if (accept(',')) continue;
+                if (accept(')')) break;
+                return fail("',' ou ')' attendue");
+            }
+            if (count != f->arity) {
+                at = begin;
+                return fail(name + " attend " + std::to_string(f->arity) + " argument" + (f->arity > 1 ? "s" : ""));
+            }
+            out = g.apply(f->op, args[0], args[1]);
+            return true;
+        }
+
+        const std::string& s;
+        ExpressionCompiler& g;
+        size_t at = 0;
+        int nesting = 0;
+    };
+}
+
+bool compileExpressions(const std::vector<ExpressionSource>& sources, const std::vector<std::string>& variables,
+                        int tangentOf, ExpressionProgram& out, std::string& error) {
+    tangentOf = std::clamp(tangentOf, 0, int(variables.size()));
+    // Les entrées de direction suivent les variables et n'ont pas de nom :
+    // les expressions ne peuvent pas les lire
+    ExpressionCompiler graph(variables);
+    std::vector<int> values;
+    for (const ExpressionSource& source : sources) {
+        Parser parser(source.text, graph);
+        int node;
+        if (!parser.parse(node)) {
+            error = source.label + " : " + parser.error;
+            return false;
+        }
+        if (source.minus >= 0) node = graph.apply(Op::Sub, node, graph.input(source.minus));
+        values.push_back(node);
+    }
+    std::vector<int> outputs = values;
+    if (tangentOf > 0) {
+        std::vector<int> seeds(variables.size(), -1);
+        for (int i = 0; i < tangentOf; i++) seeds[size_t(i)] = graph.input(int(variables.size()) + i);
+        for (int v : values) outputs.push_back(graph.derivative(v, seeds));
+    }
+    return graph.emit(outputs, int(variables.size()) + tangentOf, out, error);
+}
+
+template <int Width, typename T>
+void ExpressionProgram::execute(T* r, int n) const {
+    const int width = Width > 0 ? Width : n;
+    const size_t lanes = size_t(width);
+    for (const Instruction& i : code) {
+        T* d = r + i.dst * lanes;
+        const T* a = r + i.a * lanes;
+        const T* b = r + i.b * lanes;
+        switch (i.op) {
+        case Op::Add: each<Op::Add>(d, a, b, width); break;
+        case Op::Sub: each<Op::Sub>(d, a, b, width); break;
+        case Op::Mul: each<Op::Mul>(d, a, b, width); break;
+        case Op::Div: each<Op::Div>(d, a, b, width); break;
+        case Op::Neg: each<Op::Neg>(d, a, b, width); break;
+        case Op::Pow: each<Op::Pow>(d, a, b, width); break;
+        case Op::Min: each<Op::Min>(d, a, b, width); break;
+        case Op::Max: each<Op::Max>(d, a, b, width); break;
+        case Op::Sin: each<Op::Sin>(d, a, b, width); break;
+        case Op::Cos: each<Op::Cos>(d, a, b, width); break;
+        case Op::Tan: each<Op::Tan>(d, a, b, width); break;
+        case Op::Tanh: each<Op::Tanh>(d, a, b, width); break;
+        case Op::Atan: each<Op::Atan>(d, a, b, width); break;
+        case Op::Exp: each<Op::Exp>(d, a, b, width); break;
+        case Op::Log: each<Op::Log>(d, a, b, width); break;
+        case Op::Sqrt: each<Op::Sqrt>(d, a, b, width); break;
+        case Op::Abs: each<Op::Abs>(d, a, b, width); break;
+        case Op::Floor: each<Op::Floor>(d, a, b, width); break;
+        case Op::Sign: each<Op::Sign>(d, a, b, width); break;
+        case Op::Step: each<Op::Step>(d, a, b, width); break;
+        }
+    }
+}
+
+template <typename T>
+void ExpressionProgram::run(const T* in, T* out, int n) const {
+    if constexpr (std::is_same_v<T, float>) {
+        if (nativeFloat) return nativeFloat(in, out, n);
+    } else {
+        if (nativeDouble) return nativeDouble(in, out, n);
+    }
+    // Registres du thread ; les constantes restent en place tant que le même
+    // programme est exécuté sur des lots de même largeur
+    thread_local std::vector<T> scratch;
+    thread_local uint64_t filledId = 0;
+    thread_local int filledWidth = 0;
+    const size_t lanes = size_t(n);
+    if (scratch.size() < size_t(registers) * lanes) {
+        scratch.resize(size_t(registers) * lanes);
+        filledId = 0;
+    }
+    T* r = scratch.data();
+    std::copy(in, in + size_t(inputs) * lanes, r);
+    if (filledId != id || filledWidth != n) {
+        for (size_t c = 0; c < constants.size(); c++) std::fill_n(r + (size_t(inputs) + c) * lanes, lanes, T(constants[c]));
+        filledId = id;
+        filledWidth = n;
+    }
+    // Largeurs des appels de Systems.h : un point, trois directions, un paquet
+    if (n == 1) execute<1>(r, n);
+    else if (n == 3) execute<3>(r, n);
+    else if (n == 8) execute<8>(r, n);
+    else execute<0>(r, n);
+    for (size_t j = 0; j < outputs.size(); j++) std::copy_n(r + outputs[j] * lanes, lanes, out + j * lanes);
+}
+
+template void ExpressionProgram::run<float>(const float*, float*, int) const;
+template void ExpressionProgram::run<double>(const double*, double*, int) const;
+
+std::string nativeSource(const std::vector<const ExpressionProgram*>& programs) {
+    // Mêmes définitions que compute() ; -ffp-contract=off côté compilation
+    std::string s =
+        "#include <cmath>\n"
+        "#include <limits>\n"
+        "\n"
+        "template <typename T> static inline T op_min(T a, T b) { return b < a ? b : a; }\n"
+        "template <typename T> static inline T op_max(T a, T b) { return a < b ? b : a; }\n"
+        "template <typename T> static inline T op_sign(T a) { return T((a > T(0)) - (a < T(0))); }\n"
+        "template <typename T> static inline T op_step(T a) { return a > T(0) ? T(1) : T(0); }\n";
+    char line[512];
+    for (size_t p = 0; p < programs.size(); p++) {
+        const ExpressionProgram& program = *programs[p];
+        std::snprintf(line, sizeof(line),
+                      "\ntemplate <typename T>\nstatic inline void kernel%zu(const T* __restrict in, T* __restrict out, int n) {\n"
+                      "    for (int l = 0; l < n; l++) {\n", p);
+        s += line;
+        // Nom courant de chaque registre : une variable par instruction
+        std::vector<std::string> name(size_t(program.registers));
+        for (int i = 0; i < program.inputs; i++) {
+            std::snprintf(line, sizeof(line), "        const T r%d = in[%d * n + l];\n", i, i);
+            s += line;
+            name[size_t(i)] = "r" + std::to_string(i);
+        }
+        for (size_t c = 0; c < program.constants.size(); c++) {
+            // Constantes exactes (%a) ; inf et nan n'ont pas d'écriture littérale
+            const double value = program.constants[c];
+            const char* sign = std::signbit(value) ? "-" : "";
+            if (std::isnan(value)) std::snprintf(line, sizeof(line), "T(%sstd::numeric_limits<T>::quiet_NaN())", sign);
+            else if (std::isinf(value)) std::snprintf(line, sizeof(line), "T(%sstd::numeric_limits<T>::infinity())", sign);
+            else std::snprintf(line, sizeof(line), "T(%a)", value);
+            name[size_t(program.inputs) + c] = line;
+        }
+        for (size_t i = 0; i < program.code.size(); i++) {
+            const ExpressionProgram::Instruction& in = program.code[i];
+            const std::string& a = name[in.a];
+            const std::string& b = name[in.b];
+            std::string e;
+            switch (in.op) {
+            case Op::Add: e = a + " + " + b; break;
+            case Op::Sub: e = a + " - " + b; break;
+            case Op::Mul: e = a + " * " + b; break;
+            case Op::Div: e = a + " / " + b; break;
+            case Op::Neg: e = "-" + a; break;
+            case Op::Pow: e = "std::pow(" + a + ", " + b + ")"; break;
+            case Op::Min: e = "op_min(" + a + ", " + b + ")"; break;
+            case Op::Max: e = "op_max(" + a + ", " + b + ")"; break;
+            case Op::Sin: e = "std::sin(" + a + ")"; break;
+            case Op::Cos: e = "std::cos(" + a + ")"; break;
+            case Op::Tan: e = "std::tan(" + a + ")"; break;
+            case Op::Tanh: e = "std::tanh(" + a + ")"; break;
+            case Op::Atan: e = "std::atan(" + a + ")"; break;
+            case Op::Exp: e = "std::exp(" + a + ")"; break;
+            case Op::Log: e = "std::log(" + a + ")"; break;
+            case Op::Sqrt: e = "std::sqrt(" + a + ")"; break;
+            case Op::Abs: e = "std::abs(" + a + ")"; break;
+            case Op::Floor: e = "std::floor(" + a + ")"; break;
+            case Op::Sign: e = "op_sign(" + a + ")"; break;
+            case Op::Step: e = "op_step(" + a + ")"; break;
+            }
+            const std::string v = "t" + std::to_string(i);
+            s += "        const T " + v + " = " + e + ";\n";
+            name[in.dst] = v;
+        }
+        for (size_t j = 0; j < program.outputs.size(); j++) {
+            std::snprintf(line, sizeof(line), "        out[%zu * n + l] = ", j);
+            s += line + name[program.outputs[j]] + ";\n";
+        }
+        s += "    }\n}\n";
+        std::snprintf(line, sizeof(line),
+                      "extern \"C\" void attracteur_kernel_%zu_f(const float* in, float* out, int n) { kernel%zu(in, out, n); }\n"
+                      "extern \"C\" void attracteur_kernel_%zu_d(const double* in, double* out, int n) { kernel%zu(in, out, n); }\n",
+                      p, p, p, p);
+        s += line;
+    }
+    return s;
+}
+/**
+ * Expression.cpp
+ *
+ * Contient l'analyse des expressions, le graphe simplifié (constantes,
+ * sous-expressions communes, dérivées), la machine virtuelle et la
+ * traduction des programmes en C++.
+ */
@@ -0,0 +1,206 @@
+#include "Jit.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+#ifndef ATTRACTEUR_JIT_DEFAULT_CXX
+#define ATTRACTEUR_JIT_DEFAULT_CXX "c++"
+#endif
+
+namespace {
+    // Pas de contraction en FMA : mêmes arrondis que la machine virtuelle
+    const char* const kFlags[] = {"-std=c++17", "-O3", "-march=native", "-ffp-contract=off", "-fPIC", "-shared"};
+
+    // FNV-1a 64 bits : nom de fichier, pas une somme de contrôle
+    uint64_t fnv1a(const std::string& text) {
+        uint64_t h = 14695981039346656037ull;
+        for (unsigned char c : text) {
+            h ^= c;
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    std::string environment(const char* name) {
+        const char* value = std::getenv(name);
+        return value ? value : "";
+    }
+
+    std::string readFile(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        std::ostringstream text;
+        text << in.rdbuf();
+        return text.str();
+    }
+
+    std::mutex mutex;   // Une compilation à la fois dans le processus
+}
+
+std::string jitCacheDirectory() {
+    std::string dir = environment("ATTRACTEUR_JIT_CACHE");
+    if (!dir.empty()) return dir;
+    std::string base = environment("XDG_CACHE_HOME");
+    if (base.empty() && !environment("HOME").empty()) base = environment("HOME") + "/.cache";
+    if (base.empty()) base = std::filesystem::temp_directory_path().string();
+    return base + "/attracteurs/jit";
+}
+
+#ifdef _WIN32
+
+JitResult compileNative(const std::vector<ExpressionProgram*>&) {
+    JitResult r;
+    r.error = "compilation native non prise en charge sous Windows";
+    return r;
+}
+
+#else
+
+namespace {
+    // Lance args[0] (cherché dans le PATH) sans passer par un shell : les
+    // chemins n'ont pas à être protégés. Sorties standard et d'erreur dans
+    // log ; code de sortie, -1 si le lancement échoue
+    int run(const std::vector<std::string>& args, const std::string& log) {
+        std::vector<char*> argv;
+        for (const std::string& a : args) argv.push_back(const_cast<char*>(a.c_str()));
+        argv.push_back(nullptr);
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+        pid_t pid;
+        const int spawned = posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+        posix_spawn_file_actions_destroy(&actions);
+        if (spawned != 0) return -1;
+        int status = 0;
+        while (waitpid(pid, &status, 0) < 0) {
+            if (errno != EINTR) return -1;
+        }
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    }
+
+    // Macros prédéfinies sous -march=native (__AVX2__, __znver3__...) : la
+    // cible effective entre dans la clé du cache, qu'un dossier personnel
+    // partagé (NFS) expose à des processeurs différents. Une fois par
+    // compilateur et par processus ; vide si le compilateur ne répond pas
+    std::string nativeTarget(const std::string& compiler, const std::string& scratch) {
+        static std::map<std::string, std::string> targets;
+        auto it = targets.find(compiler);
+        if (it != targets.end()) return it->second;
+        std::string target;
+        if (run({compiler, "-march=native", "-E", "-dM", "-x", "c++", "/dev/null"}, scratch) == 0) target = readFile(scratch);
+        std::error_code ec;
+        std::filesystem::remove(scratch, ec);
+        if (!target.empty()) targets[compiler] = target;
+        return target;
+    }
+}
+
+JitResult compileNative(const std::vector<ExpressionProgram*>& programs) {
+    std::lock_guard<std::mutex> lock(mutex);
+    using clock = std::chrono::steady_clock;
+    const auto t0 = clock::now();
+    JitResult r;
+
+    std::vector<const ExpressionProgram*> constPrograms(programs.begin(), programs.end());
+    const std::string source = nativeSource(constPrograms);
+    std::string compiler = environment("ATTRACTEUR_JIT_CXX");
+    if (compiler.empty()) compiler = ATTRACTEUR_JIT_DEFAULT_CXX;
+    const std::string dir = jitCacheDirectory();
+    const std::string tag = "." + std::to_string(getpid());
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    const std::string target = nativeTarget(compiler, dir + "/target" + tag + ".log");
+    if (target.empty()) {
+        r.error = compiler + " introuvable ou inutilisable";
+        return r;
+    }
+
+    std::vector<std::string> command = {compiler};
+    command.insert(command.end(), std::begin(kFlags), std::end(kFlags));
+    std::string signature = source;
+    for (const std::string& word : command) signature += "\n" + word;
+    char key[32];
+    std::snprintf(key, sizeof(key), "%016llx", (unsigned long long)fnv1a(signature + "\n" + target));
+    const std::string base = dir + "/kernel_" + key;
+    r.path = base + ".so";
+
+    r.cached = std::filesystem::exists(r.path, ec);
+    if (!r.cached) {
+        // Fichiers temporaires propres au processus, renommés une fois
+        // complets : deux sessions peuvent compiler le même noyau
+        const std::string src = base + ".cpp";
+        const std::string tmp = base + tag + ".tmp";
+        const std::string log = base + tag + ".log";
+        {
+            std::ofstream out(src + tag, std::ios::binary);
+            out << source;
+            if (!out) {
+                r.error = "écriture impossible dans " + dir;
+                return r;
+            }
+        }
+        std::filesystem::rename(src + tag, src, ec);
+        command.insert(command.end(), {"-o", tmp, src});
+        if (run(command, log) != 0) {
+            const std::string text = readFile(log);
+            r.error = "échec de " + compiler;
+            std::string first = text.substr(0, text.find('\n'));
+            if (!first.empty()) r.error += " : " + first;
+            std::filesystem::remove(tmp, ec);
+            std::filesystem::remove(log, ec);
+            return r;
+        }
+        std::filesystem::remove(log, ec);
+        std::filesystem::rename(tmp, r.path, ec);
+        if (ec) {
+            r.error = "impossible de placer " + r.path;
+            return r;
+        }
+    }
+
+    void* library = dlopen(r.path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!library) {
+        r.error = dlerror();
+        return r;
+    }
+    std::vector<std::pair<ExpressionProgram::FloatKernel, ExpressionProgram::DoubleKernel>> kernels;
+    for (size_t p = 0; p < programs.size(); p++) {
+        const std::string name = "attracteur_kernel_" + std::to_string(p);
+        auto f = reinterpret_cast<ExpressionProgram::FloatKernel>(dlsym(library, (name + "_f").c_str()));
+        auto d = reinterpret_cast<ExpressionProgram::DoubleKernel>(dlsym(library, (name + "_d").c_str()));
+        if (!f || !d) {
+            r.error = name + " absent de " + r.path;
+            return r;
+        }
+        kernels.emplace_back(f, d);
+    }
+    for (size_t p = 0; p < programs.size(); p++) programs[p]->attachNative(kernels[p].first, kernels[p].second);
+    r.ok = true;
+    r.seconds = std::chrono::duration<double>(clock::now() - t0).count();
+    return r;
+}
+
+#endif
+/**
+ * Jit.cpp
+ *
+ * Contient la génération, la compilation, la mise en cache et le chargement
+ * des noyaux natifs des systèmes personnalisés.
+ */
@@ -0,0 +1,269 @@
+#include "Json.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+    // Imbrication maximale : une ligne hostile ne doit pas épuiser la pile
+    constexpr int kMaxDepth = 64;
+
+    class Parser {
+    public:
+        explicit Parser(const std::string& text) : s(text) {}
+
+        bool document(Json& out) {
+            skip();
+            if (!value(out, 0)) return false;
+            skip();
+            return at == s.size() || fail("texte après la valeur");
+        }
+
+        std::string error;
+
+    private:
+        bool fail(const char* message) {
+            if (error.empty()) error = std::string(message) + " (caractère " + std::to_string(at) + ")";
+            return false;
+        }
+
+        void skip() {
+            while (at < s.size() && (s[at] == ' ' || s[at] == '\t' || s[at] == '\n' || s[at] == '\r')) at++;
+        }
+
+        bool literal(const char* word) {
+            size_t n = std::char_traits<char>::length(word);
+            if (s.compare(at, n, word) != 0) return fail("valeur inconnue");
+            at += n;
+            return true;
+        }
+
+        bool value(Json& out, int depth) {
+            if (depth > kMaxDepth) return fail("imbrication trop profonde");
+            if (at >= s.size()) return fail("valeur attendue");
+            char c = s[at];
+            if (c == '{') return object(out, depth);
+            if (c == '[') return array(out, depth);
+            if (c == '"') {
+                out = Json("");
+                return string(out.text);
+            }
+            if (c == 't') { out = Json(true); return literal("true"); }
+            if (c == 'f') { out = Json(false); return literal("false"); }
+            if (c == 'n') { out = Json(); return literal("null"); }
+            return number(out);
+        }
+
+        bool object(Json& out, int depth) {
+            out = Json::object();
+            at++;
+            skip();
+            if (at < s.size() && s[at] == '}') { at++; return true; }
+            for (;;) {
+                skip();
+                std::string key;
+                if (at >= s.size() || s[at] != '"') return fail("clé attendue");
+                if (!string(key)) return false;
+                skip();
+                if (at >= s.size() || s[at] != ':') return fail("':' attendu");
+                at++;
+                skip();
+                Json member;
+                if (!value(member, depth + 1)) return false;
+                out.set(key, std::move(member));
+                skip();
+                if (at < s.size() && s[at] == ',') { at++; continue; }
+                if (at < s.size() && s[at] == '}') { at++; return true; }
+                return fail("',' ou '}' attendu");
+            }
+        }
+
+        bool array(Json& out, int depth) {
+            out = Json::array();
+            at++;
+            skip();
+            if (at < s.size() && s[at] == ']') { at++; return true; }
+            for (;;) {
+                skip();
+                Json item;
+                if (!value(item, depth + 1)) return false;
+                out.items.push_back(std::move(item));
+                skip();
+                if (at < s.size() && s[at] == ',') { at++; continue; }
+                if (at < s.size() && s[at] == ']') { at++; return true; }
+                return fail("',' ou ']' attendu");
+            }
+        }
+
+        bool hex4(unsigned& code) {
+            if (at + 4 > s.size()) return fail("\\u incomplet");
+            code = 0;
+            for (int i = 0; i < 4; i++) {
+                char c = s[at++];
+                code <<= 4;
+                if (c >= '0' && c <= '9') code |= unsigned(c - '0');
+                else if (c >= 'a' && c <= 'f') code |= unsigned(c - 'a' + 10);
+                else if (c >= 'A' && c <= 'F') code |= unsigned(c - 'A' + 10);
+                else return fail("\\u invalide");
+            }
+            return true;
+        }
+
+        static void utf8(unsigned code, std::string& out) {
+            if (code < 0x80) {
+                out += char(code);
+            } else if (code < 0x800) {
+                out += char(0xC0 | code >> 6);
+                out += char(0x80 | (code & 0x3F));
+            } else if (code < 0x10000) {
+                out += char(0xE0 | code >> 12);
+                out += char(0x80 | (code >> 6 & 0x3F));
+                out += char(0x80 | (code & 0x3F));
+            } else {
+                out += char(0xF0 | code >> 18);
+                out += char(0x80 | (code >> 12 & 0x3F));
+                out += char(0x80 | (code >> 6 & 0x3F));
+                out += char(0x80 | (code & 0x3F));
+            }
+        }
+
+        bool string(std::string& out) {
+            at++;
+            for (;;) {
+                if (at >= s.size()) return fail("chaîne non terminée");
+                char c = s[at++];
+                if (c == '"') return true;
+                if ((unsigned char)c < 0x20) return fail("caractère de contrôle dans une chaîne");
+                if (c != '\\') { out += c; continue; }
+                if (at >= s.size()) return fail("chaîne non terminée");
+                c = s[at++];
+                switch (c) {
+                case '"': case '\\': case '/': out += c; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    unsigned code;
+                    if (!hex4(code)) return false;
+                    // Paire de substitution UTF-16
+                    if (code >= 0xD800 && code < 0xDC00 && s.compare(at, 2, "\\u") == 0) {
+                        at += 2;
+                        unsigned low;
+                        if (!hex4(low)) return false;
+                        if (low < 0xDC00 || low >= 0xE000) return fail("paire de substitution invalide");
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    utf8(code, out);
+                    break;
+                }
+                default: return fail("échappement inconnu");
+                }
+            }
+        }
+
+        bool number(Json& out) {
+            const char* begin = s.c_str() + at;
+            // Grammaire JSON : pas de '+', de zéros en tête, de ".5" ni de "inf"
+            size_t i = at;
+            if (i < s.size() && s[i] == '-') i++;
+            if (i >= s.size() || s[i] < '0' || s[i] > '9') return fail("valeur attendue");
+            if (s[i] == '0' && i + 1 < s.size() && s[i + 1] >= '0' && s[i + 1] <= '9') return fail("zéro en tête");
+            char* end = nullptr;
+            double v = std::strtod(begin, &end);
+            if (end == begin) return fail("nombre invalide");
+            at += size_t(end - begin);
+            out = Json(v);
+            return true;
+        }
+
+        const std::string& s;
+        size_t at = 0;
+    };
+
+    void write(const Json& v, std::string& out) {
+        switch (v.kind) {
+        case Json::Kind::Null: out += "null"; break;
+        case Json::Kind::Bool: out += v.boolean ? "true" : "false"; break;
+        case Json::Kind::Number: {
+            if (!std::isfinite(v.number)) { out += "null"; break; }
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.9g", v.number);
+            out += buffer;
+            break;
+        }
+        case Json::Kind::String:
+            out += '"';
+            for (char c : v.text) {
+                if (c == '"' || c == '\\') { out += '\\'; out += c; }
+                else if (c == '\n') out += "\\n";
+                else if ((unsigned char)c < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", unsigned(c));
+                    out += buffer;
+                } else out += c;
+            }
+            out += '"';
+            break;
+        case Json::Kind::Array:
+            out += '[';
+            for (size_t i = 0; i < v.items.size(); i++) {
+                if (i) out += ',';
+                write(v.items[i], out);
+            }
+            out += ']';
+            break;
+        case Json::Kind::Object:
+            out += '{';
+            for (size_t i = 0; i < v.members.size(); i++) {
+                if (i) out += ',';
+                write(Json(v.members[i].first), out);
+                out += ':';
+                write(v.members[i].second, out);
+            }
+            out += '}';
+            break;
+        }
+    }
+}
+
+const Json* Json::find(const std::string& key) const {
+    if (kind != Kind::Object) return nullptr;
+    for (const auto& m : members) {
+        if (m.first == key) return &m.second;
+    }
+    return nullptr;
+}
+
+Json& Json::set(const std::string& key, Json value) {
+    if (kind != Kind::Object) *this = object();
+    for (auto& m : members) {
+        if (m.first == key) return m.second = std::move(value);
+    }
+    members.emplace_back(key, std::move(value));
+    return members.back().second;
+}
+
+Json& Json::push(Json value) {
+    if (kind != Kind::Array) *this = array();
+    items.push_back(std::move(value));
+    return items.back();
+}
+
+bool parseJson(const std::string& text, Json& out, std::string& error) {
+    Parser parser(text);
+    if (parser.document(out)) return true;
+    error = parser.error;
+    return false;
+}
+
+std::string toJson(const Json& value) {
+    std::string out;
+    write(value, out);
+    return out;
+}
+/**
+ * Json.cpp
+ *
+ * Contient l'analyse récursive du JSON (profondeur bornée) et son écriture.
+ */
@@ -0,0 +1,238 @@
+#include "LiveFeed.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char kMagic[8] = {'A', 'T', 'R', 'L', 'I', 'V', 'E', '\0'};
+
+    uint64_t processId() {
+#ifdef _WIN32
+        return uint64_t(GetCurrentProcessId());
+#else
+        return uint64_t(getpid());
+#endif
+    }
+}
+
+SharedMemory::~SharedMemory() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool SharedMemory::open(const std::string& name, bool create, uint64_t size) {
+    close();
+    if (create) {
+        // L'objet disparaît avec le dernier handle : rien à retirer ensuite
+        mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, DWORD(size >> 32), DWORD(size),
+                                     name.c_str());
+    } else {
+        mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, name.c_str());
+    }
+    if (!mapping) return false;
+    base = static_cast<uint8_t*>(MapViewOfFile(mapping, create ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0));
+    if (!base) { close(); return false; }
+    MEMORY_BASIC_INFORMATION info;
+    length = VirtualQuery(base, &info, sizeof(info)) ? uint64_t(info.RegionSize) : 0;
+    if (create) length = size;
+    return true;
+}
+
+void SharedMemory::close() {
+    if (base) UnmapViewOfFile(base);
+    if (mapping) CloseHandle(mapping);
+    base = nullptr;
+    mapping = nullptr;
+    length = 0;
+}
+
+#else
+
+bool SharedMemory::open(const std::string& name, bool create, uint64_t size) {
+    close();
+    int fd;
+    if (create) {
+        // Un objet laissé par une instance arrêtée brutalement est remplacé ;
+        // ses lecteurs gardent l'ancienne projection
+        shm_unlink(name.c_str());
+        fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+        if (fd < 0) return false;
+        if (ftruncate(fd, off_t(size)) != 0) {
+            ::close(fd);
+            shm_unlink(name.c_str());
+            return false;
+        }
+    } else {
+        fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) { ::close(fd); return false; }
+        size = uint64_t(st.st_size);
+    }
+    void* p = size ? mmap(nullptr, size_t(size), create ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0)
+                   : MAP_FAILED;
+    ::close(fd);        // La projection garde l'objet ouvert
+    if (p == MAP_FAILED) {
+        if (create) shm_unlink(name.c_str());
+        return false;
+    }
+    base = static_cast<uint8_t*>(p);
+    length = size;
+    if (create) owned = name;
+    return true;
+}
+
+void SharedMemory::close() {
+    if (base) munmap(base, size_t(length));
+    if (!owned.empty()) shm_unlink(owned.c_str());
+    owned.clear();
+    base = nullptr;
+    length = 0;
+}
+
+#endif
+
+bool LiveFeedWriter::open(const std::string& name, uint32_t states) {
+    close();
+    capacity = std::max(states, 1u);
+    if (!memory.open(name, true, uint64_t(kLiveHeaderBytes) + uint64_t(capacity) * sizeof(Point))) return false;
+    feedName = name;
+    // Mémoire neuve, à zéro : compteurs et résumé partent de 0
+    LiveHeader* h = new (memory.data()) LiveHeader();
+    std::memcpy(h->magic, kMagic, sizeof(kMagic));
+    h->version = kLiveVersion;
+    h->headerBytes = kLiveHeaderBytes;
+    h->capacity = capacity;
+    h->stateBytes = sizeof(Point);
+    h->writerPid = processId();
+    ring = reinterpret_cast<Point*>(memory.data() + kLiveHeaderBytes);
+    written = 0;
+    restart();
+    return true;
+}
+
+void LiveFeedWriter::publish(const Point* states, size_t count, const LiveSnapshot& description) {
+    if (!isOpen() || count == 0) return;
+    LiveHeader* h = header();
+
+    // Par tranches d'au plus un tour d'anneau : reserve ne dépasse jamais
+    // head de plus de capacity
+    for (size_t done = 0; done < count;) {
+        const size_t n = std::min<size_t>(count - done, capacity);
+        h->reserve.store(written + n, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < n; i++) {
+            const Point& p = states[done + i];
+            ring[(written + i) % capacity] = p;
+            if (stats.samples == 0) {
+                stats.min = stats.max = p;
+                sum[0] = sum[1] = sum[2] = 0.0;
+            }
+            stats.samples++;
+            sum[0] += p.x; sum[1] += p.y; sum[2] += p.z;
+            stats.min = {std::min(stats.min.x, p.x), std::min(stats.min.y, p.y), std::min(stats.min.z, p.z)};
+            stats.max = {std::max(stats.max.x, p.x), std::max(stats.max.y, p.y), std::max(stats.max.z, p.z)};
+        }
+        written += n;
+        done += n;
+        h->head.store(written, std::memory_order_release);
+    }
+
+    LiveSnapshot s = description;
+    s.head = written;
+    s.current = states[count - 1];
+    s.samples = stats.samples;
+    const double inv = 1.0 / double(stats.samples);
+    s.mean = {float(sum[0] * inv), float(sum[1] * inv), float(sum[2] * inv)};
+    s.min = stats.min;
+    s.max = stats.max;
+
+    // Verrou de séquence : impair pendant la copie, les lecteurs recommencent
+    const uint64_t seq = h->sequence.load(std::memory_order_relaxed);
+    h->sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&h->snapshot, &s, sizeof(s));
+    h->sequence.store(seq + 2, std::memory_order_release);
+}
+
+bool LiveFeedReader::open(const std::string& name) {
+    close();
+    if (!memory.open(name, false)) {
+        lastError = "aucun flux " + name + " (application lancée avec --live ?)";
+        return false;
+    }
+    const LiveHeader* h = header();
+    if (memory.size() < kLiveHeaderBytes || std::memcmp(h->magic, kMagic, sizeof(kMagic)) != 0) {
+        lastError = name + " n'est pas un flux d'attracteurs";
+    } else if (h->version != kLiveVersion || h->stateBytes != sizeof(Point)) {
+        lastError = name + " : version " + std::to_string(h->version) + " non prise en charge";
+    } else if (memory.size() < uint64_t(h->headerBytes) + uint64_t(h->capacity) * sizeof(Point) || !h->capacity) {
+        lastError = name + " : anneau tronqué";
+    } else {
+        ring = reinterpret_cast<const Point*>(memory.data() + h->headerBytes);
+        lastError.clear();
+        return true;
+    }
+    close();
+    return false;
+}
+
+size_t LiveFeedReader::read(uint64_t& next, Point* out, size_t max, uint64_t& lost) const {
+    const LiveHeader* h = header();
+    const uint64_t cap = h->capacity;
+    const uint64_t head = h->head.load(std::memory_order_acquire);
+    if (next > head) next = head;                  // Écrivain relancé sous le même nom
+    if (head - next > cap) {
+        lost += head - cap - next;
+        next = head - cap;
+    }
+    size_t n = size_t(std::min<uint64_t>(head - next, max));
+    // Deux morceaux au plus : jusqu'à la fin de l'anneau, puis depuis le début
+    const size_t at = size_t(next % cap);
+    const size_t first = std::min<size_t>(n, size_t(cap) - at);
+    std::memcpy(out, ring + at, first * sizeof(Point));
+    std::memcpy(out + first, ring, (n - first) * sizeof(Point));
+
+    // Cases réécrites pendant la copie : celles des états < reserve - capacity
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t reserve = h->reserve.load(std::memory_order_relaxed);
+    if (reserve > cap && next < reserve - cap) {
+        const size_t torn = size_t(std::min<uint64_t>(reserve - cap - next, n));
+        std::memmove(out, out + torn, (n - torn) * sizeof(Point));
+        n -= torn;
+        lost += torn;
+        next += torn;
+    }
+    next += n;
+    return n;
+}
+
+bool LiveFeedReader::snapshot(LiveSnapshot& out, int spins) const {
+    const LiveHeader* h = header();
+    for (int i = 0; i < spins; i++) {
+        const uint64_t before = h->sequence.load(std::memory_order_acquire);
+        if (before & 1) continue;
+        std::memcpy(&out, &h->snapshot, sizeof(out));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (h->sequence.load(std::memory_order_relaxed) == before) return true;
+    }
+    return false;
+}
+/**
+ * LiveFeed.cpp
+ *
+ * Contient la mémoire partagée nommée (POSIX et Windows), l'écriture de
+ * l'anneau et du résumé par l'application et leur lecture cohérente.
+ */
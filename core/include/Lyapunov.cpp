@@ -0,0 +1,188 @@
+#include "Lyapunov.h"
+#include <algorithm>
+#include <cmath>
+#include "Utils.h"
+
+namespace {
+    constexpr size_t kHistoryMax = 1000;
+    // Sous-pas RK4 des vecteurs tangents des intégrateurs Exact et Taylor
+    constexpr double kTangentStep = 0.01;
+
+    // Q <- M Q, M dérivée d'un pas de longueur dt partant de p, par nombres
+    // duaux à travers stepRK4 : celle du pas lui-même en RK4 ; Exact et
+    // Taylor suivent le flot à l'arrondi près, M est alors celle du flot, par
+    // sous-pas d'au plus kTangentStep
+    template <int Type, typename P>
+    void propagateTangents(Integrator integrator, const P* k, const Vec3<double>& p, double dt, int dim,
+                           int count, double (&Q)[3][3]) {
+        using D = Dual<double, 3>;
+        Vec3<D> q{D(p.x), D(p.y), D(p.z)};
+        for (int c = 0; c < 3; c++) {
+            q.x.d[c] = Q[0][c];
+            q.y.d[c] = Q[1][c];
+            q.z.d[c] = Q[2][c];
+        }
+        const int substeps = integrator == Integrator::RK4 ? 1 : std::max(1, int(std::ceil(dt / kTangentStep)));
+        const D h(dt / substeps);
+        for (int i = 0; i < substeps; i++) stepRK4<Type>(k, q, h);
+        for (int c = 0; c < count; c++) {
+            Q[0][c] = q.x.d[c];
+            Q[1][c] = q.y.d[c];
+            if (dim == 3) Q[2][c] = q.z.d[c];
+        }
+    }
+
+    template <int Type, typename T>
+    LyapunovResult benettin(const Attractor& source, const LyapunovSettings& s,
+                            const std::function<bool(const LyapunovResult&)>& onBatch) {
+        Utils::FlushDenormals ftz;
+        const SystemInfo& sys = Attractor::info(Type);
+        const int dim = sys.dim;
+        const int count = sys.isMap ? 1 : dim;
+        const T dt = sys.isMap ? T(1) : T(source.dt);   // Une itération = un pas
+        const Integrator integrator = sys.isMap ? Integrator::Euler : source.integrator;
+        const int order = source.taylorOrder;
+        T k[kMaxParams];
+        std::copy(source.params, source.params + kMaxParams, k);
+
+        LyapunovResult r;
+        r.type = Type;
+        r.count = count;
+        r.isMap = sys.isMap;
+
+        Vec3<T> p = vecCast<T>(source.p);
+        for (long i = 0; i < s.transient; i++) advance<Type>(integrator, k, p, dt, order);
+
+        // Vecteurs tangents en colonnes de Q
+        double Q[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+        double sums[3] = {0.0, 0.0, 0.0};
+        long measured = 0;     // Pas couverts par les sommes de log
+        long batches = 0;
+        long stride = 1;       // Un point d'historique tous les stride lots
+
+        while (r.steps < s.maxSteps) {
+            for (long b = 0; b < s.batch; b++) {
+                if (integrator == Integrator::Euler) {
+                    // Q <- (I + dt J) Q : jacobienne exacte du pas d'Euler, J Q
+                    // obtenu en dérivant le champ le long des colonnes de Q
+                    Vec3<double> jq[3];
+                    for (int c = 0; c < 3; c++) jq[c] = {Q[0][c], Q[1][c], Q[2][c]};
+                    tangents<Type>(k, vecCast<double>(p), jq);
+                    step<Type>(k, p, dt);
+                    for (int c = 0; c < count; c++) {
+                        Q[0][c] += dt * jq[c].x;
+                        Q[1][c] += dt * jq[c].y;
+                        if (dim == 3) Q[2][c] += dt * jq[c].z;
+                    }
+                } else {
+                    propagateTangents<Type>(integrator, k, vecCast<double>(p), double(dt), dim, count, Q);
+                    advance<Type>(integrator, k, p, dt, order);
+                }
+                r.steps++;
+
+                if (r.steps % s.orthoInterval == 0) {
+                    // Gram-Schmidt modifié ; les normes sont la diagonale de R
+                    for (int c = 0; c < count; c++) {
+                        for (int prev = 0; prev < c; prev++) {
+                            double dot = 0.0;
+                            for (int i = 0; i < dim; i++) dot += Q[i][c] * Q[i][prev];
+                            for (int i = 0; i < dim; i++) Q[i][c] -= dot * Q[i][prev];
+                        }
+                        double norm = 0.0;
+                        for (int i = 0; i < dim; i++) norm += Q[i][c] * Q[i][c];
+                        norm = std::sqrt(norm);
+                        sums[c] += std::log(norm);
+                        for (int i = 0; i < dim; i++) Q[i][c] /= norm;
+                    }
+                    measured = r.steps;
+                }
+            }
+
+            if (!std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z)) {
+                r.diverged = true;
+                break;
+            }
+            for (int c = 0; c < count; c++) r.exponents[c] = sums[c] / (double(measured) * dt);
+
+            if (batches++ % stride == 0) {
+                for (int c = 0; c < count; c++) r.history[c].push_back(float(r.exponents[c]));
+                if (r.history[0].size() >= kHistoryMax) {
+                    // On garde un point sur deux et on espace les suivants
+                    for (int c = 0; c < count; c++) {
+                        std::vector<float>& h = r.history[c];
+                        for (size_t i = 0; i < h.size() / 2; i++) h[i] = h[2 * i];
+                        h.resize(h.size() / 2);
+                    }
+                    stride *= 2;
+                }
+            }
+            if (onBatch && !onBatch(r)) return r;
+        }
+        r.finished = true;
+        return r;
+    }
+}
+
+double kaplanYorkeDimension(const LyapunovResult& result) {
+    if (result.isMap || result.count == 0) return 0.0;
+    double partial = 0.0;
+    for (int j = 0; j < result.count; j++) {
+        if (partial + result.exponents[j] < 0.0) {
+            return j + partial / std::fabs(result.exponents[j]);
+        }
+        partial += result.exponents[j];
+    }
+    return result.count;
+}
+
+LyapunovResult estimateLyapunov(const Attractor& source, const LyapunovSettings& settings,
+                                const std::function<bool(const LyapunovResult&)>& onBatch) {
+    return dispatchPrecision(source.precision, [&](auto scalar) {
+        return dispatchSystem(source.type, [&](auto tag) {
+            return benettin<decltype(tag)::value, decltype(scalar)>(source, settings, onBatch);
+        });
+    });
+}
+
+LyapunovEstimator::~LyapunovEstimator() {
+    stop();
+}
+
+void LyapunovEstimator::start(const Attractor& source) {
+    stop();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        latest = LyapunovResult();
+        latest.type = source.type;
+    }
+    stopRequested = false;
+    running = true;
+    worker = std::thread([this, source, s = settings] {
+        LyapunovResult last = estimateLyapunov(source, s, [this](const LyapunovResult& r) {
+            std::lock_guard<std::mutex> lock(mutex);
+            latest = r;
+            return !stopRequested.load();
+        });
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            latest = last;
+        }
+        running = false;
+    });
+}
+
+void LyapunovEstimator::stop() {
+    stopRequested = true;
+    if (worker.joinable()) worker.join();
+    running = false;
+}
+
+LyapunovResult LyapunovEstimator::result() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return latest;
+}
+/**
+ * Lyapunov.cpp
+ *
+ * Contient l'implémentation de la méthode de Benettin et du thread d'estimation.
+ */
@@ -0,0 +1,203 @@
+#include "MappedFile.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::openRead(const std::string& path) {
+    close();
+    handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                         FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) { handle = kInvalid; return false; }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size)) { close(); return false; }
+    writable = false;
+    length = uint64_t(size.QuadPart);
+    if (!map()) { close(); return false; }
+    return true;
+}
+
+bool MappedFile::create(const std::string& path) {
+    close();
+    handle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                         FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) { handle = kInvalid; return false; }
+    writable = true;
+    length = 0;
+    return true;
+}
+
+bool MappedFile::resize(uint64_t size) {
+    if (!writable) return false;
+    unmap();
+    LARGE_INTEGER pos;
+    pos.QuadPart = LONGLONG(size);
+    if (!SetFilePointerEx(handle, pos, nullptr, FILE_BEGIN) || !SetEndOfFile(handle)) return false;
+    length = size;
+    return map();
+}
+
+bool MappedFile::map() {
+    if (length == 0) return true;
+    DWORD protect = writable ? PAGE_READWRITE : PAGE_READONLY;
+    mapping = CreateFileMappingA(handle, nullptr, protect, DWORD(length >> 32), DWORD(length), nullptr);
+    if (!mapping) return false;
+    base = static_cast<uint8_t*>(MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0));
+    return base != nullptr;
+}
+
+void MappedFile::unmap() {
+    if (base) UnmapViewOfFile(base);
+    if (mapping) CloseHandle(mapping);
+    base = nullptr;
+    mapping = nullptr;
+}
+
+void MappedFile::flush(uint64_t offset, uint64_t bytes) {
+    if (base && writable) FlushViewOfFile(base + offset, SIZE_T(bytes));
+}
+
+bool MappedFile::readAt(uint64_t offset, void* out, size_t bytes) const {
+    OVERLAPPED at = {};
+    at.Offset = DWORD(offset);
+    at.OffsetHigh = DWORD(offset >> 32);
+    DWORD got = 0;
+    return ReadFile(handle, out, DWORD(bytes), &got, &at) && got == bytes;
+}
+
+// Pas d'équivalent simple à madvise sur les versions de Windows visées : le
+// système pagine à la demande
+void MappedFile::adviseRandom() {}
+void MappedFile::prefetch(uint64_t, uint64_t) {}
+void MappedFile::release(uint64_t, uint64_t) {}
+
+void MappedFile::close() {
+    unmap();
+    if (handle != kInvalid) CloseHandle(handle);
+    handle = kInvalid;
+    writable = false;
+    length = 0;
+}
+
+#else
+
+bool MappedFile::openRead(const std::string& path) {
+    close();
+    handle = ::open(path.c_str(), O_RDONLY);
+    if (handle < 0) { handle = kInvalid; return false; }
+    struct stat st;
+    if (fstat(handle, &st) != 0) { close(); return false; }
+    writable = false;
+    length = uint64_t(st.st_size);
+    if (!map()) { close(); return false; }
+    return true;
+}
+
+bool MappedFile::create(const std::string& path) {
+    close();
+    handle = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (handle < 0) { handle = kInvalid; return false; }
+    writable = true;
+    length = 0;
+    return true;
+}
+
+bool MappedFile::resize(uint64_t size) {
+    if (!writable) return false;
+    unmap();
+#ifdef __linux__
+    // Réserve réellement les blocs (ftruncate seul crée un fichier creux)
+    if (size > length && posix_fallocate(handle, off_t(length), off_t(size - length)) != 0) {
+        map();
+        return false;
+    }
+#endif
+    if (ftruncate(handle, off_t(size)) != 0) { map(); return false; }
+    length = size;
+    return map();
+}
+
+bool MappedFile::map() {
+    if (length == 0) return true;
+    int prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* p = mmap(nullptr, size_t(length), prot, MAP_SHARED, handle, 0);
+    if (p == MAP_FAILED) return false;
+    base = static_cast<uint8_t*>(p);
+    return true;
+}
+
+void MappedFile::unmap() {
+    if (base) munmap(base, size_t(length));
+    base = nullptr;
+}
+
+void MappedFile::flush(uint64_t offset, uint64_t bytes) {
+    if (!base || !writable) return;
+    // msync exige une adresse alignée sur une page
+    uint64_t page = uint64_t(sysconf(_SC_PAGESIZE));
+    uint64_t start = offset / page * page;
+    msync(base + start, size_t(offset + bytes - start), MS_ASYNC);
+}
+
+bool MappedFile::readAt(uint64_t offset, void* out, size_t bytes) const {
+    return pread(handle, out, bytes, off_t(offset)) == ssize_t(bytes);
+}
+
+namespace {
+    // madvise exige une adresse alignée sur une page
+    void advise(uint8_t* base, uint64_t length, uint64_t offset, uint64_t bytes, int advice) {
+        if (!base || offset >= length) return;
+        uint64_t page = uint64_t(sysconf(_SC_PAGESIZE));
+        uint64_t start = offset / page * page;
+        uint64_t end = std::min(offset + bytes, length);
+        madvise(base + start, size_t(end - start), advice);
+    }
+}
+
+void MappedFile::adviseRandom() {
+    if (base) madvise(base, size_t(length), MADV_RANDOM);
+}
+
+void MappedFile::prefetch(uint64_t offset, uint64_t bytes) {
+    advise(base, length, offset, bytes, MADV_WILLNEED);
+}
+
+void MappedFile::release(uint64_t offset, uint64_t bytes) {
+    // Projection partagée en lecture seule : les pages sont simplement
+    // relues depuis le fichier si on y revient
+    if (!writable) advise(base, length, offset, bytes, MADV_DONTNEED);
+}
+
+void MappedFile::close() {
+    unmap();
+    if (handle != kInvalid) ::close(handle);
+    handle = kInvalid;
+    writable = false;
+    length = 0;
+}
+
+#endif
+
+void MappedFile::close(uint64_t finalSize) {
+    if (writable && finalSize != length) resize(finalSize);
+    close();
+}
+/**
+ * MappedFile.cpp
+ *
+ * Contient les projections POSIX (mmap) et Windows (MapViewOfFile).
+ */
@@ -0,0 +1,49 @@
+#include "Npy.h"
+#include <string>
+
+namespace {
+    size_t scalarSize(NpyType type) {
+        return type == NpyType::Float64 || type == NpyType::UInt64 ? 8 : 4;
+    }
+}
+
+bool writeNpyHeader(FILE* f, NpyType type, std::initializer_list<uint64_t> shape, bool fortranOrder) {
+    const char* descr[] = {"<f4", "<f8", "<u4", "<u8"};
+    std::string dict = "{'descr': '";
+    dict += descr[int(type)];
+    dict += "', 'fortran_order': ";
+    dict += fortranOrder ? "True" : "False";
+    dict += ", 'shape': (";
+    for (uint64_t n : shape) dict += std::to_string(n) + ", ";
+    // Un tuple Python d'un élément garde sa virgule : (n,)
+    if (shape.size() > 1) dict.resize(dict.size() - 2);
+    else if (shape.size() == 1) dict.pop_back();
+    dict += "), }";
+
+    // Magie (6) + version (2) + longueur (2) + dictionnaire terminé par '\n',
+    // le tout aligné sur 64 octets pour que les données le soient aussi
+    size_t total = (10 + dict.size() + 1 + 63) / 64 * 64;
+    dict.append(total - 10 - dict.size() - 1, ' ');
+    dict += '\n';
+    if (dict.size() > 0xFFFF) return false;
+
+    unsigned char prefix[10] = {0x93, 'N', 'U', 'M', 'P', 'Y', 1, 0,
+                                (unsigned char)(dict.size() & 0xFF), (unsigned char)(dict.size() >> 8)};
+    return std::fwrite(prefix, 1, sizeof(prefix), f) == sizeof(prefix)
+        && std::fwrite(dict.data(), 1, dict.size(), f) == dict.size();
+}
+
+bool writeNpy(const std::string& path, NpyType type, std::initializer_list<uint64_t> shape, const void* data) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    uint64_t count = 1;
+    for (uint64_t n : shape) count *= n;
+    bool ok = writeNpyHeader(f, type, shape);
+    if (ok && count > 0) ok = std::fwrite(data, scalarSize(type), size_t(count), f) == count;
+    return std::fclose(f) == 0 && ok;
+}
+/**
+ * Npy.cpp
+ *
+ * Contient la mise en forme de l'en-tête .npy et l'écriture des tableaux.
+ */
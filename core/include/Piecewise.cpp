@@ -0,0 +1,293 @@
+#include "Piecewise.h"
+#include <cmath>
+#include <cstring>
+
+namespace {
+    constexpr int kOrder = 14;          // Série de Taylor de l'exponentielle
+    constexpr int kMaxCrossings = 8;    // Par pas : au-delà, glissement sur une surface
+    constexpr int kSamples = 8;         // Échantillons par pas (aller-retour au-delà d'une surface)
+
+    void multiply(const double a[4][4], const double b[4][4], double out[4][4]) {
+        double r[4][4];
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 4; j++) {
+                r[i][j] = a[i][0] * b[0][j] + a[i][1] * b[1][j] + a[i][2] * b[2][j] + a[i][3] * b[3][j];
+            }
+        }
+        std::memcpy(out, r, sizeof(r));
+    }
+
+    double norm1(const double M[4][4]) {
+        double norm = 0.0;
+        for (int j = 0; j < 4; j++) {
+            double column = 0.0;
+            for (int i = 0; i < 4; i++) column += std::fabs(M[i][j]);
+            norm = std::fmax(norm, column);
+        }
+        return norm;
+    }
+
+    // e^(M t) : M t divisé par 2^s (norme 1 <= 1/2), Taylor par Horner, puis
+    // s élévations au carré ; erreur relative de l'ordre de l'epsilon double
+    void expm4(const double M[4][4], double t, double out[4][4]) {
+        const double norm = norm1(M) * std::fabs(t);
+        const int squarings = norm > 0.5 ? int(std::ceil(std::log2(norm / 0.5))) : 0;
+        const double scale = std::ldexp(t, -squarings);
+        double X[4][4], R[4][4] = {};
+        for (int i = 0; i < 4; i++) {
+            R[i][i] = 1.0;
+            for (int j = 0; j < 4; j++) X[i][j] = M[i][j] * scale;
+        }
+        for (int k = kOrder; k >= 1; k--) {
+            multiply(X, R, R);
+            for (int i = 0; i < 4; i++) {
+                for (int j = 0; j < 4; j++) R[i][j] = R[i][j] / k + (i == j ? 1.0 : 0.0);
+            }
+        }
+        for (int s = 0; s < squarings; s++) multiply(R, R, R);
+        std::memcpy(out, R, sizeof(R));
+    }
+
+    // [A b ; 0 0] : e^(M t) donne p(t) = E p + g en une multiplication
+    void augmented(const PiecewiseAffine& s, int r, double M[4][4]) {
+        std::memset(M, 0, sizeof(double) * 16);
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) M[i][j] = s.A[r][i][j];
+            M[i][3] = s.b[r][i];
+        }
+    }
+
+    void apply(const double E[4][4], const double p[3], double out[3]) {
+        for (int i = 0; i < 3; i++) out[i] = E[i][0] * p[0] + E[i][1] * p[1] + E[i][2] * p[2] + E[i][3];
+    }
+
+    int regime(const PiecewiseAffine& s, double x) {
+        int r = 0;
+        while (r < s.surfaces && x >= s.levels[r]) r++;
+        return r;
+    }
+
+    // Exponentielles du pas complet et de dt / kSamples, par régime : le
+    // système et dt ne changent pas d'un pas à l'autre hors des balayages
+    struct Cache {
+        bool valid = false;
+        PiecewiseAffine system;
+        double dt = 0.0;
+        double full[PiecewiseAffine::kMaxSurfaces + 1][4][4];
+        double part[PiecewiseAffine::kMaxSurfaces + 1][4][4];
+    };
+    thread_local Cache cache;
+
+    // Série de la solution en 0 : p(t) = p + somme c[n] t^n, c[1] = A p + b,
+    // c[n + 1] = A c[n] / (n + 1). Polynôme de degré au plus kMaxTerms,
+    // sans perte par compensation tant que |M| t <= 4 (termes bornés par 11 |p|)
+    struct Series {
+        static constexpr int kMaxTerms = 40;
+        double c[kMaxTerms + 1][3];
+        int degree = 0;
+
+        bool build(const PiecewiseAffine& s, int r, const double p[3], double hi) {
+            double scale = 1.0;
+            for (int i = 0; i < 3; i++) {
+                c[0][i] = p[i];
+                scale = std::fmax(scale, std::fabs(p[i]));
+            }
+            double power = 1.0;
+            int small = 0;      // Termes négligeables consécutifs
+            for (int n = 1; n <= kMaxTerms; n++) {
+                double size = 0.0;
+                for (int i = 0; i < 3; i++) {
+                    const double* v = c[n - 1];
+                    double d = s.A[r][i][0] * v[0] + s.A[r][i][1] * v[1] + s.A[r][i][2] * v[2];
+                    if (n == 1) d += s.b[r][i];
+                    c[n][i] = d / n;
+                    size = std::fmax(size, std::fabs(c[n][i]));
+                }
+                power *= hi;
+                degree = n;
+                small = size * power <= 1e-17 * scale ? small + 1 : 0;
+                if (small == 2) return true;
+            }
+            return false;
+        }
+
+        double value(int i, double t) const {
+            double v = c[degree][i];
+            for (int n = degree - 1; n >= 0; n--) v = v * t + c[n][i];
+            return v;
+        }
+    };
+
+    // Instant t de (lo, hi] où p[axis] atteint level en venant du côté below
+    // (p(lo) de ce côté, p(hi) de l'autre ; p(0) = p peut être sur la surface
+    // si le pas vient d'y commencer) : Newton gardé dans l'intervalle qui
+    // encadre le passage (bissection sinon), sur la série de la solution, ou
+    // sur l'exponentielle si le pas est trop long pour la série
+    double crossing(const PiecewiseAffine& s, int r, const double M[4][4], const double p[3], double level,
+                    bool below, double lo, double gLo, double hi, double gHi, double q[3]) {
+        const int axis = s.axis;
+        const double start = lo;
+        Series series;
+        const bool polynomial = norm1(M) * hi <= 4.0 && series.build(s, r, p, hi);
+        auto at = [&](double t) {
+            if (polynomial) {
+                for (int i = 0; i < 3; i++) q[i] = series.value(i, t);
+            } else {
+                double E[4][4];
+                expm4(M, t, E);
+                apply(E, p, q);
+            }
+        };
+        double t = gHi != gLo ? lo + (hi - lo) * gLo / (gLo - gHi) : hi;
+        if (!(t > lo)) t = 0.5 * (lo + hi);     // Départ sur la surface : pas la racine t = lo
+        for (int it = 0; it < 60; it++) {
+            at(t);
+            const double g = q[axis] - level;
+            if (std::fabs(g) <= 1e-14 * (1.0 + std::fabs(level)) && t > start) break;
+            if ((g < 0.0) == below) lo = t;
+            else hi = t;
+            double rate = s.b[r][axis];
+            for (int j = 0; j < 3; j++) rate += s.A[r][axis][j] * q[j];
+            double next = rate != 0.0 ? t - g / rate : lo;
+            if (!(next > lo && next < hi)) next = 0.5 * (lo + hi);
+            if (hi - lo <= 1e-15 * hi) break;
+            t = next;
+        }
+        q[axis] = level;
+        return t;
+    }
+
+    // Instant t de [0, h] où la dérivée de p[axis] s'annule, sachant qu'elle
+    // change de signe entre q (t = 0) et la fin de l'intervalle : Newton
+    // gardé sur la série de la solution partie de q (h est une fraction du
+    // pas : la série converge vite). e reçoit le point en t
+    double extremum(const PiecewiseAffine& s, int r, const double q[3], double h, double e[3]) {
+        const int axis = s.axis;
+        const double* A = s.A[r][axis];
+        auto rate = [&](const double v[3]) { return s.b[r][axis] + A[0] * v[0] + A[1] * v[1] + A[2] * v[2]; };
+        double M[4][4];
+        augmented(s, r, M);
+        Series series;
+        const bool polynomial = norm1(M) * h <= 4.0 && series.build(s, r, q, h);
+        auto at = [&](double t) {
+            if (polynomial) {
+                for (int i = 0; i < 3; i++) e[i] = series.value(i, t);
+            } else {
+                double E[4][4];
+                expm4(M, t, E);
+                apply(E, q, e);
+            }
+        };
+        const bool falling = rate(q) < 0.0;
+        double lo = 0.0, hi = h, t = 0.5 * h;
+        for (int it = 0; it < 60; it++) {
+            at(t);
+            const double v = rate(e);
+            if ((v < 0.0) == falling) lo = t;
+            else hi = t;
+            // Dérivée seconde : A[axis] . (A e + b)
+            double curvature = 0.0;
+            for (int j = 0; j < 3; j++) {
+                curvature += A[j] * (s.b[r][j] + s.A[r][j][0] * e[0] + s.A[r][j][1] * e[1] + s.A[r][j][2] * e[2]);
+            }
+            double next = curvature != 0.0 ? t - v / curvature : lo;
+            if (!(next > lo && next < hi)) next = 0.5 * (lo + hi);
+            if (std::fabs(next - t) <= 1e-12 * h || hi - lo <= 1e-12 * h) break;
+            t = next;
+        }
+        return t;
+    }
+}
+
+void stepPiecewise(const PiecewiseAffine& s, double p[3], double dt) {
+    Cache& c = cache;
+    if (!c.valid || c.dt != dt || std::memcmp(&c.system, &s, sizeof(s)) != 0) {
+        for (int r = 0; r <= s.surfaces; r++) {
+            double M[4][4];
+            augmented(s, r, M);
+            expm4(M, dt, c.full[r]);
+            expm4(M, dt / kSamples, c.part[r]);
+        }
+        c.system = s;
+        c.dt = dt;
+        c.valid = true;
+    }
+
+    const int axis = s.axis;
+    int r = regime(s, p[axis]);
+    double remaining = dt;
+    for (int crossings = 0;; crossings++) {
+        double M[4][4];
+        augmented(s, r, M);
+        const double T = remaining;
+        // Série de la solution (reste du pas après une commutation), sinon
+        // exponentielle (pas trop long pour la série)
+        Series series;
+        int polynomial = -1;
+        auto usePolynomial = [&] {
+            if (polynomial < 0) polynomial = norm1(M) * T <= 4.0 && series.build(s, r, p, T);
+            return polynomial == 1;
+        };
+        auto rate = [&](const double q[3]) {
+            return s.b[r][axis] + s.A[r][axis][0] * q[0] + s.A[r][axis][1] * q[1] + s.A[r][axis][2] * q[2];
+        };
+
+        // Échantillons q[k] = p(k T / kSamples) ; le dernier est la fin du pas
+        double q[kSamples + 1][3];
+        std::memcpy(q[0], p, sizeof(q[0]));
+        if (crossings == 0) {
+            for (int k = 1; k < kSamples; k++) apply(c.part[r], q[k - 1], q[k]);
+            apply(c.full[r], p, q[kSamples]);
+        } else if (usePolynomial()) {
+            for (int k = 1; k <= kSamples; k++) {
+                for (int i = 0; i < 3; i++) q[k][i] = series.value(i, T * k / kSamples);
+            }
+        } else {
+            double E[4][4];
+            expm4(M, T / kSamples, E);
+            for (int k = 1; k <= kSamples; k++) apply(E, q[k - 1], q[k]);
+        }
+
+        // Premier point hors du régime : un échantillon, ou l'extremum de
+        // p[axis] entre deux échantillons où sa dérivée change de signe (la
+        // trajectoire sort et revient dans le même pas)
+        double hi = 0.0, out[3];
+        int last = 0;   // Dernier échantillon dans le régime avant la sortie
+        for (int k = 1; k <= kSamples && hi == 0.0; k++) {
+            last = k - 1;
+            if (regime(s, q[k][axis]) != r) {
+                hi = T * k / kSamples;
+                std::memcpy(out, q[k], sizeof(out));
+                continue;
+            }
+            if ((rate(q[k - 1]) < 0.0) == (rate(q[k]) < 0.0)) continue;
+            double e[3];
+            const double t = extremum(s, r, q[k - 1], T / kSamples, e);
+            if (regime(s, e[axis]) != r) {
+                hi = T * (k - 1) / kSamples + t;
+                std::memcpy(out, e, sizeof(out));
+            }
+        }
+        if (hi == 0.0 || crossings == kMaxCrossings) {
+            std::memcpy(p, q[kSamples], sizeof(q[kSamples]));
+            return;
+        }
+        // Surface franchie au-dessus ou au-dessous, entre le dernier
+        // échantillon du régime et le premier point dehors
+        const bool up = regime(s, out[axis]) > r;
+        const double level = s.levels[up ? r : r - 1];
+        double onSurface[3];
+        const double t = crossing(s, r, M, p, level, up, T * last / kSamples, q[last][axis] - level, hi,
+                                  out[axis] - level, onSurface);
+        std::memcpy(p, onSurface, sizeof(onSurface));
+        remaining -= t;
+        r += up ? 1 : -1;
+        if (remaining <= 0.0) return;
+    }
+}
+/**
+ * Piecewise.cpp
+ *
+ * Contient l'exponentielle de matrice, le pas exact par régime et la
+ * localisation des commutations des systèmes affines par morceaux.
+ */
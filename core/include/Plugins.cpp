@@ -0,0 +1,172 @@
+#include "Plugins.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <mutex>
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+#ifdef __APPLE__
+#include <mach-o/dyld.h>
+#endif
+
+namespace {
+    // Les emplacements ne sont remplis qu'une fois et jamais vidés : les
+    // noyaux lisent le descripteur sans verrou
+    struct Slot {
+        SystemInfo info;
+        std::string path;
+    };
+
+    std::mutex mutex;
+    Slot slots[kPluginSlots];
+    std::atomic<const AttractorPluginSystem*> systems[kPluginSlots] = {};
+    int used = 0;
+    std::vector<std::string> libraries;     // Chemins déjà chargés
+
+    std::string validate(const AttractorPluginSystem& s) {
+        if (s.abi != ATTRACTEUR_PLUGIN_ABI) return "interface " + std::to_string(s.abi) + " (attendue : " + std::to_string(ATTRACTEUR_PLUGIN_ABI) + ")";
+        if (s.size < sizeof(AttractorPluginSystem)) return "descripteur tronqué";
+        if (!s.name || !*s.name) return "système sans nom";
+        if (s.dim != 2 && s.dim != 3) return std::string(s.name) + " : dim doit valoir 2 ou 3";
+        if (s.param_count < 0 || s.param_count > kMaxParams) return std::string(s.name) + " : au plus " + std::to_string(kMaxParams) + " paramètres";
+        for (int i = 0; i < s.param_count; i++) {
+            if (!s.param_names[i]) return std::string(s.name) + " : paramètre " + std::to_string(i) + " sans nom";
+        }
+        if (!s.field_f || !s.field_d) return std::string(s.name) + " : field_f et field_d sont obligatoires";
+        if (Attractor::find(s.name)) return std::string(s.name) + " : nom déjà pris";
+        return "";
+    }
+
+    bool library(const std::filesystem::path& path) {
+        const std::string ext = path.extension().string();
+        return ext == ".so" || ext == ".dylib";
+    }
+
+    // Dossier de l'exécutable en cours ; vide si inconnu
+    std::filesystem::path executableDirectory() {
+        std::error_code ec;
+#if defined(__APPLE__)
+        char buffer[4096];
+        uint32_t size = sizeof(buffer);
+        if (_NSGetExecutablePath(buffer, &size) != 0) return {};
+        std::filesystem::path exe = std::filesystem::canonical(buffer, ec);
+#elif defined(__linux__)
+        std::filesystem::path exe = std::filesystem::read_symlink("/proc/self/exe", ec);
+#else
+        std::filesystem::path exe;
+        ec = std::make_error_code(std::errc::not_supported);
+#endif
+        return ec ? std::filesystem::path() : exe.parent_path();
+    }
+}
+
+const AttractorPluginSystem* pluginSystem(int slot) {
+    if (slot < 0 || slot >= kPluginSlots) return nullptr;
+    return systems[slot].load(std::memory_order_acquire);
+}
+
+#ifdef _WIN32
+
+int loadPlugins(const std::string&, std::vector<std::string>&) {
+    return 0;
+}
+
+#else
+
+int loadPlugins(const std::string& directory, std::vector<std::string>& errors) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    if (!fs::is_directory(directory, ec)) return 0;
+    std::vector<fs::path> paths;
+    for (const auto& entry : fs::directory_iterator(directory, ec)) {
+        if (entry.is_regular_file(ec) && library(entry.path())) paths.push_back(fs::absolute(entry.path(), ec));
+    }
+    std::sort(paths.begin(), paths.end());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    int loaded = 0;
+    for (const fs::path& path : paths) {
+        const std::string name = path.string();
+        if (std::find(libraries.begin(), libraries.end(), name) != libraries.end()) continue;
+        libraries.push_back(name);
+        // Jamais déchargée, comme les noyaux natifs (Jit.h)
+        void* handle = dlopen(name.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (!handle) {
+            errors.push_back(dlerror());
+            continue;
+        }
+        auto entry = reinterpret_cast<AttractorPluginEntry>(dlsym(handle, ATTRACTEUR_PLUGIN_ENTRY));
+        if (!entry) {
+            errors.push_back(name + " : " + ATTRACTEUR_PLUGIN_ENTRY + " absent");
+            continue;
+        }
+        int count = 0;
+        const AttractorPluginSystem* list = entry(&count);
+        for (int i = 0; list && i < count; i++) {
+            const AttractorPluginSystem& s = list[i];
+            std::string error = validate(s);
+            if (error.empty() && used == kPluginSlots) error = std::string(s.name) + " : " + std::to_string(kPluginSlots) + " greffons au plus";
+            if (!error.empty()) {
+                errors.push_back(name + " : " + error);
+                continue;
+            }
+            Slot& slot = slots[used];
+            slot.path = name;
+            slot.info = {s.name, {s.initial[0], s.initial[1], s.initial[2]}, s.zoom > 0.0f ? s.zoom : 15.0f,
+                         s.dim, s.is_map != 0, s.param_count, {}, {}};
+            for (int p = 0; p < s.param_count; p++) {
+                slot.info.paramNames[p] = s.param_names[p];
+                slot.info.paramDefaults[p] = s.param_defaults[p];
+            }
+            // Registre complet avant la publication du descripteur
+            systems[used].store(&s, std::memory_order_release);
+            used++;
+            loaded++;
+        }
+    }
+    return loaded;
+}
+
+#endif
+
+std::string pluginDirectory() {
+    const char* dir = std::getenv("ATTRACTEUR_PLUGINS");
+    if (dir && *dir) return dir;
+    // Jamais le répertoire courant : lancer le programme depuis un dossier
+    // quelconque ne doit pas exécuter les bibliothèques qui s'y trouvent
+    std::filesystem::path exe = executableDirectory();
+    return exe.empty() ? "" : (exe / "plugins").string();
+}
+
+void loadStartupPlugins() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        std::vector<std::string> errors;
+        loadPlugins(pluginDirectory(), errors);
+        for (const std::string& e : errors) std::fprintf(stderr, "Greffon refusé : %s\n", e.c_str());
+    });
+}
+
+int pluginCount() {
+    int n = 0;
+    while (n < kPluginSlots && pluginSystem(n)) n++;
+    return n;
+}
+
+const SystemInfo* pluginSystemInfo(int slot) {
+    return pluginSystem(slot) ? &slots[slot].info : nullptr;
+}
+
+std::string pluginPath(int slot) {
+    return pluginSystem(slot) ? slots[slot].path : "";
+}
+/**
+ * Plugins.cpp
+ *
+ * Contient le chargement dynamique des greffons de systèmes, la validation
+ * de leurs descripteurs et leurs emplacements dans le registre.
+ */
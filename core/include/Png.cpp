@@ -0,0 +1,235 @@
+#include "Png.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "Checksum.h"
+
+namespace {
+    constexpr int kWindow = 32768;          // Distance maximale de deflate
+    constexpr int kHashBits = 15;
+    constexpr int kMaxChain = 32;           // Candidats examinés par position
+    constexpr int kMinMatch = 3;
+    constexpr int kMaxMatch = 258;
+
+    const uint16_t kLengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                      35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    const uint8_t kLengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                      3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    const uint16_t kDistanceBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385,
+                                        513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+    const uint8_t kDistanceExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7,
+                                        8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+    uint32_t reverseBits(uint32_t v, int n) {
+        uint32_t r = 0;
+        for (int i = 0; i < n; i++, v >>= 1) r = r << 1 | (v & 1);
+        return r;
+    }
+
+    // Codes de Huffman fixes de deflate (RFC 1951, 3.2.6), déjà retournés :
+    // les codes s'écrivent bit de poids fort en premier dans un flux qui
+    // remplit les octets par le poids faible
+    struct FixedCodes {
+        uint16_t literal[288];
+        uint8_t literalBits[288];
+        uint8_t distance[30];
+        FixedCodes() {
+            for (int s = 0; s < 288; s++) {
+                uint32_t code;
+                int bits;
+                if (s < 144) { code = 0x30 + s; bits = 8; }
+                else if (s < 256) { code = 0x190 + (s - 144); bits = 9; }
+                else if (s < 280) { code = s - 256; bits = 7; }
+                else { code = 0xC0 + (s - 280); bits = 8; }
+                literal[s] = uint16_t(reverseBits(code, bits));
+                literalBits[s] = uint8_t(bits);
+            }
+            for (int d = 0; d < 30; d++) distance[d] = uint8_t(reverseBits(uint32_t(d), 5));
+        }
+    };
+
+    class BitWriter {
+    public:
+        explicit BitWriter(std::vector<uint8_t>& out) : out(out) {}
+
+        void put(uint32_t value, int n) {
+            acc |= uint64_t(value) << fill;
+            fill += n;
+            while (fill >= 8) {
+                out.push_back(uint8_t(acc));
+                acc >>= 8;
+                fill -= 8;
+            }
+        }
+
+        void align() {
+            if (fill > 0) put(0, 8 - fill);
+        }
+
+    private:
+        std::vector<uint8_t>& out;
+        uint64_t acc = 0;
+        int fill = 0;
+    };
+
+    // Flux zlib d'un seul bloc deflate à codes fixes
+    void deflateFixed(const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+        static const FixedCodes codes;
+        out.push_back(0x78);        // deflate, fenêtre de 32 Ko
+        out.push_back(0x01);        // Sans dictionnaire ; (0x78 << 8 | 0x01) % 31 == 0
+        BitWriter bits(out);
+        bits.put(1, 1);             // Dernier bloc
+        bits.put(1, 2);             // Codes fixes
+
+        auto literal = [&](int s) { bits.put(codes.literal[s], codes.literalBits[s]); };
+        auto match = [&](int length, int distance) {
+            int l = int(std::upper_bound(kLengthBase, kLengthBase + 29, length) - kLengthBase) - 1;
+            literal(257 + l);
+            if (kLengthExtra[l]) bits.put(uint32_t(length - kLengthBase[l]), kLengthExtra[l]);
+            int d = int(std::upper_bound(kDistanceBase, kDistanceBase + 30, distance) - kDistanceBase) - 1;
+            bits.put(codes.distance[d], 5);
+            if (kDistanceExtra[d]) bits.put(uint32_t(distance - kDistanceBase[d]), kDistanceExtra[d]);
+        };
+
+        // head : dernière position de chaque empreinte ; prev : position
+        // précédente de même empreinte, par position modulo la fenêtre
+        std::vector<int32_t> head(size_t(1) << kHashBits, -1);
+        std::vector<int32_t> prev(kWindow, -1);
+        auto hash = [&](size_t i) {
+            uint32_t v = uint32_t(data[i]) | uint32_t(data[i + 1]) << 8 | uint32_t(data[i + 2]) << 16;
+            return (v * 2654435761u) >> (32 - kHashBits);
+        };
+        auto insert = [&](size_t i) {
+            if (i + kMinMatch > size) return;
+            uint32_t h = hash(i);
+            prev[i & (kWindow - 1)] = head[h];
+            head[h] = int32_t(i);
+        };
+
+        for (size_t i = 0; i < size;) {
+            int best = 0, bestDistance = 0;
+            if (i + kMinMatch <= size) {
+                const int limit = int(std::min<size_t>(kMaxMatch, size - i));
+                int32_t j = head[hash(i)];
+                for (int chain = kMaxChain; j >= 0 && i - size_t(j) <= size_t(kWindow) && chain > 0; chain--) {
+                    const uint8_t* a = data + i;
+                    const uint8_t* b = data + j;
+                    if (b[best] == a[best]) {
+                        int n = 0;
+                        while (n < limit && a[n] == b[n]) n++;
+                        if (n > best) {
+                            best = n;
+                            bestDistance = int(i - size_t(j));
+                            if (n == limit) break;
+                        }
+                    }
+                    int32_t next = prev[size_t(j) & (kWindow - 1)];
+                    if (next >= j) break;       // Case déjà réutilisée par une position plus récente
+                    j = next;
+                }
+            }
+            if (best >= kMinMatch) {
+                match(best, bestDistance);
+                for (int k = 0; k < best; k++) insert(i + size_t(k));
+                i += size_t(best);
+            } else {
+                literal(data[i]);
+                insert(i);
+                i++;
+            }
+        }
+        literal(256);               // Fin de bloc
+        bits.align();
+
+        uint32_t adler = adler32(1, data, size);
+        for (int shift = 24; shift >= 0; shift -= 8) out.push_back(uint8_t(adler >> shift));
+    }
+
+    int paeth(int a, int b, int c) {
+        int p = a + b - c;
+        int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+        return pa <= pb && pa <= pc ? a : pb <= pc ? b : c;
+    }
+
+    // Ligne filtrée par filter (0 à 4) ; up : ligne précédente (zéros en haut)
+    void filterRow(int filter, const uint8_t* row, const uint8_t* up, size_t bytes, int bpp, uint8_t* out) {
+        for (size_t i = 0; i < bytes; i++) {
+            int a = i >= size_t(bpp) ? row[i - bpp] : 0;
+            int b = up[i];
+            int c = i >= size_t(bpp) ? up[i - bpp] : 0;
+            int predicted = filter == 1 ? a : filter == 2 ? b : filter == 3 ? (a + b) / 2 : filter == 4 ? paeth(a, b, c) : 0;
+            out[i] = uint8_t(row[i] - predicted);
+        }
+    }
+
+    void putChunk(std::vector<uint8_t>& out, const char type[4], const uint8_t* data, size_t size) {
+        for (int shift = 24; shift >= 0; shift -= 8) out.push_back(uint8_t(size >> shift));
+        size_t at = out.size();
+        out.insert(out.end(), type, type + 4);
+        out.insert(out.end(), data, data + size);
+        uint32_t crc = crc32(0, out.data() + at, size + 4);
+        for (int shift = 24; shift >= 0; shift -= 8) out.push_back(uint8_t(crc >> shift));
+    }
+}
+
+bool encodePng(const uint8_t* pixels, int width, int height, int channels, size_t stride,
+               std::vector<uint8_t>& out) {
+    if (width <= 0 || height <= 0 || (channels != 3 && channels != 4)) return false;
+    const size_t rowBytes = size_t(width) * size_t(channels);
+    if (stride == 0) stride = rowBytes;
+
+    // Octet de filtre puis ligne filtrée, pour chaque ligne
+    std::vector<uint8_t> filtered((rowBytes + 1) * size_t(height));
+    std::vector<uint8_t> zeros(rowBytes, 0), candidate(rowBytes);
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = pixels + size_t(y) * stride;
+        const uint8_t* up = y > 0 ? row - stride : zeros.data();
+        uint8_t* dst = filtered.data() + size_t(y) * (rowBytes + 1);
+        // Filtre de plus petite somme des |écarts| (heuristique de libpng)
+        uint64_t bestSum = ~uint64_t(0);
+        for (int filter = 0; filter < 5; filter++) {
+            filterRow(filter, row, up, rowBytes, channels, candidate.data());
+            uint64_t sum = 0;
+            for (size_t i = 0; i < rowBytes; i++) sum += uint64_t(std::abs(int(int8_t(candidate[i]))));
+            if (sum < bestSum) {
+                bestSum = sum;
+                dst[0] = uint8_t(filter);
+                std::memcpy(dst + 1, candidate.data(), rowBytes);
+            }
+        }
+    }
+
+    out.clear();
+    const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    out.insert(out.end(), signature, signature + 8);
+    uint8_t ihdr[13] = {};
+    for (int i = 0; i < 4; i++) {
+        ihdr[i] = uint8_t(uint32_t(width) >> (24 - 8 * i));
+        ihdr[4 + i] = uint8_t(uint32_t(height) >> (24 - 8 * i));
+    }
+    ihdr[8] = 8;                            // Bits par composante
+    ihdr[9] = channels == 4 ? 6 : 2;        // RGBA ou RGB
+    putChunk(out, "IHDR", ihdr, sizeof(ihdr));
+    std::vector<uint8_t> idat;
+    deflateFixed(filtered.data(), filtered.size(), idat);
+    putChunk(out, "IDAT", idat.data(), idat.size());
+    putChunk(out, "IEND", nullptr, 0);
+    return true;
+}
+
+bool writePng(const std::string& path, const uint8_t* pixels, int width, int height, int channels, size_t stride) {
+    std::vector<uint8_t> data;
+    if (!encodePng(pixels, width, height, channels, stride, data)) return false;
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    bool ok = std::fwrite(data.data(), 1, data.size(), f) == data.size();
+    ok = std::fclose(f) == 0 && ok;
+    return ok;
+}
+/**
+ * Png.cpp
+ *
+ * Contient l'encodage PNG : filtrage des lignes, compression deflate (codes
+ * de Huffman fixes) et découpage en blocs IHDR, IDAT et IEND.
+ */
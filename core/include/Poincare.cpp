@@ -0,0 +1,297 @@
+#include "Poincare.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include "Utils.h"
+
+namespace {
+    double now() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    float dot(const float a[3], const Point& p) {
+        return a[0] * p.x + a[1] * p.y + a[2] * p.z;
+    }
+
+    // Passages accumulés localement avant d'être ajoutés à l'image commune
+    constexpr size_t kFlushSize = 1024;
+    // Passages utilisés pour estimer la plage automatique
+    constexpr int kProbeCrossings = 4000;
+    // Pas sans aucun passage au-delà desquels la trajectoire est abandonnée
+    // (point fixe, plan qui ne coupe pas l'attracteur)
+    constexpr long kMaxGap = 2000000;
+
+    // Intègre le flot et appelle onCrossing(point exact sur le plan) à chaque
+    // passage ; s'arrête quand onCrossing renvoie faux, si la trajectoire
+    // diverge ou ne coupe plus le plan. La normale n doit être unitaire.
+    template <int Type, typename OnCrossing>
+    void followCrossings(const PoincareSettings& s, const float n[3], Point& p, OnCrossing&& onCrossing) {
+        float g0 = dot(n, p) - s.offset;
+        for (long gap = 0; gap < kMaxGap; gap++) {
+            Point before = p;
+            advance<Type>(s.integrator, s.params, p, s.dt, s.taylorOrder);
+            float g1 = dot(n, p) - s.offset;
+            if (!std::isfinite(g1)) return;
+            bool up = g0 < 0.0f && g1 >= 0.0f;
+            bool down = g0 > 0.0f && g1 <= 0.0f;
+            if (up || (down && s.bothDirections)) {
+                // Le passage est situé entre deux pas : astuce de Hénon depuis le
+                // point de départ du pas, plutôt qu'une interpolation linéaire
+                stepToPlane<Type>(s.params, n, before, -g0);
+                if (!onCrossing(before)) return;
+                gap = 0;
+            }
+            g0 = g1;
+        }
+    }
+}
+
+PoincareSettings::PoincareSettings(int t) : type(t) {
+    const SystemInfo& sys = Attractor::info(type);
+    for (int i = 0; i < kMaxParams; i++) params[i] = sys.paramDefaults[i];
+    initial = sys.initial;
+    // Plans conseillés : z = rho - 1 pour Lorenz, plans de coordonnée sinon
+    int axis = 2;
+    offset = 0.0f;
+    if (type == 1) offset = 27.0f;
+    else if (type == 2 || type == 11 || type == 14) axis = 1;
+    else if (type == 3) axis = 0;
+    for (int i = 0; i < 3; i++) normal[i] = i == axis ? 1.0f : 0.0f;
+}
+
+bool poincareSupported(int type) {
+    const SystemInfo& sys = Attractor::info(type);
+    return !sys.isMap && sys.dim == 3 && type != 7;
+}
+
+void poincareBasis(const float normal[3], float u[3], float v[3]) {
+    // u : axe le moins aligné avec la normale, projeté sur le plan
+    int axis = 0;
+    for (int i = 1; i < 3; i++) {
+        if (std::fabs(normal[i]) < std::fabs(normal[axis])) axis = i;
+    }
+    float a[3] = {0.0f, 0.0f, 0.0f};
+    a[axis] = 1.0f;
+    float d = normal[axis];
+    float len = 0.0f;
+    for (int i = 0; i < 3; i++) { u[i] = a[i] - d * normal[i]; len += u[i] * u[i]; }
+    len = std::sqrt(len);
+    for (int i = 0; i < 3; i++) u[i] /= len;
+    // v = normale x u, orienté vers les coordonnées positives
+    v[0] = normal[1] * u[2] - normal[2] * u[1];
+    v[1] = normal[2] * u[0] - normal[0] * u[2];
+    v[2] = normal[0] * u[1] - normal[1] * u[0];
+    int largest = 0;
+    for (int i = 1; i < 3; i++) {
+        if (std::fabs(v[i]) > std::fabs(v[largest])) largest = i;
+    }
+    if (v[largest] < 0.0f) {
+        for (int i = 0; i < 3; i++) v[i] = -v[i];
+    }
+}
+
+PoincareSection::~PoincareSection() {
+    stop();
+}
+
+bool PoincareSection::start(const PoincareSettings& settings) {
+    return launch(settings, nullptr);
+}
+
+bool PoincareSection::resume(const PoincareCheckpoint& checkpoint) {
+    const PoincareSettings& s = checkpoint.settings;
+    if (checkpoint.image.width != s.width || checkpoint.image.height != s.height || !(s.uMin < s.uMax)) return false;
+    return launch(s, &checkpoint);
+}
+
+bool PoincareSection::launch(const PoincareSettings& settings, const PoincareCheckpoint* from) {
+    stop();
+    if (!poincareSupported(settings.type)) return false;
+
+    current = settings;
+    float len = std::sqrt(current.normal[0] * current.normal[0] + current.normal[1] * current.normal[1]
+                          + current.normal[2] * current.normal[2]);
+    if (!(len > 0.0f)) return false;
+    for (int i = 0; i < 3; i++) current.normal[i] /= len;
+    current.offset /= len;
+    current.width = std::max(1, current.width);
+    current.height = std::max(1, current.height);
+
+    density.resize(current.width, current.height);
+    crossingCount = 0;
+    imageVersion = 0;
+    stopRequested = false;
+    rangeReady = false;
+    rangeOnce.reset(new std::once_flag);
+    startTime = now();
+    previousSeconds = 0.0;
+
+    int threads = current.threads > 0 ? current.threads : int(std::thread::hardware_concurrency());
+    threads = std::max(1, threads);
+    positions.assign(size_t(threads), current.initial);
+    resumed.assign(size_t(threads), 0);
+    if (from) {
+        // Plage de la sauvegarde : les nouveaux passages tombent dans les mêmes pixels
+        density = from->image;
+        crossingCount = from->crossings;
+        previousSeconds = from->seconds;
+        elapsed = from->seconds;
+        rangeValues[0] = current.uMin; rangeValues[1] = current.uMax;
+        rangeValues[2] = current.vMin; rangeValues[3] = current.vMax;
+        rangeReady = true;
+        std::call_once(*rangeOnce, [] {});
+        for (size_t t = 0; t < positions.size() && t < from->trajectories.size(); t++) {
+            positions[t] = from->trajectories[t];
+            resumed[t] = 1;
+        }
+        imageVersion = 1;
+        if (!from->running) return true;
+    }
+    activeThreads = threads;
+    for (int t = 0; t < threads; t++) pool.emplace_back(&PoincareSection::worker, this, t);
+    return true;
+}
+
+void PoincareSection::worker(int index) {
+    Utils::FlushDenormals ftz;
+    const PoincareSettings& s = current;
+    float u[3], v[3];
+    poincareBasis(s.normal, u, v);
+
+    dispatchSystem(s.type, [&](auto tag) {
+        constexpr int Type = decltype(tag)::value;
+        // Départs décalés : chaque thread parcourt l'attracteur de son côté
+        // (sauf en reprise, où il repart de son dernier point)
+        Point p;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            p = positions[index];
+        }
+        if (!resumed[index]) {
+            p.x += 1e-3f * float(index);
+            for (long i = 0; i < s.transient; i++) advance<Type>(s.integrator, s.params, p, s.dt, s.taylorOrder);
+        }
+
+        // Un seul thread estime la plage, les autres l'attendent
+        std::call_once(*rangeOnce, [&] {
+            float r[4] = {s.uMin, s.uMax, s.vMin, s.vMax};
+            if (s.uMin == s.uMax) {
+                r[0] = r[2] = INFINITY;
+                r[1] = r[3] = -INFINITY;
+                int found = 0;
+                Point probe = p;
+                followCrossings<Type>(s, s.normal, probe, [&](const Point& q) {
+                    float a = dot(u, q), b = dot(v, q);
+                    r[0] = std::min(r[0], a); r[1] = std::max(r[1], a);
+                    r[2] = std::min(r[2], b); r[3] = std::max(r[3], b);
+                    return ++found < kProbeCrossings;
+                });
+                if (found < 2) { r[0] = r[2] = -1.0f; r[1] = r[3] = 1.0f; }
+                // Marge de 5 % ; plage minimale pour les sections réduites à un point
+                for (int i = 0; i < 4; i += 2) {
+                    float margin = std::max(0.05f * (r[i + 1] - r[i]), 1e-3f);
+                    r[i] -= margin;
+                    r[i + 1] += margin;
+                }
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            std::copy(r, r + 4, rangeValues);
+            rangeReady.store(true, std::memory_order_release);
+        });
+        float r[4];
+        range(r);
+        const float su = float(s.width) / (r[1] - r[0]);
+        const float sv = float(s.height) / (r[3] - r[2]);
+
+        // Un élément par passage, kOutside hors de l'image : le lot peut être
+        // tronqué au passage près quand la limite est atteinte
+        constexpr uint32_t kOutside = UINT32_MAX;
+        std::vector<uint32_t> pending;
+        pending.reserve(kFlushSize);
+        long total = 0;
+        auto flush = [&] {
+            {
+                // Image, compteur et position changent ensemble : une copie
+                // (snapshot) est toujours cohérente. Les passages au-delà de
+                // maxCrossings sont ignorés : le total ne dépend pas des fils
+                std::lock_guard<std::mutex> lock(mutex);
+                size_t taken = pending.size();
+                if (s.maxCrossings > 0) taken = size_t(std::clamp(s.maxCrossings - crossingCount, 0L, long(taken)));
+                for (size_t i = 0; i < taken; i++) {
+                    if (pending[i] != kOutside) density.counts[pending[i]]++;
+                }
+                total = crossingCount += long(taken);
+                positions[index] = p;
+            }
+            pending.clear();
+            imageVersion.fetch_add(1, std::memory_order_release);
+            return !stopRequested && (s.maxCrossings <= 0 || total < s.maxCrossings);
+        };
+
+        followCrossings<Type>(s, s.normal, p, [&](const Point& q) {
+            float col = (dot(u, q) - r[0]) * su;
+            float row = (r[3] - dot(v, q)) * sv;   // v croissant vers le haut
+            bool inside = col >= 0.0f && col < float(s.width) && row >= 0.0f && row < float(s.height);
+            pending.push_back(inside ? uint32_t(size_t(row) * s.width + size_t(col)) : kOutside);
+            return pending.size() < kFlushSize || flush();
+        });
+        flush();
+    });
+    if (--activeThreads == 0) elapsed = previousSeconds + now() - startTime;
+}
+
+void PoincareSection::stop() {
+    stopRequested = true;
+    wait();
+}
+
+void PoincareSection::wait() {
+    for (std::thread& t : pool) t.join();
+    pool.clear();
+}
+
+double PoincareSection::seconds() const {
+    return isRunning() ? previousSeconds + now() - startTime : elapsed.load();
+}
+
+bool PoincareSection::range(float out[4]) const {
+    if (!rangeReady.load(std::memory_order_acquire)) return false;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::copy(rangeValues, rangeValues + 4, out);
+    return true;
+}
+
+void PoincareSection::snapshot(PoincareCheckpoint& out) const {
+    float r[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    range(r);
+    std::lock_guard<std::mutex> lock(mutex);
+    out.settings = current;
+    out.settings.uMin = r[0]; out.settings.uMax = r[1];
+    out.settings.vMin = r[2]; out.settings.vMax = r[3];
+    out.image = density;
+    out.crossings = crossingCount;
+    out.seconds = seconds();
+    out.running = isRunning();
+    out.trajectories = positions;
+}
+
+void PoincareSection::copyImage(DensityImage& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    out = density;
+}
+
+DensityImage computePoincare(const PoincareSettings& settings) {
+    PoincareSection section;
+    if (!section.start(settings)) return DensityImage();
+    section.wait();
+    DensityImage image;
+    section.copyImage(image);
+    return image;
+}
+/**
+ * Poincare.cpp
+ *
+ * Contient la détection des passages par le plan de section, leur
+ * raffinement par l'astuce de Hénon et l'accumulation multi-thread.
+ */
@@ -1,29 +1,63 @@
 #include "Renderer.h"
+#include <cmath>
 
-Renderer::Renderer() : pointColor({255, 255, 255, 255}) {}
+Renderer::Renderer() {}
 
 Renderer::~Renderer() {}
 
-void Renderer::initialize() {
-    // Set up any necessary OpenGL configurations
+void Renderer::initialize(SDL_Renderer* renderer) {
+    sdl = renderer;
 }
 
 void Renderer::clear() {
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
+    SDL_SetRenderDrawColor(sdl, 0, 0, 0, 255);
+    SDL_RenderClear(sdl);
 }
 
-void Renderer::render(const Attractor& attractor) {
-    const auto& points = attractor.getPoints();
-    glBegin(GL_POINTS);
-    for (const auto& point : points) {
-        glColor3f(pointColor.r / 255.0f, pointColor.g / 255.0f, pointColor.b / 255.0f);
-        glVertex2f(point.x, point.y);
+void Renderer::render(const Point* points, size_t count) {
+    if (count == 0) return;
+    int w = 1280, h = 720;
+    SDL_GetRenderOutputSize(sdl, &w, &h);
+    const float cx = 0.5f * w, cy = 0.5f * h;
+    const float cyaw = std::cos(camera.yaw), syaw = std::sin(camera.yaw);
+    const float cpitch = std::cos(camera.pitch), spitch = std::sin(camera.pitch);
+    const float zoom = camera.zoom;
+
+    projected.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        const Point& p = points[i];
+        float x = cyaw * p.x + syaw * p.z;
+        float z = -syaw * p.x + cyaw * p.z;
+        float y = cpitch * p.y - spitch * z;
+        projected[i] = {cx + x * zoom, cy + y * zoom};
+    }
+    SDL_SetRenderDrawColorFloat(sdl, color[0], color[1], color[2], 1.0f);
+    SDL_RenderPoints(sdl, projected.data(), int(count));
+}
+
+void Renderer::handleEvent(const SDL_Event& event, bool captured) {
+    switch (event.type) {
+        case SDL_EVENT_MOUSE_BUTTON_DOWN:
+            if (event.button.button == SDL_BUTTON_LEFT && !captured) dragging = true;
+            break;
+        case SDL_EVENT_MOUSE_BUTTON_UP:
+            if (event.button.button == SDL_BUTTON_LEFT) dragging = false;
+            break;
+        case SDL_EVENT_MOUSE_MOTION:
+            if (dragging) {
+                camera.yaw += event.motion.xrel * 0.01f;
+                camera.pitch += event.motion.yrel * 0.01f;
+            }
+            break;
+        case SDL_EVENT_MOUSE_WHEEL:
+            if (!captured) camera.zoom *= std::pow(1.1f, event.wheel.y);
+            break;
+        default:
+            break;
     }
-    glEnd();
 }
 /**
  * Renderer.cpp
- * 
+ *
  * Contient l'implémentation des méthodes de rendu.
- */
\ No newline at end of file
+ */
@@ -0,0 +1,110 @@
+#include "Replay.h"
+#include <algorithm>
+#include <cmath>
+
+bool TrajectoryReplay::open(const std::string& path) {
+    close();
+    // Le lecteur ne demande pas de lecture anticipée : chaque fenêtre de la
+    // frise est chargée explicitement par visible()
+    if (!reader.open(path)) return false;
+    opened = true;
+    position = std::min(window, reader.pointCount());
+    playing = false;
+    carry = 0.0;
+    return true;
+}
+
+void TrajectoryReplay::close() {
+    reader.close();
+    opened = false;
+    points.clear();
+    loadedFirst = loadedCount = 0;
+}
+
+void TrajectoryReplay::advance(double seconds) {
+    if (!opened || !playing) return;
+    // En pas de simulation : un point d'un bloc au pas stride en coûte stride,
+    // et le premier point d'un bloc tout l'écart depuis le précédent (blocs
+    // abandonnés) ; la lecture garde la vitesse du système
+    carry += speed * seconds;
+    const auto& chunks = reader.chunks();
+    while (position < length()) {
+        const TrajectoryReader::Chunk& c = chunks[reader.chunkOf(position)];
+        if (position == c.firstIndex && position > 0) {
+            const double gap = double(c.firstStep - reader.stepOf(position - 1));
+            if (carry < gap) break;
+            carry -= gap;
+            position++;
+            continue;
+        }
+        uint64_t n = std::min<uint64_t>(uint64_t(carry / c.stride), c.firstIndex + c.count - position);
+        if (n == 0) break;
+        position += n;
+        carry -= double(n) * c.stride;
+    }
+    if (position >= length()) {
+        carry = 0.0;
+        if (loop) position = std::min(window, length());
+        else {
+            position = length();
+            playing = false;
+        }
+    }
+}
+
+uint32_t TrajectoryReplay::stride() const {
+    if (!opened || reader.chunks().empty()) return 1;
+    return reader.chunks()[reader.chunkOf(std::min(position, length() - 1))].stride;
+}
+
+bool TrajectoryReplay::exportNpy(const std::string& path) {
+    if (!writeTrajectoryNpy(reader, path)) return false;
+    return reader.contiguous() || writeTrajectoryStepsNpy(reader, trajectoryStepsPath(path));
+}
+
+const std::vector<Point>& TrajectoryReplay::visible() {
+    if (!opened) return points;
+    position = std::min(position, length());
+    uint64_t count = std::min(window, position);
+    uint64_t first = position - count;
+    if (first == loadedFirst && count == loadedCount) return points;
+
+    // Les blocs qui ne touchent plus la fenêtre sont rendus au système, ceux
+    // qui y entrent sont demandés avant d'être lus
+    if (loadedCount > 0 && count > 0) {
+        const auto& chunks = reader.chunks();
+        auto chunkStart = [&](uint64_t i) { return chunks[reader.chunkOf(i)].firstIndex; };
+        auto chunkEnd = [&](uint64_t i) { const auto& c = chunks[reader.chunkOf(i)]; return c.firstIndex + c.count; };
+        uint64_t oldStart = chunkStart(loadedFirst), oldEnd = chunkEnd(loadedFirst + loadedCount - 1);
+        uint64_t newStart = chunkStart(first), newEnd = chunkEnd(first + count - 1);
+        if (oldStart < newStart) reader.release(oldStart, std::min(newStart, oldEnd) - oldStart);
+        if (newEnd < oldEnd) {
+            uint64_t from = std::max(newEnd, oldStart);
+            reader.release(from, oldEnd - from);
+        }
+    }
+    reader.prefetch(first, count);
+    points.resize(size_t(count));
+    points.resize(reader.read(first, size_t(count), points.data()));
+    loadedFirst = first;
+    loadedCount = count;
+    return points;
+}
+
+Attractor TrajectoryReplay::source() const {
+    Attractor a;
+    const TrajectoryHeader& h = reader.header();
+    a.select(h.systemType);
+    a.dt = float(h.dt);
+    if (h.integrator >= 0 && h.integrator <= int32_t(Integrator::Taylor)) a.integrator = Integrator(h.integrator);
+    if (h.taylorOrder > 0) a.taylorOrder = int(std::min<uint32_t>(h.taylorOrder, kMaxTaylorOrder));
+    a.precision = h.scalarSize == 8 ? Precision::Double : Precision::Single;
+    for (int i = 0; i < kMaxParams; i++) a.params[i] = float(h.params[i]);
+    a.p = {float(h.initial[0]), float(h.initial[1]), float(h.initial[2])};
+    return a;
+}
+/**
+ * Replay.cpp
+ *
+ * Contient l'avance de la lecture et la pagination de la fenêtre affichée.
+ */
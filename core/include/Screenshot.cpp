@@ -0,0 +1,97 @@
+#include "Screenshot.h"
+#include <ctime>
+#include "Png.h"
+
+namespace {
+    // Au-delà, une capture est ignorée plutôt que d'accumuler des images en
+    // mémoire (F12 maintenue enfoncée...)
+    constexpr size_t kMaxPending = 4;
+}
+
+Screenshot::~Screenshot() {
+    if (!thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopRequested = true;
+    }
+    wake.notify_one();
+    thread.join();      // Les captures en attente sont écrites
+}
+
+void Screenshot::request(bool withInterface) {
+    requested = true;
+    requestedInterface = withInterface;
+}
+
+void Screenshot::capture(SDL_Renderer* renderer, bool withInterface) {
+    if (!requested || requestedInterface != withInterface) return;
+    requested = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (jobs.size() >= kMaxPending) {
+            current.dropped++;
+            return;
+        }
+    }
+    // Attend la fin du tracé en cours, puis recopie la cible de rendu
+    SDL_Surface* surface = SDL_RenderReadPixels(renderer, nullptr);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!surface) {
+            current.failed = true;
+            return;
+        }
+        jobs.push_back({surface, nextPath()});
+        current.pending = int(jobs.size());
+        if (!thread.joinable()) thread = std::thread(&Screenshot::writerLoop, this);
+    }
+    wake.notify_one();
+}
+
+ScreenshotStatus Screenshot::status() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return current;
+}
+
+std::string Screenshot::nextPath() {
+    std::time_t t = std::time(nullptr);
+    char name[64];
+    std::strftime(name, sizeof(name), "capture_%Y%m%d_%H%M%S", std::localtime(&t));
+    std::string path = name;
+    // Plusieurs captures dans la même seconde : capture_..._2.png, _3...
+    if ((long long)t == lastStamp) path += "_" + std::to_string(++sameStamp);
+    else sameStamp = 1;
+    lastStamp = (long long)t;
+    return path + ".png";
+}
+
+void Screenshot::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [&] { return !jobs.empty() || stopRequested; });
+        if (jobs.empty()) break;
+        Job job = jobs.front();
+        lock.unlock();
+
+        // Format de la cible de rendu (BGRA, ARGB...) ramené à RGB 8 bits
+        bool ok = false;
+        SDL_Surface* rgb = SDL_ConvertSurface(job.surface, SDL_PIXELFORMAT_RGB24);
+        SDL_DestroySurface(job.surface);
+        if (rgb) {
+            ok = writePng(job.path, static_cast<const uint8_t*>(rgb->pixels), rgb->w, rgb->h, 3, size_t(rgb->pitch));
+            SDL_DestroySurface(rgb);
+        }
+
+        lock.lock();
+        jobs.pop_front();
+        current.pending = int(jobs.size());
+        current.failed = !ok;
+        if (ok) current.lastPath = job.path;
+    }
+}
+/**
+ * Screenshot.cpp
+ *
+ * Contient la lecture des pixels de la fenêtre et le thread d'encodage PNG
+ * des captures.
+ */
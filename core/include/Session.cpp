@@ -0,0 +1,473 @@
+#include "Session.h"
+#include <chrono>
+#include <cstring>
+#include <type_traits>
+#include "Checksum.h"
+
+namespace {
+    // Format natif (petit-boutiste, tailles de la plateforme) : le journal
+    // n'est relu que par la machine qui l'a écrit
+    constexpr char kSessionMagic[8] = {'A', 'T', 'R', 'S', 'E', 'S', 'S', '\0'};
+    constexpr uint32_t kSessionVersion = 2;    // 2 : intégrateur, précision et état en double
+    // Réécriture quand le journal dépasse 2 x l'état + cette marge
+    constexpr uint64_t kCompactSlack = 16u << 20;
+
+    enum RecordType : uint32_t {
+        RecordView = 1,
+        RecordPointsReset = 2,  // Vide le tampon de points
+        RecordPoints = 3,       // Points ajoutés au tampon
+        RecordPoincare = 4,
+        RecordBifurcation = 5,
+        RecordSystem = 6,       // Nom du système
+        RecordCustom = 7        // Définition du système personnalisé
+    };
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+    };
+
+    // Précède les données de chaque enregistrement
+    struct RecordHeader {
+        uint32_t type;
+        uint32_t crc;           // CRC-32 des données
+        uint64_t bytes;
+    };
+
+    static_assert(std::is_trivially_copyable<SessionView>::value, "SessionView est écrit tel quel");
+    static_assert(std::is_trivially_copyable<PoincareSettings>::value, "PoincareSettings est écrit tel quel");
+    static_assert(std::is_trivially_copyable<BifurcationSettings>::value, "BifurcationSettings est écrit tel quel");
+
+    // Champs de taille fixe de CustomDefinition
+    struct CustomFields {
+        uint32_t isMap;
+        uint32_t native;
+        Point initial;
+        float zoom;
+    };
+
+    // Chaîne : longueur (uint32_t) puis octets
+    void putString(std::vector<uint8_t>& out, const std::string& text) {
+        uint32_t size = uint32_t(text.size());
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&size);
+        out.insert(out.end(), bytes, bytes + sizeof(size));
+        out.insert(out.end(), text.begin(), text.end());
+    }
+
+    // Nom, équations, paramètres (nombre puis nom et valeur), CustomFields
+    std::vector<uint8_t> encodeCustom(const CustomDefinition& def) {
+        std::vector<uint8_t> out;
+        putString(out, def.name);
+        for (const std::string& equation : def.equations) putString(out, equation);
+        uint32_t count = uint32_t(def.params.size());
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&count);
+        out.insert(out.end(), bytes, bytes + sizeof(count));
+        for (const auto& [name, value] : def.params) {
+            putString(out, name);
+            bytes = reinterpret_cast<const uint8_t*>(&value);
+            out.insert(out.end(), bytes, bytes + sizeof(value));
+        }
+        CustomFields fields{def.isMap ? 1u : 0u, def.native ? 1u : 0u, def.initial, def.zoom};
+        bytes = reinterpret_cast<const uint8_t*>(&fields);
+        out.insert(out.end(), bytes, bytes + sizeof(fields));
+        return out;
+    }
+
+    double now() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    struct Piece {
+        const void* data;
+        size_t bytes;
+    };
+
+    // En-tête puis morceaux ; renvoie les octets écrits (0 en cas d'erreur)
+    uint64_t writeRecord(FILE* f, uint32_t type, std::initializer_list<Piece> pieces) {
+        RecordHeader header{type, 0, 0};
+        for (const Piece& piece : pieces) {
+            header.crc = crc32(header.crc, piece.data, piece.bytes);
+            header.bytes += piece.bytes;
+        }
+        if (std::fwrite(&header, sizeof(header), 1, f) != 1) return 0;
+        for (const Piece& piece : pieces) {
+            if (piece.bytes && std::fwrite(piece.data, 1, piece.bytes, f) != piece.bytes) return 0;
+        }
+        return sizeof(header) + header.bytes;
+    }
+
+    // Enregistrements décrivant changes (full : tout l'état, tampon compris)
+    uint64_t writeState(FILE* f, const SessionState& changes, bool full) {
+        uint64_t total = 0, n;
+        auto add = [&](uint64_t bytes) {
+            total += bytes;
+            return bytes != 0;
+        };
+        if (changes.hasView && !add(writeRecord(f, RecordView, {{&changes.view, sizeof(SessionView)}}))) return 0;
+        if (!changes.system.empty() &&
+            !add(writeRecord(f, RecordSystem, {{changes.system.data(), changes.system.size()}}))) return 0;
+        if (changes.hasCustom) {
+            std::vector<uint8_t> custom = encodeCustom(changes.custom);
+            if (!add(writeRecord(f, RecordCustom, {{custom.data(), custom.size()}}))) return 0;
+        }
+        if ((full || changes.resetPoints) && !add(writeRecord(f, RecordPointsReset, {}))) return 0;
+        if (!changes.points.empty()) {
+            n = writeRecord(f, RecordPoints, {{changes.points.data(), changes.points.size() * sizeof(Point)}});
+            if (!add(n)) return 0;
+        }
+        if (changes.hasPoincare) {
+            const PoincareCheckpoint& c = changes.poincare;
+            int64_t crossings = c.crossings;
+            uint32_t sizes[4] = {c.running ? 1u : 0u, uint32_t(c.image.width), uint32_t(c.image.height),
+                                 uint32_t(c.trajectories.size())};
+            n = writeRecord(f, RecordPoincare, {{&c.settings, sizeof(PoincareSettings)},
+                                                {&crossings, sizeof(crossings)},
+                                                {&c.seconds, sizeof(double)},
+                                                {sizes, sizeof(sizes)},
+                                                {c.image.counts.data(), c.image.counts.size() * sizeof(uint32_t)},
+                                                {c.trajectories.data(), c.trajectories.size() * sizeof(Point)}});
+            if (!add(n)) return 0;
+        }
+        if (changes.hasBifurcation) {
+            const BifurcationCheckpoint& c = changes.bifurcation;
+            uint32_t sizes[2] = {uint32_t(c.image.width), uint32_t(c.image.height)};
+            n = writeRecord(f, RecordBifurcation, {{&c.settings, sizeof(BifurcationSettings)},
+                                                   {&c.seconds, sizeof(double)},
+                                                   {sizes, sizeof(sizes)},
+                                                   {c.image.counts.data(), c.image.counts.size() * sizeof(uint32_t)},
+                                                   {c.columns.data(), c.columns.size()}});
+            if (!add(n)) return 0;
+        }
+        return total;
+    }
+
+    // Taille des enregistrements qu'écrirait writeState(f, state, true)
+    uint64_t stateBytes(const SessionState& state) {
+        uint64_t bytes = 2 * sizeof(RecordHeader) + state.points.size() * sizeof(Point);
+        if (state.hasView) bytes += sizeof(RecordHeader) + sizeof(SessionView);
+        if (!state.system.empty()) bytes += sizeof(RecordHeader) + state.system.size();
+        if (state.hasCustom) bytes += sizeof(RecordHeader) + encodeCustom(state.custom).size();
+        if (state.hasPoincare) {
+            const PoincareCheckpoint& c = state.poincare;
+            bytes += sizeof(RecordHeader) + sizeof(PoincareSettings) + 8 + 8 + 16 +
+                     c.image.counts.size() * sizeof(uint32_t) + c.trajectories.size() * sizeof(Point);
+        }
+        if (state.hasBifurcation) {
+            const BifurcationCheckpoint& c = state.bifurcation;
+            bytes += sizeof(RecordHeader) + sizeof(BifurcationSettings) + 8 + 8 +
+                     c.image.counts.size() * sizeof(uint32_t) + c.columns.size();
+        }
+        return bytes;
+    }
+
+    // Lecture bornée des données d'un enregistrement
+    class Cursor {
+    public:
+        Cursor(const uint8_t* data, size_t bytes) : p(data), end(data + bytes) {}
+
+        bool ok() const { return !overrun; }
+        size_t left() const { return size_t(end - p); }
+
+        void read(void* out, size_t bytes) {
+            if (overrun || bytes > left()) {
+                overrun = true;
+                return;
+            }
+            if (bytes) std::memcpy(out, p, bytes);
+            p += bytes;
+        }
+
+        template <typename T>
+        void read(T& out) { read(&out, sizeof(T)); }
+
+    private:
+        const uint8_t* p;
+        const uint8_t* end;
+        bool overrun = false;
+    };
+
+    bool readString(Cursor& in, std::string& out) {
+        uint32_t size = 0;
+        in.read(size);
+        if (!in.ok() || size > in.left()) return false;
+        out.resize(size);
+        in.read(&out[0], size);
+        return in.ok();
+    }
+
+    bool readCustom(Cursor& in, CustomDefinition& def) {
+        if (!readString(in, def.name)) return false;
+        for (std::string& equation : def.equations) {
+            if (!readString(in, equation)) return false;
+        }
+        uint32_t count = 0;
+        in.read(count);
+        if (!in.ok() || count > kMaxParams) return false;
+        def.params.resize(count);
+        for (auto& [name, value] : def.params) {
+            if (!readString(in, name)) return false;
+            in.read(value);
+        }
+        CustomFields fields;
+        in.read(fields);
+        if (!in.ok() || in.left() != 0) return false;
+        def.isMap = fields.isMap != 0;
+        def.native = fields.native != 0;
+        def.initial = fields.initial;
+        def.zoom = fields.zoom;
+        return true;
+    }
+
+    bool readImage(Cursor& in, DensityImage& image, uint32_t width, uint32_t height) {
+        uint64_t count = uint64_t(width) * height;
+        if (count * sizeof(uint32_t) > in.left()) return false;
+        image.width = int(width);
+        image.height = int(height);
+        image.counts.resize(size_t(count));
+        in.read(image.counts.data(), image.counts.size() * sizeof(uint32_t));
+        return in.ok();
+    }
+
+    // Applique un enregistrement ; faux s'il est mal formé
+    bool applyRecord(uint32_t type, Cursor in, SessionState& out) {
+        switch (type) {
+        case RecordView:
+            in.read(out.view);
+            out.hasView = in.ok();
+            return in.ok();
+        case RecordPointsReset:
+            out.points.clear();
+            return true;
+        case RecordSystem:
+            out.system.resize(in.left());
+            in.read(&out.system[0], out.system.size());
+            return in.ok();
+        case RecordCustom: {
+            CustomDefinition def;
+            if (!readCustom(in, def)) return false;
+            out.custom = std::move(def);
+            out.hasCustom = true;
+            return true;
+        }
+        case RecordPoints: {
+            if (in.left() % sizeof(Point)) return false;
+            size_t at = out.points.size();
+            out.points.resize(at + in.left() / sizeof(Point));
+            in.read(out.points.data() + at, (out.points.size() - at) * sizeof(Point));
+            return in.ok();
+        }
+        case RecordPoincare: {
+            PoincareCheckpoint c;
+            int64_t crossings = 0;
+            uint32_t sizes[4] = {};
+            in.read(c.settings);
+            in.read(crossings);
+            in.read(c.seconds);
+            in.read(sizes);
+            if (!in.ok() || !readImage(in, c.image, sizes[1], sizes[2])) return false;
+            if (uint64_t(sizes[3]) * sizeof(Point) != in.left()) return false;
+            c.crossings = long(crossings);
+            c.running = sizes[0] != 0;
+            c.trajectories.resize(sizes[3]);
+            in.read(c.trajectories.data(), c.trajectories.size() * sizeof(Point));
+            out.poincare = std::move(c);
+            out.hasPoincare = true;
+            return true;
+        }
+        case RecordBifurcation: {
+            BifurcationCheckpoint c;
+            uint32_t sizes[2] = {};
+            in.read(c.settings);
+            in.read(c.seconds);
+            in.read(sizes);
+            if (!in.ok() || !readImage(in, c.image, sizes[0], sizes[1]) || in.left() != sizes[0]) return false;
+            c.columns.resize(sizes[0]);
+            in.read(c.columns.data(), c.columns.size());
+            out.bifurcation = std::move(c);
+            out.hasBifurcation = true;
+            return true;
+        }
+        default:
+            return true;        // Type inconnu (version plus récente) : ignoré
+        }
+    }
+
+    // Ajoute les changements à un état (sauvegardes fusionnées, état du journal)
+    void merge(SessionState& into, SessionState&& changes) {
+        if (changes.hasView) {
+            into.view = changes.view;
+            into.hasView = true;
+        }
+        if (!changes.system.empty()) into.system = std::move(changes.system);
+        if (changes.hasCustom) {
+            into.custom = std::move(changes.custom);
+            into.hasCustom = true;
+        }
+        if (changes.resetPoints) {
+            into.points = std::move(changes.points);
+            into.resetPoints = true;
+        } else {
+            into.points.insert(into.points.end(), changes.points.begin(), changes.points.end());
+        }
+        if (changes.hasPoincare) {
+            into.poincare = std::move(changes.poincare);
+            into.hasPoincare = true;
+        }
+        if (changes.hasBifurcation) {
+            into.bifurcation = std::move(changes.bifurcation);
+            into.hasBifurcation = true;
+        }
+    }
+}
+
+bool loadSession(const std::string& path, SessionState& out) {
+    out = SessionState();
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+    // Lu d'un seul tenant : les points sont recopiés une seule fois
+    std::vector<uint8_t> data;
+    std::fseek(f, 0, SEEK_END);
+    long size = std::ftell(f);
+    std::fseek(f, 0, SEEK_SET);
+    data.resize(size > 0 ? size_t(size) : 0);
+    data.resize(std::fread(data.data(), 1, data.size(), f));
+    std::fclose(f);
+
+    FileHeader header;
+    if (data.size() < sizeof(header)) return false;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, kSessionMagic, sizeof(kSessionMagic)) || header.version != kSessionVersion) return false;
+
+    size_t at = sizeof(header);
+    while (data.size() - at >= sizeof(RecordHeader)) {
+        RecordHeader record;
+        std::memcpy(&record, data.data() + at, sizeof(record));
+        at += sizeof(record);
+        if (record.bytes > data.size() - at) break;             // Fin tronquée
+        const uint8_t* payload = data.data() + at;
+        if (crc32(0, payload, size_t(record.bytes)) != record.crc) break;
+        if (!applyRecord(record.type, Cursor(payload, size_t(record.bytes)), out)) break;
+        at += size_t(record.bytes);
+    }
+    out.resetPoints = true;
+    return true;
+}
+
+SessionWriter::~SessionWriter() {
+    close();
+}
+
+void SessionWriter::open(const std::string& filePath, SessionState initial) {
+    close();
+    path = filePath;
+    live = std::move(initial);
+    current = SessionStats();
+    stopRequested = false;
+    // Premier tour du thread : réécriture complète de l'état initial
+    pending = SessionState();
+    hasPending = true;
+    fileBytes = 0;
+    thread = std::thread(&SessionWriter::writerLoop, this);
+}
+
+void SessionWriter::close() {
+    if (!thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopRequested = true;
+    }
+    wake.notify_one();
+    thread.join();
+    if (file) std::fclose(file);
+    file = nullptr;
+    live = SessionState();
+}
+
+void SessionWriter::save(SessionState&& changes) {
+    if (!thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        merge(pending, std::move(changes));
+        hasPending = true;
+    }
+    wake.notify_one();
+}
+
+bool SessionWriter::busy() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return writing || hasPending;
+}
+
+SessionStats SessionWriter::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return current;
+}
+
+void SessionWriter::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        // stop() n'interrompt pas la dernière sauvegarde demandée
+        wake.wait(lock, [&] { return hasPending || stopRequested; });
+        if (!hasPending) break;
+        SessionState changes = std::move(pending);
+        pending = SessionState();
+        hasPending = false;
+        writing = true;
+        lock.unlock();
+
+        double start = now();
+        bool ok = !file || append(changes);
+        merge(live, std::move(changes));
+        // Journal absent (premier tour, erreur précédente) ou trop long
+        if (!file || !ok || fileBytes > 2 * stateBytes(live) + kCompactSlack) ok = compact();
+
+        lock.lock();
+        writing = false;
+        current.saves++;
+        current.fileBytes = fileBytes;
+        current.lastSeconds = now() - start;
+        current.failed = !ok;
+    }
+}
+
+bool SessionWriter::append(const SessionState& changes) {
+    uint64_t bytes = writeState(file, changes, false);
+    if (std::fflush(file) != 0) bytes = 0;
+    fileBytes += bytes;
+    return bytes != 0 || (!changes.hasView && !changes.hasCustom && changes.points.empty() && !changes.resetPoints &&
+                          !changes.hasPoincare && !changes.hasBifurcation);
+}
+
+bool SessionWriter::compact() {
+    if (file) std::fclose(file);
+    file = nullptr;
+
+    // Journal neuf écrit à côté puis renommé : l'ancien reste valide jusque-là
+    std::string tmp = path + ".tmp";
+    FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) return false;
+    FileHeader header{};
+    std::memcpy(header.magic, kSessionMagic, sizeof(kSessionMagic));
+    header.version = kSessionVersion;
+    bool ok = std::fwrite(&header, sizeof(header), 1, f) == 1;
+    uint64_t bytes = ok ? writeState(f, live, true) : 0;
+    ok = bytes != 0 && std::fflush(f) == 0;
+    std::fclose(f);
+#ifdef _WIN32
+    if (ok) std::remove(path.c_str());      // rename() ne remplace pas sous Windows
+#endif
+    if (!ok || std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    file = std::fopen(path.c_str(), "ab");
+    fileBytes = sizeof(header) + bytes;
+    return file != nullptr;
+}
+/**
+ * Session.cpp
+ *
+ * Contient le journal de session : enregistrements vérifiés par CRC, écriture
+ * incrémentale par un thread dédié, réécriture complète et relecture.
+ */
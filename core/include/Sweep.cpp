@@ -0,0 +1,259 @@
+#include "Sweep.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <thread>
+#include "Lanes.h"
+#include "Npy.h"
+#include "Utils.h"
+
+namespace {
+    constexpr int W = 8;   // Cellules calculées ensemble (2 x AVX ou 4 x SSE en float)
+
+    template <int Type, typename S>
+    void lyapunovGroup(const SweepSettings& s, const Lanes<S, W>* k, float* out) {
+        using Pack = Lanes<S, W>;
+        const SystemInfo& sys = Attractor::info(Type);
+        const S dt = sys.isMap ? S(1) : S(s.dt);
+        const Pack h(dt);
+
+        Vec3<Pack> p{Pack(s.initial.x), Pack(s.initial.y), Pack(s.initial.z)};
+        for (long i = 0; i < s.transient; i++) step<Type>(k, p, h);
+
+        // Un seul vecteur tangent : plus grand exposant
+        const S v0 = sys.dim == 3 ? S(0.57735026918962576) : S(0.70710678118654752);
+        Vec3<Pack> v{Pack(v0), Pack(v0), Pack(sys.dim == 3 ? v0 : S(0))};
+        double sums[W] = {};
+        long measured = 0;
+
+        for (long n = 1; n <= s.steps; n++) {
+            // Pas d'Euler et v <- (I + h J) v sur une seule évaluation du champ
+            Vec3<Pack> jv[1] = {v};
+            Vec3<Pack> f = tangents<Type>(k, p, jv);
+            p.x += f.x * h;
+            p.y += f.y * h;
+            p.z += f.z * h;
+            v.x += h * jv[0].x;
+            v.y += h * jv[0].y;
+            v.z += h * jv[0].z;
+
+            if (n % s.orthoInterval == 0) {
+                Pack norm = sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+                Pack inv = Pack(S(1)) / norm;
+                v.x *= inv; v.y *= inv; v.z *= inv;
+                bool alive = false;
+                for (int l = 0; l < W; l++) {
+                    sums[l] += std::log(norm[l]);
+                    alive |= std::isfinite(sums[l]);
+                }
+                measured = n;
+                if (!alive) break;   // Toutes les cellules ont divergé
+            }
+        }
+        for (int l = 0; l < W; l++) {
+            bool ok = std::isfinite(p.x[l]) && std::isfinite(p.y[l]) && std::isfinite(p.z[l])
+                && std::isfinite(sums[l]) && measured > 0;
+            out[l] = ok ? float(sums[l] / (double(measured) * dt)) : std::numeric_limits<float>::quiet_NaN();
+        }
+    }
+
+    template <int Type, typename S>
+    void periodGroup(const SweepSettings& s, const Lanes<S, W>* k, float* out) {
+        using Pack = Lanes<S, W>;
+        const SystemInfo& sys = Attractor::info(Type);
+        const S dt = sys.isMap ? S(1) : S(s.dt);
+        const Pack h(dt);
+        const int maxPeriod = std::max(1, s.maxPeriod);
+
+        Vec3<Pack> p{Pack(s.initial.x), Pack(s.initial.y), Pack(s.initial.z)};
+        for (long i = 0; i < s.transient; i++) step<Type>(k, p, h);
+
+        int period[W];
+        for (int l = 0; l < W; l++) period[l] = 0;
+
+        if (sys.isMap) {
+            // Application : premier retour au point de référence
+            Vec3<Pack> ref = p;
+            for (int n = 1; n <= maxPeriod; n++) {
+                step<Type>(k, p, h);
+                for (int l = 0; l < W; l++) {
+                    if (period[l]) continue;
+                    S d = std::max(std::fabs(p.x[l] - ref.x[l]), std::fabs(p.y[l] - ref.y[l]));
+                    if (d < s.periodTolerance * (S(1) + std::fabs(ref.x[l]))) period[l] = n;
+                }
+            }
+        } else {
+            // Flot : suite des maxima locaux de x, période = plus petit décalage
+            // qui la laisse invariante
+            const int needed = 2 * maxPeriod + 1;
+            std::vector<S> maxima(size_t(W) * needed);
+            int count[W] = {};
+            Pack x0 = p.x;
+            step<Type>(k, p, h);
+            Pack x1 = p.x;
+            for (long n = 0; n < s.steps; n++) {
+                step<Type>(k, p, h);
+                const Pack& x2 = p.x;
+                bool done = true;
+                for (int l = 0; l < W; l++) {
+                    if (count[l] < needed && x1[l] > x0[l] && x1[l] >= x2[l]) {
+                        // Sommet de la parabole passant par les trois derniers points
+                        S a = S(0.5) * (x0[l] + x2[l]) - x1[l];
+                        S b = S(0.5) * (x2[l] - x0[l]);
+                        S m = a < S(0) ? x1[l] - b * b / (S(4) * a) : x1[l];
+                        maxima[size_t(l) * needed + count[l]++] = m;
+                    }
+                    done &= count[l] >= needed;
+                }
+                x0 = x1;
+                x1 = x2;
+                if (done) break;
+            }
+            for (int l = 0; l < W; l++) {
+                const S* m = &maxima[size_t(l) * needed];
+                for (int q = 1; q <= maxPeriod && 2 * q <= count[l]; q++) {
+                    bool match = true;
+                    for (int i = 0; i + q < count[l] && match; i++) {
+                        match = std::fabs(m[i] - m[i + q]) < s.periodTolerance * (S(1) + std::fabs(m[i]));
+                    }
+                    if (match) { period[l] = q; break; }
+                }
+            }
+        }
+        for (int l = 0; l < W; l++) {
+            bool ok = std::isfinite(p.x[l]) && std::isfinite(p.y[l]) && std::isfinite(p.z[l]);
+            out[l] = ok ? float(period[l]) : std::numeric_limits<float>::quiet_NaN();
+        }
+    }
+
+    template <int Type, typename S>
+    void sweepRows(const SweepSettings& s, SweepResult& r, std::atomic<int>& nextRow, SweepProgress* progress) {
+        using Pack = Lanes<S, W>;
+        const float sx = s.width > 1 ? (s.xMax - s.xMin) / float(s.width - 1) : 0.0f;
+        const float sy = s.height > 1 ? (s.yMax - s.yMin) / float(s.height - 1) : 0.0f;
+        Utils::FlushDenormals ftz;
+        Pack k[kMaxParams];
+        float out[W];
+
+        for (int row = nextRow++; row < s.height; row = nextRow++) {
+            if (progress && progress->cancel) return;
+            for (int col = 0; col < s.width; col += W) {
+                for (int i = 0; i < kMaxParams; i++) k[i] = Pack(s.params[i]);
+                k[s.paramY] = Pack(s.yMin + sy * float(row));
+                for (int l = 0; l < W; l++) {
+                    int c = std::min(col + l, s.width - 1);   // Dernier groupe : cellules dupliquées
+                    k[s.paramX][l] = s.xMin + sx * float(c);
+                }
+                if (s.mode == SweepMode::Lyapunov) lyapunovGroup<Type, S>(s, k, out);
+                else periodGroup<Type, S>(s, k, out);
+                for (int l = 0; l < W && col + l < s.width; l++) {
+                    r.values[size_t(row) * s.width + col + l] = out[l];
+                }
+            }
+            if (progress) progress->rowsDone++;
+        }
+    }
+
+    void hueToRgb(float h, unsigned char* rgb) {
+        float r = std::fabs(h * 6.0f - 3.0f) - 1.0f;
+        float g = 2.0f - std::fabs(h * 6.0f - 2.0f);
+        float b = 2.0f - std::fabs(h * 6.0f - 4.0f);
+        rgb[0] = (unsigned char)(255.0f * std::clamp(r, 0.0f, 1.0f));
+        rgb[1] = (unsigned char)(255.0f * std::clamp(g, 0.0f, 1.0f));
+        rgb[2] = (unsigned char)(255.0f * std::clamp(b, 0.0f, 1.0f));
+    }
+}
+
+SweepSettings::SweepSettings(int type) : type(type) {
+    const SystemInfo& sys = Attractor::info(type);
+    for (int i = 0; i < kMaxParams; i++) params[i] = sys.paramDefaults[i];
+    initial = sys.initial;
+}
+
+SweepResult runSweep(const SweepSettings& settings, SweepProgress* progress) {
+    SweepResult r;
+    r.width = std::max(0, settings.width);
+    r.height = std::max(0, settings.height);
+    r.mode = settings.mode;
+    r.values.assign(size_t(r.width) * r.height, std::numeric_limits<float>::quiet_NaN());
+    const SystemInfo& sys = Attractor::info(settings.type);
+    if (r.width == 0 || r.height == 0 || settings.paramX < 0 || settings.paramY < 0
+        || settings.paramX >= sys.paramCount || settings.paramY >= sys.paramCount) {
+        return r;
+    }
+
+    int threads = settings.threads > 0 ? settings.threads : int(std::thread::hardware_concurrency());
+    threads = std::clamp(threads, 1, r.height);
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::atomic<int> nextRow{0};
+    dispatchPrecision(settings.precision, [&](auto scalar) {
+        using S = decltype(scalar);
+        dispatchSystem(settings.type, [&](auto tag) {
+            constexpr int Type = decltype(tag)::value;
+            std::vector<std::thread> pool;
+            for (int t = 1; t < threads; t++) {
+                pool.emplace_back([&] { sweepRows<Type, S>(settings, r, nextRow, progress); });
+            }
+            sweepRows<Type, S>(settings, r, nextRow, progress);
+            for (std::thread& th : pool) th.join();
+        });
+    });
+    r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return r;
+}
+
+bool writeSweepImage(const SweepResult& result, const std::string& path) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    std::fprintf(f, "P6\n%d %d\n255\n", result.width, result.height);
+
+    float lo = 0.0f, hi = 0.0f;
+    for (float v : result.values) {
+        if (std::isnan(v)) continue;
+        lo = std::min(lo, v);
+        hi = std::max(hi, v);
+    }
+    std::vector<unsigned char> line(size_t(result.width) * 3);
+    // L'image est écrite du haut (y max) vers le bas
+    for (int row = result.height - 1; row >= 0; row--) {
+        for (int col = 0; col < result.width; col++) {
+            float v = result.values[size_t(row) * result.width + col];
+            unsigned char* px = &line[size_t(col) * 3];
+            if (std::isnan(v)) {
+                px[0] = px[1] = px[2] = 0;
+            } else if (result.mode == SweepMode::Period) {
+                if (v < 1.0f) { px[0] = px[1] = px[2] = 40; }
+                else hueToRgb(std::fmod((v - 1.0f) * 0.618034f, 1.0f), px);
+            } else if (v < 0.0f) {
+                float t = lo < 0.0f ? std::sqrt(v / lo) : 0.0f;
+                px[0] = 0; px[1] = (unsigned char)(80.0f * t); px[2] = (unsigned char)(60.0f + 195.0f * t);
+            } else {
+                float t = hi > 0.0f ? std::sqrt(v / hi) : 0.0f;
+                px[0] = 255; px[1] = (unsigned char)(255.0f * (1.0f - 0.7f * t)); px[2] = (unsigned char)(120.0f * (1.0f - t));
+            }
+        }
+        std::fwrite(line.data(), 1, line.size(), f);
+    }
+    return std::fclose(f) == 0;
+}
+
+bool writeSweepRaw(const SweepResult& result, const std::string& path) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    size_t n = std::fwrite(result.values.data(), sizeof(float), result.values.size(), f);
+    return std::fclose(f) == 0 && n == result.values.size();
+}
+
+bool writeSweepNpy(const SweepResult& result, const std::string& path) {
+    return writeNpy(path, NpyType::Float32, {uint64_t(result.height), uint64_t(result.width)}, result.values.data());
+}
+/**
+ * Sweep.cpp
+ *
+ * Contient l'implémentation du balayage de paramètres : les lignes de la grille
+ * sont réparties entre les threads, les cellules d'une ligne sont calculées par
+ * paquets de 8 avec les noyaux de Systems.h.
+ */
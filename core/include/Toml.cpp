@@ -0,0 +1,232 @@
+#include "Toml.h"
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+    // Tableaux imbriqués au plus : une ligne hostile ne doit pas épuiser la pile
+    constexpr int kMaxDepth = 64;
+
+    class Parser {
+    public:
+        explicit Parser(const std::string& text) : s(text) {}
+
+        bool document(Json& out) {
+            out = Json::object();
+            Json* table = &out;
+            for (;;) {
+                blank();
+                if (at >= s.size()) return true;
+                if (s[at] == '[') {
+                    if (!header(out, table)) return false;
+                } else if (!keyValue(*table)) {
+                    return false;
+                }
+                if (!endOfLine()) return false;
+            }
+        }
+
+        std::string error;
+
+    private:
+        bool fail(const std::string& message) {
+            if (error.empty()) {
+                int line = 1;
+                for (size_t i = 0; i < at && i < s.size(); i++) line += s[i] == '\n';
+                error = "ligne " + std::to_string(line) + " : " + message;
+            }
+            return false;
+        }
+
+        void spaces() {
+            while (at < s.size() && (s[at] == ' ' || s[at] == '\t')) at++;
+        }
+
+        // Espaces, fins de ligne et commentaires
+        void blank() {
+            for (;;) {
+                spaces();
+                if (at < s.size() && s[at] == '#') {
+                    while (at < s.size() && s[at] != '\n') at++;
+                } else if (at < s.size() && (s[at] == '\n' || s[at] == '\r')) {
+                    at++;
+                } else {
+                    return;
+                }
+            }
+        }
+
+        bool endOfLine() {
+            spaces();
+            if (at < s.size() && s[at] == '#') {
+                while (at < s.size() && s[at] != '\n') at++;
+            }
+            if (at < s.size() && s[at] == '\r') at++;
+            if (at >= s.size() || s[at] == '\n') return true;
+            return fail("fin de ligne attendue");
+        }
+
+        static bool bareChar(char c) {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-';
+        }
+
+        bool key(std::string& out) {
+            spaces();
+            if (at < s.size() && (s[at] == '"' || s[at] == '\'')) return string(out);
+            size_t begin = at;
+            while (at < s.size() && bareChar(s[at])) at++;
+            if (at == begin) return fail("clé attendue");
+            out = s.substr(begin, at - begin);
+            spaces();
+            if (at < s.size() && s[at] == '.') return fail("clés pointées non prises en charge");
+            return true;
+        }
+
+        bool header(Json& root, Json*& table) {
+            bool list = s.compare(at, 2, "[[") == 0;
+            at += list ? 2 : 1;
+            std::string name;
+            if (!key(name)) return false;
+            spaces();
+            if (s.compare(at, list ? 2 : 1, list ? "]]" : "]") != 0) return fail(list ? "']]' attendu" : "']' attendu");
+            at += list ? 2 : 1;
+            const Json* existing = root.find(name);
+            if (list) {
+                if (existing && !existing->isArray()) return fail("[[" + name + "]] : " + name + " est déjà une valeur");
+                Json* items = nullptr;
+                for (auto& m : root.members) {
+                    if (m.first == name) items = &m.second;
+                }
+                if (!items) items = &root.set(name, Json::array());
+                table = &items->push(Json::object());
+            } else {
+                if (existing) return fail("[" + name + "] défini deux fois");
+                table = &root.set(name, Json::object());
+            }
+            return true;
+        }
+
+        bool keyValue(Json& table) {
+            std::string name;
+            if (!key(name)) return false;
+            if (at >= s.size() || s[at] != '=') return fail("'=' attendu après " + name);
+            at++;
+            spaces();
+            Json v;
+            if (!value(v, 0)) return false;
+            if (table.find(name)) return fail(name + " défini deux fois");
+            table.set(name, std::move(v));
+            return true;
+        }
+
+        bool value(Json& out, int depth) {
+            if (depth > kMaxDepth) return fail("imbrication trop profonde");
+            if (at >= s.size() || s[at] == '\n' || s[at] == '\r') return fail("valeur attendue");
+            char c = s[at];
+            if (c == '"' || c == '\'') {
+                out = Json("");
+                return string(out.text);
+            }
+            if (c == '[') return array(out, depth);
+            if (c == '{') return fail("tables en ligne non prises en charge");
+            if (s.compare(at, 4, "true") == 0) { at += 4; out = Json(true); return true; }
+            if (s.compare(at, 5, "false") == 0) { at += 5; out = Json(false); return true; }
+            return number(out);
+        }
+
+        bool array(Json& out, int depth) {
+            out = Json::array();
+            at++;
+            for (;;) {
+                blank();
+                if (at < s.size() && s[at] == ']') { at++; return true; }
+                Json item;
+                if (!value(item, depth + 1)) return false;
+                out.items.push_back(std::move(item));
+                blank();
+                if (at < s.size() && s[at] == ',') { at++; continue; }
+                if (at < s.size() && s[at] == ']') { at++; return true; }
+                return fail("',' ou ']' attendu");
+            }
+        }
+
+        static void utf8(unsigned code, std::string& out) {
+            if (code < 0x80) {
+                out += char(code);
+            } else if (code < 0x800) {
+                out += char(0xC0 | code >> 6);
+                out += char(0x80 | (code & 0x3F));
+            } else {
+                out += char(0xE0 | code >> 12);
+                out += char(0x80 | (code >> 6 & 0x3F));
+                out += char(0x80 | (code & 0x3F));
+            }
+        }
+
+        // "..." avec échappements, '...' tel quel ; sur une seule ligne
+        bool string(std::string& out) {
+            const char quote = s[at++];
+            for (;;) {
+                if (at >= s.size() || s[at] == '\n') return fail("chaîne non terminée");
+                char c = s[at++];
+                if (c == quote) return true;
+                if (c != '\\' || quote == '\'') { out += c; continue; }
+                if (at >= s.size()) return fail("chaîne non terminée");
+                c = s[at++];
+                switch (c) {
+                case '"': case '\\': out += c; break;
+                case 'n': out += '\n'; break;
+                case 't': out += '\t'; break;
+                case 'r': out += '\r'; break;
+                case 'u': {
+                    unsigned code = 0;
+                    for (int i = 0; i < 4; i++, at++) {
+                        char h = at < s.size() ? s[at] : 0;
+                        code <<= 4;
+                        if (h >= '0' && h <= '9') code |= unsigned(h - '0');
+                        else if (h >= 'a' && h <= 'f') code |= unsigned(h - 'a' + 10);
+                        else if (h >= 'A' && h <= 'F') code |= unsigned(h - 'A' + 10);
+                        else return fail("\\u invalide");
+                    }
+                    utf8(code, out);
+                    break;
+                }
+                default: return fail(std::string("échappement inconnu \\") + c);
+                }
+            }
+        }
+
+        // 10, -3, 1_000_000, 0.01, 6.02e23 ; pas de inf, nan ni hexadécimal
+        bool number(Json& out) {
+            std::string digits;
+            size_t i = at;
+            for (; i < s.size(); i++) {
+                char c = s[i];
+                if (c == '_') continue;
+                if (!((c >= '0' && c <= '9') || c == '+' || c == '-' || c == '.' || c == 'e' || c == 'E')) break;
+                digits += c;
+            }
+            if (digits.empty() || (i < s.size() && bareChar(s[i]))) return fail("valeur inconnue");
+            char* end = nullptr;
+            double v = std::strtod(digits.c_str(), &end);
+            if (end != digits.c_str() + digits.size() || !std::isfinite(v)) return fail("nombre invalide : " + digits);
+            at = i;
+            out = Json(v);
+            return true;
+        }
+
+        const std::string& s;
+        size_t at = 0;
+    };
+}
+
+bool parseToml(const std::string& text, Json& out, std::string& error) {
+    Parser parser(text);
+    if (parser.document(out)) return true;
+    error = parser.error;
+    return false;
+}
+/**
+ * Toml.cpp
+ *
+ * Contient l'analyse du sous-ensemble de TOML des fichiers de tâches.
+ */
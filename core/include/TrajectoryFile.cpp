@@ -0,0 +1,467 @@
+#include "TrajectoryFile.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include "DeltaCodec.h"
+#include "Npy.h"
+
+namespace {
+    // Paliers d'agrandissement du fichier : chaque agrandissement reprojette
+    // le fichier, ils doivent rester rares
+    constexpr uint64_t kGrowMin = uint64_t(64) << 20;
+    constexpr uint64_t kGrowMax = uint64_t(1) << 30;
+
+    uint64_t alignUp(uint64_t v, uint64_t a) {
+        return (v + a - 1) / a * a;
+    }
+
+    template <typename S>
+    void convertColumn(const void* column, uint64_t from, size_t count, float Point::*member, Point* out) {
+        const S* values = static_cast<const S*>(column) + from;
+        for (size_t i = 0; i < count; i++) out[i].*member = float(values[i]);
+    }
+
+    template <typename S>
+    bool encodeDelta(const void* const columns[3], int dims, size_t count, double quantum, std::vector<uint8_t>& out) {
+        for (int axis = 0; axis < dims; axis++) {
+            if (!deltaEncodable(static_cast<const S*>(columns[axis]), count, quantum)) return false;
+        }
+        DeltaChunkHeader info{};
+        info.quantum = quantum;
+        out.assign(sizeof(info), 0);
+        for (int axis = 0; axis < dims; axis++) {
+            size_t before = out.size();
+            deltaEncode(static_cast<const S*>(columns[axis]), count, quantum, out);
+            info.axisBytes[axis] = uint32_t(out.size() - before);
+        }
+        std::memcpy(out.data(), &info, sizeof(info));
+        // Sans gain (bruit, valeurs énormes...), le bloc reste brut
+        return out.size() < count * sizeof(S) * size_t(dims);
+    }
+
+    template <typename S>
+    bool decodeDelta(const uint8_t* data, uint64_t bytes, size_t count, int axis, void* out) {
+        DeltaChunkHeader info;
+        if (bytes < sizeof(info)) return false;
+        std::memcpy(&info, data, sizeof(info));
+        uint64_t offset = sizeof(info);
+        for (int a = 0; a < axis; a++) offset += info.axisBytes[a];
+        if (offset + info.axisBytes[axis] > bytes) return false;
+        return deltaDecode(data + offset, info.axisBytes[axis], count, info.quantum, static_cast<S*>(out));
+    }
+
+    // Exécute work(i) pour i dans [0, count) sur au plus threads threads
+    template <typename F>
+    void parallelFor(size_t count, int threads, F work) {
+        if (threads <= 0) threads = int(std::max(1u, std::thread::hardware_concurrency()));
+        threads = int(std::min<size_t>(size_t(threads), count));
+        if (threads <= 1) {
+            for (size_t i = 0; i < count; i++) work(i);
+            return;
+        }
+        std::atomic<size_t> next{0};
+        auto loop = [&] {
+            for (size_t i = next++; i < count; i = next++) work(i);
+        };
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; t++) pool.emplace_back(loop);
+        loop();
+        for (std::thread& th : pool) th.join();
+    }
+}
+
+TrajectoryHeader makeTrajectoryHeader(const Attractor& source, Integrator integrator, Precision storage) {
+    const SystemInfo& sys = Attractor::info(source.type);
+    TrajectoryHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, kTrajectoryMagic, sizeof(h.magic));
+    h.version = kTrajectoryVersion;
+    h.headerSize = sizeof(TrajectoryHeader);
+    h.systemType = source.type;
+    if (sys.isMap) integrator = Integrator::Euler;
+    h.integrator = int32_t(integrator);
+    h.taylorOrder = integrator == Integrator::Taylor ? uint32_t(source.taylorOrder) : 0;
+    h.dims = sys.dim;
+    h.scalarSize = storage == Precision::Double ? sizeof(double) : sizeof(float);
+    h.dt = sys.isMap ? 1.0 : source.dt;
+    for (int i = 0; i < kMaxParams; i++) h.params[i] = source.params[i];
+    h.initial[0] = source.p.x;
+    h.initial[1] = source.p.y;
+    h.initial[2] = source.p.z;
+    return h;
+}
+
+bool headerDescribes(const TrajectoryHeader& header, const Attractor& source) {
+    const TrajectoryHeader now = makeTrajectoryHeader(source, source.integrator, source.precision);
+    return header.systemType == now.systemType && header.integrator == now.integrator
+        && header.taylorOrder == now.taylorOrder && header.scalarSize == now.scalarSize;
+}
+
+bool TrajectoryWriter::open(const std::string& path, const TrajectoryHeader& h) {
+    close();
+    if (!file.create(path) || !reserve(sizeof(TrajectoryHeader))) {
+        file.close();
+        return false;
+    }
+    std::memcpy(file.data(), &h, sizeof(h));
+    if (h.codec != uint32_t(ChunkCodec::Delta) || !(h.quantum > 0.0)) header().codec = uint32_t(ChunkCodec::Raw);
+    header().version = kTrajectoryVersion;
+    header().headerSize = sizeof(TrajectoryHeader);
+    header().pointCount = 0;
+    header().chunkCount = 0;
+    header().dataEnd = sizeof(TrajectoryHeader);
+    nextStep = 0;
+    minStep = 0;
+    return true;
+}
+
+bool TrajectoryWriter::reserve(uint64_t end) {
+    if (end <= file.size()) return true;
+    uint64_t grow = std::clamp(file.size() / 2, kGrowMin, kGrowMax);
+    return file.resize(alignUp(std::max(end, file.size() + grow), kGrowMin));
+}
+
+bool TrajectoryWriter::append(const void* x, const void* y, const void* z, size_t count, uint32_t stride,
+                              uint64_t firstStep) {
+    if (!isOpen() || count == 0) return isOpen();
+    const void* columns[3] = {x, y, z};
+    if (header().codec == uint32_t(ChunkCodec::Delta)) {
+        if (encoded.empty()) encoded.resize(1);
+        if (encode(columns, count, encoded[0])) {
+            const void* parts[1] = {encoded[0].data()};
+            const uint64_t sizes[1] = {encoded[0].size()};
+            return writeChunk(ChunkCodec::Delta, parts, sizes, 1, count, stride, firstStep);
+        }
+    }
+    const uint64_t column = uint64_t(count) * uint64_t(header().scalarSize);
+    const uint64_t sizes[3] = {column, column, column};
+    return writeChunk(ChunkCodec::Raw, columns, sizes, header().dims, count, stride, firstStep);
+}
+
+size_t TrajectoryWriter::append(TrajectoryBuffer* const* buffers, size_t count, int threads) {
+    if (!isOpen()) return 0;
+    if (header().codec != uint32_t(ChunkCodec::Delta)) {
+        for (size_t i = 0; i < count; i++) {
+            if (!append(*buffers[i])) return i;
+        }
+        return count;
+    }
+
+    // Codage en parallèle (chaque bloc a son tampon), écriture dans l'ordre
+    if (encoded.size() < count) encoded.resize(count);
+    std::vector<uint8_t> compressed(count);
+    parallelFor(count, threads, [&](size_t i) {
+        const TrajectoryBuffer& b = *buffers[i];
+        const void* columns[3] = {b.column(0), b.column(1), b.column(2)};
+        compressed[i] = b.count > 0 && encode(columns, b.count, encoded[i]);
+    });
+    for (size_t i = 0; i < count; i++) {
+        const TrajectoryBuffer& b = *buffers[i];
+        if (b.count == 0) continue;
+        bool ok;
+        if (compressed[i]) {
+            const void* parts[1] = {encoded[i].data()};
+            const uint64_t sizes[1] = {encoded[i].size()};
+            ok = writeChunk(ChunkCodec::Delta, parts, sizes, 1, b.count, b.stride, b.firstStep);
+        } else {
+            // Incompressible : déjà essayé en parallèle, écrit brut sans
+            // recoder sur ce fil
+            const void* columns[3] = {b.column(0), b.column(1), b.column(2)};
+            const uint64_t column = uint64_t(b.count) * uint64_t(header().scalarSize);
+            const uint64_t sizes[3] = {column, column, column};
+            ok = writeChunk(ChunkCodec::Raw, columns, sizes, header().dims, b.count, b.stride, b.firstStep);
+        }
+        if (!ok) return i;
+    }
+    return count;
+}
+
+bool TrajectoryWriter::encode(const void* const columns[3], size_t count, std::vector<uint8_t>& out) const {
+    const TrajectoryHeader& h = header();
+    if (h.scalarSize == 8) return encodeDelta<double>(columns, h.dims, count, h.quantum, out);
+    return encodeDelta<float>(columns, h.dims, count, h.quantum, out);
+}
+
+bool TrajectoryWriter::writeChunk(ChunkCodec codec, const void* const parts[], const uint64_t sizes[],
+                                  int partCount, size_t count, uint32_t stride, uint64_t firstStep) {
+    // Pas strictement croissants d'un point au suivant : la lecture le vérifie
+    stride = std::clamp<uint32_t>(stride, 1, 65535);
+    if (firstStep == kNextStep) firstStep = nextStep;
+    firstStep = std::max(firstStep, minStep);
+    uint64_t bytes = 0;
+    for (int i = 0; i < partCount; i++) bytes += sizes[i];
+    const uint64_t start = header().dataEnd;
+    const uint64_t end = alignUp(start + sizeof(TrajectoryChunkHeader) + bytes, kChunkAlign);
+    if (!reserve(end)) return false;
+
+    uint8_t* base = file.data();
+    TrajectoryChunkHeader chunk = {kChunkMagic, uint16_t(codec), uint16_t(stride),
+                                   count, header().pointCount, bytes, firstStep, 0};
+    std::memcpy(base + start, &chunk, sizeof(chunk));
+    uint8_t* data = base + start + sizeof(chunk);
+    for (int i = 0; i < partCount; i++) {
+        std::memcpy(data, parts[i], sizes[i]);
+        data += sizes[i];
+    }
+
+    // L'en-tête n'annonce le bloc qu'une fois ses données copiées : un fichier
+    // interrompu reste lisible jusqu'au dernier bloc complet
+    header().pointCount += count;
+    header().chunkCount++;
+    header().dataEnd = end;
+    nextStep = firstStep + uint64_t(count) * stride;
+    minStep = nextStep - stride + 1;
+    file.flush(start, end - start);
+    return true;
+}
+
+void TrajectoryWriter::close() {
+    if (!file.isOpen()) return;
+    uint64_t end = header().dataEnd;
+    file.close(end);
+}
+
+// Données suffisantes pour les points annoncés : brut, count * dims
+// scalaires ; Delta, l'en-tête et au moins un bit par valeur (codage de Rice)
+bool TrajectoryReader::chunkSizeValid(const TrajectoryChunkHeader& chunk) const {
+    switch (ChunkCodec(chunk.codec)) {
+    case ChunkCodec::Raw:
+        return chunk.count <= chunk.bytes / (uint64_t(info.dims) * uint64_t(info.scalarSize));
+    case ChunkCodec::Delta:
+        return chunk.bytes >= sizeof(DeltaChunkHeader)
+            && chunk.count <= (chunk.bytes - sizeof(DeltaChunkHeader)) * 8 / uint64_t(info.dims);
+    }
+    return false;   // Codage inconnu
+}
+
+bool TrajectoryReader::open(const std::string& path) {
+    close();
+    if (!file.openRead(path)) {
+        lastError = "ouverture impossible";
+        return false;
+    }
+    if (file.size() < sizeof(TrajectoryHeader)) {
+        lastError = "fichier trop court";
+        close();
+        return false;
+    }
+    std::memcpy(&info, file.data(), sizeof(info));
+    if (std::memcmp(info.magic, kTrajectoryMagic, sizeof(info.magic)) != 0) {
+        lastError = "pas un fichier de trajectoire";
+        close();
+        return false;
+    }
+    if (info.version > kTrajectoryVersion || info.headerSize < sizeof(TrajectoryHeader)
+        || (info.dims != 2 && info.dims != 3) || (info.scalarSize != 4 && info.scalarSize != 8)) {
+        lastError = "version ou en-tête non pris en charge";
+        close();
+        return false;
+    }
+
+    // Parcours des en-têtes de blocs jusqu'à dataEnd (ou la fin du fichier),
+    // lus par readAt : projeter leurs pages chargerait aussi les données
+    // voisines. Ensuite, seules les fenêtres demandées sont chargées.
+    file.adviseRandom();
+    const uint64_t chunkHeaderSize = info.version >= 3 ? sizeof(TrajectoryChunkHeader) : kLegacyChunkHeaderSize;
+    uint64_t end = std::min<uint64_t>(info.dataEnd, file.size());
+    uint64_t pos = alignUp(info.headerSize, kChunkAlign);
+    while (pos + chunkHeaderSize <= end) {
+        TrajectoryChunkHeader chunk{};
+        if (!file.readAt(pos, &chunk, chunkHeaderSize)) break;
+        uint64_t data = pos + chunkHeaderSize;
+        if (chunk.magic != kChunkMagic || chunk.bytes > end - data || !chunkSizeValid(chunk)) break;
+        // Avant la version 3, pas supposés contigus d'un bloc au suivant ; un
+        // bloc qui recule dans le temps arrête l'index comme un bloc illisible
+        const uint64_t firstStep = info.version >= 3 ? chunk.firstStep : stepOf(points);
+        if (points > 0 && firstStep <= stepOf(points - 1)) break;
+        index.push_back({points, chunk.count, data, chunk.bytes, ChunkCodec(chunk.codec),
+                         std::max<uint32_t>(chunk.stride, 1), firstStep});
+        points += chunk.count;
+        pos = alignUp(data + chunk.bytes, kChunkAlign);
+    }
+    return true;
+}
+
+void TrajectoryReader::close() {
+    file.close();
+    index.clear();
+    points = 0;
+}
+
+size_t TrajectoryReader::chunkOf(uint64_t pointIndex) const {
+    auto it = std::upper_bound(index.begin(), index.end(), pointIndex,
+                               [](uint64_t i, const Chunk& c) { return i < c.firstIndex; });
+    return it == index.begin() ? 0 : size_t(it - index.begin()) - 1;
+}
+
+const void* TrajectoryReader::column(const Chunk& chunk, int axis) const {
+    return file.data() + chunk.offset + uint64_t(axis) * chunk.count * uint64_t(info.scalarSize);
+}
+
+bool TrajectoryReader::readColumn(const Chunk& chunk, int axis, void* out) const {
+    if (axis >= info.dims) return false;
+    const size_t scalar = size_t(info.scalarSize);
+    switch (chunk.codec) {
+    case ChunkCodec::Raw:
+        std::memcpy(out, column(chunk, axis), size_t(chunk.count) * scalar);
+        return true;
+    case ChunkCodec::Delta:
+        if (scalar == 8) return decodeDelta<double>(file.data() + chunk.offset, chunk.bytes, size_t(chunk.count), axis, out);
+        return decodeDelta<float>(file.data() + chunk.offset, chunk.bytes, size_t(chunk.count), axis, out);
+    }
+    return false;
+}
+
+uint64_t TrajectoryReader::stepOf(uint64_t pointIndex) const {
+    if (index.empty()) return pointIndex;
+    const Chunk& c = index[chunkOf(pointIndex)];
+    return c.firstStep + (pointIndex - c.firstIndex) * c.stride;
+}
+
+uint32_t TrajectoryReader::maxStride() const {
+    uint32_t stride = 1;
+    for (const Chunk& c : index) stride = std::max(stride, c.stride);
+    return stride;
+}
+
+double TrajectoryReader::bytesPerPoint() const {
+    uint64_t bytes = 0;
+    for (const Chunk& c : index) bytes += c.bytes;
+    return points > 0 ? double(bytes) / double(points) : 0.0;
+}
+
+size_t TrajectoryReader::read(uint64_t first, size_t count, Point* out) const {
+    // Morceaux de blocs à copier : [from, from + n) du bloc c vers out + at
+    struct Piece { size_t chunk; uint64_t from; size_t n, at; };
+    std::vector<Piece> pieces;
+    size_t total = 0, compressed = 0;
+    for (size_t c = chunkOf(first); c < index.size() && total < count && first < points; c++) {
+        const Chunk& chunk = index[c];
+        uint64_t from = first + total - chunk.firstIndex;
+        size_t n = size_t(std::min<uint64_t>(chunk.count - from, count - total));
+        pieces.push_back({c, from, n, total});
+        if (chunk.codec != ChunkCodec::Raw) compressed++;
+        total += n;
+    }
+
+    std::vector<uint8_t> ok(pieces.size());
+    float Point::*members[3] = {&Point::x, &Point::y, &Point::z};
+    auto copy = [&](size_t i) {
+        const Piece& piece = pieces[i];
+        const Chunk& chunk = index[piece.chunk];
+        Point* dst = out + piece.at;
+        std::vector<uint8_t> decoded;   // Colonne décodée (blocs compressés)
+        for (int axis = 0; axis < 3; axis++) {
+            if (axis >= info.dims) {
+                for (size_t j = 0; j < piece.n; j++) dst[j].z = 0.0f;
+                continue;
+            }
+            const void* values = nullptr;
+            if (chunk.codec == ChunkCodec::Raw) {
+                values = column(chunk, axis);
+            } else {
+                decoded.resize(size_t(chunk.count) * size_t(info.scalarSize));
+                if (!readColumn(chunk, axis, decoded.data())) return;
+                values = decoded.data();
+            }
+            if (info.scalarSize == 8) convertColumn<double>(values, piece.from, piece.n, members[axis], dst);
+            else convertColumn<float>(values, piece.from, piece.n, members[axis], dst);
+        }
+        ok[i] = 1;
+    };
+    // Les blocs bruts sont de simples copies : threads seulement pour décoder
+    parallelFor(pieces.size(), compressed > 1 ? 0 : 1, copy);
+
+    // Points valides jusqu'au premier bloc illisible
+    for (size_t i = 0; i < pieces.size(); i++) {
+        if (!ok[i]) return pieces[i].at;
+    }
+    return total;
+}
+
+bool TrajectoryReader::byteRange(uint64_t first, uint64_t count, uint64_t& begin, uint64_t& end) const {
+    if (count == 0 || first >= points) return false;
+    const Chunk& a = index[chunkOf(first)];
+    const Chunk& b = index[chunkOf(std::min(first + count, points) - 1)];
+    begin = a.offset;
+    end = b.offset + b.bytes;
+    return true;
+}
+
+void TrajectoryReader::prefetch(uint64_t first, uint64_t count) {
+    uint64_t begin, end;
+    if (byteRange(first, count, begin, end)) file.prefetch(begin, end - begin);
+}
+
+void TrajectoryReader::release(uint64_t first, uint64_t count) {
+    // Seulement les blocs entièrement compris dans [first, first + count) : un
+    // bloc à cheval reste utile à la fenêtre voisine
+    if (count == 0 || first >= points) return;
+    uint64_t end = std::min(first + count, points);
+    size_t a = chunkOf(first), b = chunkOf(end - 1);
+    if (index[a].firstIndex < first) a++;
+    if (index[b].firstIndex + index[b].count > end) {
+        if (b == 0) return;
+        b--;
+    }
+    if (a > b) return;
+    uint64_t begin = index[a].offset;
+    file.release(begin, index[b].offset + index[b].bytes - begin);
+}
+
+bool writePointsNpy(const std::string& path, const Point* points, size_t count) {
+    static_assert(sizeof(Point) == 3 * sizeof(float), "Point : trois float contigus");
+    return writeNpy(path, NpyType::Float32, {uint64_t(count), 3}, points);
+}
+
+bool writeTrajectoryNpy(TrajectoryReader& reader, const std::string& path) {
+    const TrajectoryHeader& h = reader.header();
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    NpyType type = h.scalarSize == 8 ? NpyType::Float64 : NpyType::Float32;
+    bool ok = writeNpyHeader(f, type, {reader.pointCount(), uint64_t(h.dims)}, true);
+    std::vector<uint8_t> decoded;
+    // Une passe par coordonnée ; chaque bloc est rendu au système une fois
+    // copié pour qu'un fichier de plusieurs Go ne reste pas en mémoire
+    for (int axis = 0; ok && axis < h.dims; axis++) {
+        for (const TrajectoryReader::Chunk& chunk : reader.chunks()) {
+            reader.prefetch(chunk.firstIndex, chunk.count);
+            const void* values = reader.column(chunk, axis);
+            if (chunk.codec != ChunkCodec::Raw) {
+                decoded.resize(size_t(chunk.count) * size_t(h.scalarSize));
+                ok = reader.readColumn(chunk, axis, decoded.data());
+                values = decoded.data();
+            }
+            ok = ok && std::fwrite(values, size_t(h.scalarSize), size_t(chunk.count), f) == chunk.count;
+            reader.release(chunk.firstIndex, chunk.count);
+            if (!ok) break;
+        }
+    }
+    return std::fclose(f) == 0 && ok;
+}
+std::string trajectoryStepsPath(const std::string& pointsPath) {
+    const size_t dot = pointsPath.rfind('.');
+    const size_t slash = pointsPath.find_last_of("/\\");
+    const bool extension = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+    return (extension ? pointsPath.substr(0, dot) : pointsPath) + "_pas.npy";
+}
+
+bool writeTrajectoryStepsNpy(const TrajectoryReader& reader, const std::string& path) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    bool ok = writeNpyHeader(f, NpyType::UInt64, {reader.pointCount()});
+    std::vector<uint64_t> steps;
+    for (const TrajectoryReader::Chunk& chunk : reader.chunks()) {
+        steps.resize(size_t(chunk.count));
+        for (size_t i = 0; i < steps.size(); i++) steps[i] = chunk.firstStep + uint64_t(i) * chunk.stride;
+        ok = ok && std::fwrite(steps.data(), sizeof(uint64_t), steps.size(), f) == steps.size();
+    }
+    return std::fclose(f) == 0 && ok;
+}
+/**
+ * TrajectoryFile.cpp
+ *
+ * Contient l'écriture par blocs et la lecture des fichiers de trajectoire.
+ */
@@ -0,0 +1,140 @@
+#include "TrajectoryRecorder.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+    double now() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+TrajectoryRecorder::TrajectoryRecorder(size_t bufferCount, size_t chunkSize)
+    : buffers(std::max<size_t>(bufferCount, 2), TrajectoryBuffer(chunkSize)),
+      filled(buffers.size()), available(buffers.size()) {}
+
+TrajectoryRecorder::~TrajectoryRecorder() {
+    close();
+}
+
+bool TrajectoryRecorder::open(const std::string& path, const TrajectoryHeader& header) {
+    close();
+    if (!writer.open(path, header)) return false;
+    info = header;
+    // Blocs dans le type des points du fichier
+    for (TrajectoryBuffer& b : buffers) {
+        if (b.scalarSize() != header.scalarSize) b.reset(b.capacity(), header.scalarSize);
+    }
+
+    TrajectoryBuffer* b;
+    while (available.pop(b)) {}
+    for (size_t i = 1; i < buffers.size(); i++) available.push(&buffers[i]);
+    current = &buffers[0];
+    current->count = 0;
+    current->stride = 1;
+    stride = 1;
+    skipped = 0;
+    steps = 0;
+    decimated = 0;
+    written = 0;
+    bytes = writer.bytesWritten();
+    dropped = 0;
+    currentStride = 1;
+    blockedSeconds = 0.0;
+    failed = false;
+    stopRequested = false;
+    thread = std::thread(&TrajectoryRecorder::writerLoop, this);
+    return true;
+}
+
+void TrajectoryRecorder::submit() {
+    dropped += decimated;
+    decimated = 0;
+    TrajectoryBuffer* next = nullptr;
+    if (!available.pop(next)) {
+        if (policy == RecordPolicy::Drop) {
+            dropped += current->count;
+            current->count = 0;
+            return;
+        }
+        if (policy == RecordPolicy::Downsample && stride < 65535 / 2) {
+            const size_t before = current->count;
+            current->halve();
+            dropped += before - current->count;
+            stride *= 2;
+            currentStride = stride;
+            // Nombre impair : le dernier point est tombé, le suivant vient un
+            // demi-pas plus tôt pour garder l'écart du bloc
+            if (before % 2) skipped = stride / 2;
+            return;
+        }
+        double t0 = now();
+        while (!available.pop(next)) std::this_thread::yield();
+        blockedSeconds = blockedSeconds + (now() - t0);
+    }
+    filled.push(current);   // Jamais pleine : elle peut contenir tous les blocs
+
+    // L'écriture a rattrapé son retard : on revient progressivement au pas 1
+    if (stride > 1 && available.size() >= buffers.size() / 2) {
+        stride /= 2;
+        currentStride = stride;
+    }
+    current = next;
+    current->count = 0;
+    current->stride = stride;
+}
+
+void TrajectoryRecorder::writerLoop() {
+    // Tous les blocs en attente sont pris ensemble : s'ils sont compressés,
+    // leur codage est réparti sur plusieurs threads quand l'écriture a du retard
+    std::vector<TrajectoryBuffer*> batch(buffers.size());
+    for (;;) {
+        // Lu avant pop() : si l'arrêt est demandé, le dernier bloc est déjà visible
+        bool stop = stopRequested;
+        size_t n = 0;
+        while (n < batch.size() && filled.pop(batch[n])) n++;
+        if (n > 0) {
+            size_t done = failed ? 0 : writer.append(batch.data(), n, encodeThreads);
+            if (done < n) failed = true;
+            for (size_t i = 0; i < n; i++) {
+                if (i < done) written += batch[i]->count;
+                else dropped += batch[i]->count;
+                available.push(batch[i]);
+            }
+            bytes = writer.bytesWritten();
+        } else if (stop) {
+            break;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+void TrajectoryRecorder::close() {
+    if (!current) return;
+    if (current->count > 0) filled.push(current);
+    current = nullptr;
+    dropped += decimated;
+    decimated = 0;
+    stopRequested = true;
+    thread.join();
+    writer.close();
+}
+
+RecorderStats TrajectoryRecorder::stats() const {
+    RecorderStats s;
+    s.written = written;
+    s.dropped = dropped;
+    s.bytes = bytes;
+    s.blockedSeconds = blockedSeconds;
+    s.stride = currentStride;
+    s.queued = filled.size();
+    s.buffers = buffers.size();
+    s.failed = failed;
+    return s;
+}
+/**
+ * TrajectoryRecorder.cpp
+ *
+ * Contient le passage des blocs entre la simulation et le thread d'écriture
+ * et l'application de la politique de contre-pression.
+ */
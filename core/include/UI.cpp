@@ -1,43 +1,607 @@
 #include "UI.h"
-#include <imgui.h>
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include "CustomSystem.h"
+
+namespace {
+    // Vrai si le système, ses paramètres ou le pas ont changé
+    bool sameSettings(const Attractor& a, const Attractor& b) {
+        return a.type == b.type && a.dt == b.dt && a.integrator == b.integrator
+            && a.taylorOrder == b.taylorOrder && a.precision == b.precision
+            && std::memcmp(a.params, b.params, sizeof(a.params)) == 0;
+    }
+}
 
 UI::UI() {}
 
 UI::~UI() {}
 
-void UI::initialize() {
-    ImGui::CreateContext();
-    ImGuiIO& io = ImGui::GetIO();
+void UI::exportField(const char* id, char* path, size_t size, const std::function<bool(const char*)>& write) {
+    ImGui::PushID(id);
+    ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x * 0.5f);
+    ImGui::InputText("##npy", path, size);
+    ImGui::SameLine();
+    if (ImGui::Button("Exporter .npy")) {
+        if (write(path)) exportFailed.clear();
+        else exportFailed = id;
+    }
+    if (exportFailed == id) ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.3f, 1.0f), "Impossible d'écrire %s", path);
+    ImGui::PopID();
+}
+
+void UI::initialize(SDL_Renderer* sdlRenderer) {
+    renderer = sdlRenderer;
+}
 
-    // Setup style
-    ImGui::StyleColorsDark();
+void UI::shutdown() {
+    if (bifurcationTexture) SDL_DestroyTexture(bifurcationTexture);
+    if (poincareTexture) SDL_DestroyTexture(poincareTexture);
+    bifurcationTexture = nullptr;
+    poincareTexture = nullptr;
+    renderer = nullptr;
 }
 
-void UI::handleEvent(const SDL_Event& event) {
-    ImGui_ImplSDL2_ProcessEvent(&event);
+void UI::lyapunovPanel(const Attractor& attractor, LyapunovEstimator& estimator) {
+    ImGui::Begin("Exposants de Lyapunov");
+
+    const SystemInfo& sys = Attractor::info(attractor.type);
+    if (sys.isMap) ImGui::Text("%s : application, plus grand exposant (par itération)", sys.name);
+    else ImGui::Text("%s : flot de dimension %d, spectre complet (par unité de temps), pas %s", sys.name, sys.dim,
+                     integratorName(attractor.integrator));
+
+    bool running = estimator.isRunning();
+    if (ImGui::Button(running ? "Arrêter" : "Démarrer")) {
+        if (running) estimator.stop();
+        else { lyapunovSource = attractor; estimator.start(attractor); }
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("Relancer si les paramètres changent", &lyapunovAutoRestart);
+    if (running && lyapunovAutoRestart && !sameSettings(attractor, lyapunovSource)) {
+        lyapunovSource = attractor;
+        estimator.start(attractor);
+    }
+
+    LyapunovResult r = estimator.result();
+    ImGui::Text("Pas : %ld%s", r.steps, r.finished ? " (terminé)" : "");
+    if (r.diverged) ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.3f, 1.0f), "La trajectoire diverge : réduire dt");
+
+    double sum = 0.0;
+    for (int i = 0; i < r.count; i++) {
+        char label[32];
+        std::snprintf(label, sizeof(label), "##lambda%d", i + 1);
+        ImGui::Text("lambda%d = %+.5f", i + 1, r.exponents[i]);
+        if (!r.history[i].empty()) {
+            ImGui::PlotLines(label, r.history[i].data(), (int)r.history[i].size(), 0, nullptr,
+                             FLT_MAX, FLT_MAX, ImVec2(-1.0f, 60.0f));
+        }
+        sum += r.exponents[i];
+    }
+    if (r.count > 1) {
+        ImGui::Text("Somme = %+.5f   Dimension de Kaplan-Yorke = %.4f", sum, kaplanYorkeDimension(r));
+    }
+    ImGui::End();
 }
+void UI::bifurcationPanel(const Attractor& attractor, BifurcationDiagram& diagram) {
+    ImGui::Begin("Diagramme de bifurcation");
+
+    const SystemInfo& sys = Attractor::info(attractor.type);
+    if (sys.paramCount == 0) {
+        ImGui::Text("%s n'a pas de paramètre à faire varier", sys.name);
+        ImGui::End();
+        return;
+    }
+    if (bifurcation.type != attractor.type) {
+        bifurcation = BifurcationSettings(attractor.type);
+    }
+    if (bifurcation.param >= sys.paramCount) bifurcation.param = 0;
+
+    ImGui::Combo("Paramètre", &bifurcation.param, sys.paramNames, sys.paramCount);
+    ImGui::DragFloatRange2("Plage", &bifurcation.pMin, &bifurcation.pMax, 0.01f);
+    const char* axes[] = {"x", "y", "z"};
+    ImGui::Combo("Coordonnée", &bifurcation.axis, axes, sys.dim);
+    if (!sys.isMap) {
+        int record = (int)bifurcation.record;
+        const char* records[] = {"Maxima locaux", "Section"};
+        if (ImGui::Combo("Enregistrement", &record, records, 2)) bifurcation.record = (BifurcationRecord)record;
+        if (bifurcation.record == BifurcationRecord::Section) {
+            ImGui::Combo("Axe de la section", &bifurcation.sectionAxis, axes, sys.dim);
+            ImGui::DragFloat("Niveau", &bifurcation.sectionLevel, 0.01f);
+        }
+    }
+    bool autoRange = bifurcation.vMin == bifurcation.vMax;
+    if (ImGui::Checkbox("Plage des valeurs automatique", &autoRange)) {
+        bifurcation.vMin = autoRange ? 0.0f : diagram.valueMin();
+        bifurcation.vMax = autoRange ? 0.0f : diagram.valueMax();
+        if (!autoRange && bifurcation.vMin == bifurcation.vMax) bifurcation.vMax = bifurcation.vMin + 1.0f;
+    }
+    if (!autoRange) ImGui::DragFloatRange2("Valeurs", &bifurcation.vMin, &bifurcation.vMax, 0.01f);
+    int size[2] = {bifurcation.columns, bifurcation.rows};
+    if (ImGui::InputInt2("Taille", size)) {
+        bifurcation.columns = std::max(16, size[0]);
+        bifurcation.rows = std::max(16, size[1]);
+    }
+    int steps = (int)bifurcation.steps;
+    if (ImGui::DragInt("Pas par colonne", &steps, 1000.0f, 1000, 10000000)) bifurcation.steps = steps;
 
-void UI::update(const Attractor& attractor) {
-    ImGui::NewFrame();
-    renderMenu(attractor);
-    ImGui::Render();
+    bool running = diagram.isRunning();
+    if (ImGui::Button(running ? "Annuler" : "Calculer")) {
+        if (running) diagram.cancel();
+        else {
+            // Paramètres, pas et point de départ de la fenêtre principale
+            std::memcpy(bifurcation.params, attractor.params, sizeof(bifurcation.params));
+            bifurcation.dt = attractor.dt;
+            bifurcation.initial = sys.initial;
+            diagram.start(bifurcation);
+            bifurcationShown.assign(diagram.settings().columns, 0);
+            bifurcationClear = true;
+        }
+    }
+    ImGui::SameLine();
+    const BifurcationSettings& s = diagram.settings();
+    int total = (int)bifurcationShown.size();
+    ImGui::ProgressBar(total > 0 ? float(diagram.columnsDone()) / float(total) : 0.0f, ImVec2(-1.0f, 0.0f));
+    if (total == 0 || !renderer) {
+        ImGui::End();
+        return;
+    }
+    ImGui::Text("%d / %d colonnes en %.2f s   %s dans [%g, %g]", diagram.columnsDone(), total,
+                diagram.seconds(), axes[s.axis], diagram.valueMin(), diagram.valueMax());
+    // Les colonnes en cours changent encore : export une fois le calcul fini
+    if (running) ImGui::BeginDisabled();
+    exportField("bifurcation", bifurcationNpy, sizeof(bifurcationNpy),
+                [&](const char* path) { return writeDensityNpy(diagram.image(), path); });
+    if (running) ImGui::EndDisabled();
+
+    // Copie dans la texture des suites de colonnes terminées depuis la
+    // dernière image (une colonne terminée ne change plus)
+    const DensityImage& image = diagram.image();
+    if (bifurcationTexture && bifurcationClear) {
+        // Texture gardée si le nouveau diagramme a les mêmes dimensions
+        float w = 0.0f, h = 0.0f;
+        SDL_GetTextureSize(bifurcationTexture, &w, &h);
+        if (int(w) != image.width || int(h) != image.height) {
+            SDL_DestroyTexture(bifurcationTexture);
+            bifurcationTexture = nullptr;
+        }
+    }
+    if (!bifurcationTexture) {
+        bifurcationTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING,
+                                               image.width, image.height);
+        bifurcationClear = true;
+    }
+    if (bifurcationClear) {
+        // Pixels et texture remis à zéro à chaque calcul : seules les colonnes
+        // recopiées ensuite s'affichent, rien ne reste du diagramme précédent
+        bifurcationPixels.assign(image.counts.size() * 4, 0);
+        SDL_UpdateTexture(bifurcationTexture, nullptr, bifurcationPixels.data(), image.width * 4);
+        bifurcationClear = false;
+    }
+    for (int col = 0; col < total;) {
+        if (bifurcationShown[col] || !diagram.columnDone(col)) { col++; continue; }
+        int end = col;
+        while (end < total && !bifurcationShown[end] && diagram.columnDone(end)) bifurcationShown[end++] = 1;
+        densityToRgba(image, DensityScale::PerColumn, col, end, bifurcationPixels.data());
+        SDL_Rect rect = {col, 0, end - col, image.height};
+        SDL_UpdateTexture(bifurcationTexture, &rect, bifurcationPixels.data() + size_t(col) * 4, image.width * 4);
+        col = end;
+    }
+
+    ImVec2 avail = ImGui::GetContentRegionAvail();
+    float scale = std::min(avail.x / image.width, std::max(avail.y, 100.0f) / image.height);
+    ImGui::Image((ImTextureID)(intptr_t)bifurcationTexture, ImVec2(image.width * scale, image.height * scale));
+    ImGui::End();
 }
+void UI::poincarePanel(const Attractor& attractor, PoincareSection& section) {
+    ImGui::Begin("Section de Poincaré");
+
+    const SystemInfo& sys = Attractor::info(attractor.type);
+    if (!poincareSupported(attractor.type)) {
+        ImGui::Text("Section de Poincaré indisponible pour %s", sys.name);
+        ImGui::End();
+        return;
+    }
+    if (poincare.type != attractor.type) poincare = PoincareSettings(attractor.type);
+
+    // Plans de coordonnée x = c, y = c, z = c ou normale quelconque
+    int plane = 3;
+    for (int axis = 0; axis < 3; axis++) {
+        if (poincare.normal[axis] == 1.0f && poincare.normal[(axis + 1) % 3] == 0.0f
+            && poincare.normal[(axis + 2) % 3] == 0.0f) plane = axis;
+    }
+    const char* planes[] = {"x = offset", "y = offset", "z = offset", "n.p = offset"};
+    if (ImGui::Combo("Plan", &plane, planes, 4) && plane < 3) {
+        for (int i = 0; i < 3; i++) poincare.normal[i] = i == plane ? 1.0f : 0.0f;
+    }
+    if (plane == 3) ImGui::DragFloat3("Normale n", poincare.normal, 0.01f, -1.0f, 1.0f);
+    ImGui::DragFloat("Offset", &poincare.offset, 0.05f);
+    ImGui::Checkbox("Passages dans les deux sens", &poincare.bothDirections);
+    int integrator = (int)poincare.integrator;
+    const char* integrators[] = {"Euler", "RK4", "Exact (Chua)", "Taylor (polynomiaux)"};
+    if (ImGui::Combo("Intégrateur", &integrator, integrators, 4)) poincare.integrator = (Integrator)integrator;
+    if (poincare.integrator == Integrator::Taylor) ImGui::SliderInt("Ordre", &poincare.taylorOrder, 4, kMaxTaylorOrder);
+    int size[2] = {poincare.width, poincare.height};
+    if (ImGui::InputInt2("Taille", size)) {
+        poincare.width = std::max(16, size[0]);
+        poincare.height = std::max(16, size[1]);
+    }
+
+    bool running = section.isRunning();
+    if (ImGui::Button(running ? "Arrêter" : "Démarrer")) {
+        if (running) section.stop();
+        else {
+            std::memcpy(poincare.params, attractor.params, sizeof(poincare.params));
+            poincare.dt = attractor.dt;
+            poincare.initial = sys.initial;
+            poincareVersion = ~0u;
+            if (poincareTexture) SDL_DestroyTexture(poincareTexture);
+            poincareTexture = nullptr;
+            section.start(poincare);
+        }
+    }
+    float r[4];
+    if (!renderer || !section.range(r)) {
+        ImGui::End();
+        return;
+    }
+    double seconds = section.seconds();
+    ImGui::SameLine();
+    ImGui::Text("%ld passages (%.2f M/s)", section.crossings(), seconds > 0.0 ? section.crossings() / seconds * 1e-6 : 0.0);
+    ImGui::Text("u [%g, %g]   v [%g, %g]", r[0], r[1], r[2], r[3]);
+    exportField("poincare", poincareNpy, sizeof(poincareNpy), [&](const char* path) {
+        section.copyImage(poincareImage);
+        return writeDensityNpy(poincareImage, path);
+    });
 
-void UI::renderMenu(const Attractor& attractor) {
-    ImGui::Begin("Attracteur Étrange");
-    // Parameters UI
-    ImGui::SliderFloat("Parameter A", &attractor.parameterA, 0.0f, 10.0f);
-    ImGui::SliderFloat("Parameter B", &attractor.parameterB, 0.0f, 10.0f);
-    ImGui::SliderFloat("Speed", &attractor.speed, 0.1f, 10.0f);
+    // Image recopiée au plus 4 fois par seconde (mise à l'échelle globale :
+    // toute l'image change à chaque ajout)
+    Uint64 ticks = SDL_GetTicks();
+    if (section.version() != poincareVersion && ticks - poincareUploadTicks >= 250) {
+        poincareVersion = section.version();
+        poincareUploadTicks = ticks;
+        section.copyImage(poincareImage);
+        if (!poincareTexture) {
+            poincareTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING,
+                                                poincareImage.width, poincareImage.height);
+            poincarePixels.resize(poincareImage.counts.size() * 4);
+        }
+        densityToRgba(poincareImage, DensityScale::Global, 0, poincareImage.width, poincarePixels.data());
+        SDL_UpdateTexture(poincareTexture, nullptr, poincarePixels.data(), poincareImage.width * 4);
+    }
+    if (poincareTexture) {
+        ImVec2 avail = ImGui::GetContentRegionAvail();
+        float scale = std::min(avail.x / poincareImage.width, std::max(avail.y, 100.0f) / poincareImage.height);
+        ImGui::Image((ImTextureID)(intptr_t)poincareTexture,
+                     ImVec2(poincareImage.width * scale, poincareImage.height * scale));
+    }
     ImGui::End();
 }
+void UI::recordingPanel(const Attractor& attractor, TrajectoryRecorder& recorder, const std::vector<Point>& points) {
+    ImGui::Begin("Enregistrement");
 
-void UI::render() {
-    ImGui::Render();
+    bool open = recorder.isOpen();
+    if (open) ImGui::BeginDisabled();
+    ImGui::InputText("Fichier", recordPath, sizeof(recordPath));
+    ImGui::Checkbox("Compression", &recordCompressed);
+    if (recordCompressed) {
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(120.0f);
+        ImGui::InputFloat("Pas", &recordQuantum, 0.0f, 0.0f, "%g");
+        ImGui::SetItemTooltip("Pas de quantification : erreur absolue <= pas / 2");
+        recordQuantum = std::max(recordQuantum, 1e-7f);
+    }
+    if (open) ImGui::EndDisabled();
+    int policy = (int)recorder.policy;
+    const char* policies[] = {"Attendre", "Abandonner", "Décimer"};
+    if (ImGui::Combo("Si l'écriture ne suit pas", &policy, policies, 3)) recorder.policy = (RecordPolicy)policy;
+
+    if (ImGui::Button(open ? "Arrêter" : "Enregistrer")) {
+        if (open) recorder.close();
+        else {
+            // Intégrateur et précision du calcul ; stockage dans le type calculé
+            TrajectoryHeader header = makeTrajectoryHeader(attractor, attractor.integrator, attractor.precision);
+            if (recordCompressed) {
+                header.codec = uint32_t(ChunkCodec::Delta);
+                header.quantum = recordQuantum;
+            }
+            recordError = !recorder.open(recordPath, header);
+        }
+    }
+    if (recordError) ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.3f, 1.0f), "Impossible d'écrire %s", recordPath);
+
+    RecorderStats st = recorder.stats();
+    ImGui::Text("%llu points écrits, %.1f Mo", (unsigned long long)st.written, st.bytes / 1e6);
+    if (st.written > 0) {
+        ImGui::SameLine();
+        ImGui::Text("(%.2f octets par point)", double(st.bytes) / double(st.written));
+    }
+    char label[32];
+    std::snprintf(label, sizeof(label), "%zu / %zu blocs en attente", st.queued, st.buffers);
+    ImGui::ProgressBar(st.buffers ? float(st.queued) / float(st.buffers) : 0.0f, ImVec2(-1.0f, 0.0f), label);
+    if (st.dropped > 0) ImGui::Text("%llu points perdus", (unsigned long long)st.dropped);
+    if (st.stride > 1) ImGui::Text("Un point sur %u enregistré", st.stride);
+    if (st.blockedSeconds > 0.0) ImGui::Text("Simulation bloquée %.2f s au total", st.blockedSeconds);
+    if (st.failed) ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.3f, 1.0f), "Erreur d'écriture (disque plein ?)");
+
+    ImGui::Separator();
+    ImGui::Text("Trajectoire affichée : %zu points", points.size());
+    exportField("points", pointsNpy, sizeof(pointsNpy),
+                [&](const char* path) { return writePointsNpy(path, points.data(), points.size()); });
+    ImGui::End();
+}
+void UI::resumed(const SessionState& state) {
+    if (state.hasCustom) {
+        // Fenêtre du système personnalisé : équations réinstallées
+        const CustomDefinition& def = state.custom;
+        std::snprintf(customName, sizeof(customName), "%s", def.name.c_str());
+        for (int i = 0; i < 3; i++) {
+            std::snprintf(customEquations[i], sizeof(customEquations[i]), "%s", def.equations[i].c_str());
+        }
+        std::string params;
+        for (const auto& [name, value] : def.params) {
+            char item[96];
+            std::snprintf(item, sizeof(item), "%s%s=%g", params.empty() ? "" : ",", name.c_str(), value);
+            params += item;
+        }
+        std::snprintf(customParams, sizeof(customParams), "%s", params.c_str());
+        customMap = def.isMap;
+        customNative = def.native;
+    }
+    if (state.hasBifurcation) {
+        // Plage résolue : le diagramme repris garde la même échelle
+        bifurcation = state.bifurcation.settings;
+        bifurcationShown.assign(bifurcation.columns, 0);
+        bifurcationClear = true;
+    }
+    if (state.hasPoincare) {
+        poincare = state.poincare.settings;
+        poincareVersion = ~0u;
+        if (poincareTexture) SDL_DestroyTexture(poincareTexture);
+        poincareTexture = nullptr;
+    }
+}
+
+void UI::openReplay(TrajectoryReplay& replay, const char* path) {
+    std::snprintf(replayPath, sizeof(replayPath), "%s", path);
+    replayError.clear();
+    if (!replay.open(replayPath)) replayError = replay.error();
+    else replayZoomPending = true;
+}
+
+void UI::replayPanel(TrajectoryReplay& replay, Renderer& view) {
+    ImGui::Begin("Relecture");
+
+    if (!replay.isOpen()) {
+        ImGui::InputText("Fichier", replayPath, sizeof(replayPath));
+        if (ImGui::Button("Ouvrir")) openReplay(replay, replayPath);
+        ImGui::TextDisabled("(ou déposer un fichier .atr sur la fenêtre)");
+        if (!replayError.empty()) {
+            ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.3f, 1.0f), "%s : %s", replayPath, replayError.c_str());
+        }
+        ImGui::End();
+        return;
+    }
+
+    const TrajectoryHeader& h = replay.header();
+    const SystemInfo& sys = Attractor::info(h.systemType);
+    if (replayZoomPending) {
+        view.camera.zoom = sys.zoom;
+        replayZoomPending = false;
+    }
+    ImGui::Text("%s, dt %g, %llu points", sys.name, h.dt, (unsigned long long)replay.length());
+    if (!replay.contiguous()) {
+        // Blocs décimés ou abandonnés à l'enregistrement : l'export ajoute le pas de chaque point
+        ImGui::SameLine();
+        ImGui::Text("(%llu pas, un point sur %u au plus)", (unsigned long long)replay.stepCount(),
+                    replay.maxStride());
+    }
+    for (int i = 0; i < sys.paramCount; i++) {
+        ImGui::SameLine();
+        ImGui::Text("%s=%g", sys.paramNames[i], h.params[i]);
+    }
+
+    // Frise : fin de la fenêtre affichée
+    uint64_t lo = 0, hi = replay.length();
+    ImGui::SetNextItemWidth(-1.0f);
+    ImGui::SliderScalar("##frise", ImGuiDataType_U64, &replay.position, &lo, &hi, "%llu");
+    uint64_t windowMin = 1, windowMax = std::max<uint64_t>(replay.length(), 1);
+    ImGui::SliderScalar("Points affichés", ImGuiDataType_U64, &replay.window, &windowMin, &windowMax, "%llu",
+                        ImGuiSliderFlags_Logarithmic);
+    ImGui::Text("Pas %llu, t = %.3f", (unsigned long long)replay.step(), double(replay.step()) * h.dt);
+    if (replay.stride() > 1) {
+        ImGui::SameLine();
+        ImGui::Text("- un point sur %u ici", replay.stride());
+    }
+
+    if (ImGui::Button(replay.playing ? "Pause" : "Lecture")) replay.playing = !replay.playing;
+    ImGui::SameLine();
+    ImGui::Checkbox("En boucle", &replay.loop);
+    float speed = float(replay.speed);
+    if (ImGui::SliderFloat("Pas par seconde", &speed, 10.0f, 1e8f, "%.0f", ImGuiSliderFlags_Logarithmic)) {
+        replay.speed = speed;
+    }
+    exportField("replay", replayNpy, sizeof(replayNpy),
+                [&](const char* path) { return replay.exportNpy(path); });
+    if (ImGui::Button("Fermer")) replay.close();
+    ImGui::End();
+}
+
+void UI::animationPanel(Attractor& attractor, Renderer& view, AnimationExport& exporter) {
+    ImGui::Begin("Animation");
+
+    const SystemInfo& sys = Attractor::info(attractor.type);
+    if (animation.type != attractor.type) animation = AnimationSettings(attractor.type);
+
+    // Fenêtre principale <-> image clé
+    auto capture = [&](Keyframe& k) {
+        std::memcpy(k.params, attractor.params, sizeof(k.params));
+        k.view.yaw = view.camera.yaw;
+        k.view.pitch = view.camera.pitch;
+        k.view.zoom = view.camera.zoom;
+        std::memcpy(k.view.color, view.color, sizeof(view.color));
+    };
+    auto apply = [&](const float* params, const FrameView& v) {
+        std::memcpy(attractor.params, params, sizeof(attractor.params));
+        view.camera.yaw = v.yaw;
+        view.camera.pitch = v.pitch;
+        view.camera.zoom = v.zoom;
+        std::memcpy(view.color, v.color, sizeof(view.color));
+    };
+
+    int mode = (int)animation.mode;
+    const char* modes[] = {"Orbite de la caméra", "Variation d'un paramètre", "Images clés"};
+    if (ImGui::Combo("Mouvement", &mode, modes, 3)) animation.mode = (AnimationMode)mode;
+    if (animation.mode == AnimationMode::Orbit) {
+        ImGui::DragFloat("Tours", &animation.turns, 0.05f, -10.0f, 10.0f);
+    } else if (animation.mode == AnimationMode::Morph) {
+        if (animation.param >= sys.paramCount) animation.param = 0;
+        ImGui::Combo("Paramètre", &animation.param, sys.paramNames, sys.paramCount);
+        ImGui::DragFloatRange2("De / à", &animation.from, &animation.to, 0.01f);
+    }
+    ImGui::InputInt("Images", &animation.frames);
+    animation.frames = std::max(1, animation.frames);
+
+    if (animation.mode == AnimationMode::Keyframes) {
+        // Paramètres et caméra de la fenêtre principale, saisis image par image
+        std::vector<Keyframe>& keys = animation.keyframes;
+        int erase = -1;
+        bool reorder = false;
+        for (int i = 0; i < (int)keys.size(); i++) {
+            ImGui::PushID(i);
+            ImGui::SetNextItemWidth(90.0f);
+            if (ImGui::InputInt("##image", &keys[i].frame)) {
+                keys[i].frame = std::clamp(keys[i].frame, 0, animation.frames - 1);
+                reorder = true;
+            }
+            ImGui::SameLine();
+            if (ImGui::SmallButton("Aller")) apply(keys[i].params, keys[i].view);
+            ImGui::SameLine();
+            if (ImGui::SmallButton("Remplacer")) capture(keys[i]);
+            ImGui::SameLine();
+            if (ImGui::SmallButton("Suppr")) erase = i;
+            ImGui::SameLine();
+            ImGui::Text("%s = %.3f", sys.paramCount > 0 ? sys.paramNames[0] : "zoom",
+                        sys.paramCount > 0 ? keys[i].params[0] : keys[i].view.zoom);
+            ImGui::PopID();
+        }
+        if (erase >= 0) keys.erase(keys.begin() + erase);
+
+        ImGui::SetNextItemWidth(90.0f);
+        ImGui::InputInt("##cible", &keyframeTarget);
+        keyframeTarget = std::clamp(keyframeTarget, 0, animation.frames - 1);
+        ImGui::SameLine();
+        if (ImGui::Button("Ajouter la vue courante")) {
+            // Remplace l'image clé déjà placée sur cette image
+            auto it = std::find_if(keys.begin(), keys.end(), [&](const Keyframe& k) { return k.frame == keyframeTarget; });
+            if (it == keys.end()) it = keys.insert(keys.end(), Keyframe());
+            it->frame = keyframeTarget;
+            capture(*it);
+            reorder = true;
+            keyframeTarget = std::min(keyframeTarget + std::max(1, animation.frames / 4), animation.frames - 1);
+        }
+        if (reorder) {
+            std::stable_sort(keys.begin(), keys.end(), [](const Keyframe& a, const Keyframe& b) { return a.frame < b.frame; });
+        }
+        ImGui::Checkbox("Interpolation lissée (Catmull-Rom)", &animation.smooth);
+        if (!keys.empty() && ImGui::SliderInt("Aperçu", &previewFrame, 0, animation.frames - 1)) {
+            float params[kMaxParams];
+            FrameView v;
+            std::memcpy(params, attractor.params, sizeof(params));
+            interpolateKeyframes(keys, float(previewFrame), animation.smooth, params, v);
+            apply(params, v);
+        }
+    }
+
+    const char* styles[] = {"Points", "Densité"};
+    int style = (int)animation.style;
+    if (ImGui::Combo("Rendu", &style, styles, 2)) animation.style = (FrameStyle)style;
+    int size[2] = {animation.width, animation.height};
+    if (ImGui::InputInt2("Taille", size)) {
+        animation.width = std::clamp(size[0], 16, 16384);
+        animation.height = std::clamp(size[1], 16, 16384);
+    }
+    int steps = (int)animation.steps;
+    if (ImGui::DragInt("Points par image", &steps, 10000.0f, 1000, 100000000)) animation.steps = steps;
+
+    const char* outputs[] = {"Images PNG", "Fichier Y4M", "Encodeur (flux Y4M)"};
+    ImGui::Combo("Sortie", &animationOutput, outputs, 3);
+    if (animationOutput == 0) ImGui::InputText("Motif", animationPng, sizeof(animationPng));
+    else if (animationOutput == 1) ImGui::InputText("Fichier", animationY4m, sizeof(animationY4m));
+    else ImGui::InputText("Commande", animationCommand, sizeof(animationCommand));
+    if (animationOutput > 0) ImGui::InputInt("Images/s", &animationFps);
+    animationFps = std::max(1, animationFps);
+
+    bool running = exporter.isRunning();
+    if (ImGui::Button(running ? "Annuler" : "Rendre")) {
+        if (running) exporter.cancel();
+        else {
+            // Système, pas et vue de la fenêtre principale ; le mode Variation
+            // part des valeurs courantes des autres paramètres
+            std::memcpy(animation.params, attractor.params, sizeof(animation.params));
+            animation.dt = attractor.dt;
+            animation.precision = attractor.precision;
+            animation.initial = sys.initial;
+            animation.view.yaw = view.camera.yaw;
+            animation.view.pitch = view.camera.pitch;
+            animation.view.zoom = view.camera.zoom;
+            std::memcpy(animation.view.color, view.color, sizeof(view.color));
+            AnimationOutput output;
+            output.format = animationOutput == 0 ? FrameFormat::Png : FrameFormat::Y4m;
+            output.path = animationOutput == 0 ? animationPng : animationY4m;
+            if (animationOutput == 2) output.command = animationCommand;
+            output.fps = animationFps;
+            exporter.start(animation, output);
+        }
+    }
+    ImGui::SameLine();
+    int total = std::max(1, exporter.frames());
+    ImGui::ProgressBar(float(exporter.framesDone()) / float(total), ImVec2(-1.0f, 0.0f));
+    if (!running && exporter.frames() > 0) {
+        const AnimationResult& r = exporter.result();
+        if (r.error.empty()) ImGui::Text("%d images en %.1f s", r.frames, r.seconds);
+        else ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.3f, 1.0f), "Arrêt après %d images : %s", r.frames, r.error.c_str());
+    }
+    ImGui::End();
+}
+
+bool UI::customSystemPanel() {
+    ImGui::Begin("Système personnalisé");
+    ImGui::InputText("Nom", customName, sizeof(customName));
+    const char* labels[3] = {"dx/dt", "dy/dt", "dz/dt"};
+    const char* mapLabels[3] = {"x'", "y'", "z'"};
+    for (int i = 0; i < 3; i++) {
+        ImGui::InputText(customMap ? mapLabels[i] : labels[i], customEquations[i], sizeof(customEquations[i]));
+    }
+    ImGui::InputText("Paramètres", customParams, sizeof(customParams));
+    ImGui::Checkbox("Application (équations = point suivant)", &customMap);
+    // Première compilation : une fraction de seconde, puis le cache
+    ImGui::Checkbox("Compilation native (compilateur local)", &customNative);
+    ImGui::TextDisabled("z vide : système plan ; sin cos exp log sqrt abs min max pow...");
+
+    bool installed = false;
+    if (ImGui::Button("Compiler")) {
+        CustomDefinition def;
+        def.name = customName;
+        for (int i = 0; i < 3; i++) def.equations[i] = customEquations[i];
+        def.isMap = customMap;
+        def.native = customNative;
+        if (def.isMap) def.zoom = 150.0f;
+        installed = parseCustomParams(customParams, def.params, customError) && defineCustomSystem(def, customError);
+        if (installed) customError.clear();
+    }
+    if (!customError.empty()) ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.3f, 1.0f), "%s", customError.c_str());
+    else if (hasCustomSystem()) {
+        ImGui::Text("Type %d : %s", Attractor::kCustomType, Attractor::info(Attractor::kCustomType).name);
+        ImGui::TextWrapped("Exécution : %s", customBackend().c_str());
+    }
+    ImGui::End();
+    return installed;
 }
 /**
- * UIController.cpp
+ * UI.cpp
  * 
  * Contient l'implémentation de la classe UI pour gérer l'interface utilisateur
  * avec ImGui.
- */
\ No newline at end of file
+ */
@@ -3,53 +3,57 @@
 #include "imgui_impl_sdl3.h"
 #include "imgui_impl_sdlrenderer3.h"
 #include <vector>
+#include <algorithm>
+#include <string>
 #include <cmath>
 #include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include "Animation.h"
+#include "Attractor.h"
+#include "Bifurcation.h"
+#include "Cli.h"
+#include "Control.h"
+#include "ControlServer.h"
+#include "LiveFeed.h"
+#include "Lyapunov.h"
+#include "Plugins.h"
+#include "Poincare.h"
+#include "Renderer.h"
+#include "Replay.h"
+#include "Screenshot.h"
+#include "Session.h"
+#include "TrajectoryRecorder.h"
+#include "UI.h"
 
-// Structure de point pour les calculs
-struct Point { float x, y, z; };
-
-// Classe Attractor (mise à jour avec vos 14 types)
-class Attractor {
-public:
-    int type = 1;
-    Point p = {0.1f, 0.0f, 0.0f};
-    float dt = 0.01f; // Pas de temps plus fin pour la stabilité
-
-    void update() {
-        float dx = 0, dy = 0, dz = 0;
-        if (type == 1) { // Lorenz
-            dx = (10.0f * (p.y - p.x));
-            dy = (p.x * (28.0f - p.z) - p.y);
-            dz = (p.x * p.y - (8.0f / 3.0f) * p.z);
-        } 
-        else if (type == 2) { // Rössler
-            dx = (-p.y - p.z);
-            dy = (p.x + 0.2f * p.y);
-            dz = (0.2f + p.z * (p.x - 5.7f));
-        }
-        else if (type == 11) { // Chua
-            float h = -0.714f * p.x + 0.5f * (-1.143f + 0.714f) * (std::abs(p.x + 1.0f) - std::abs(p.x - 1.0f));
-            dx = 15.6f * (p.y - p.x - h);
-            dy = p.x - p.y + p.z;
-            dz = -28.0f * p.y;
-        }
-        else if (type == 14) { // Double Scroll
-            dx = 0.7f * (p.y - p.x);
-            dy = p.x - p.x * p.z + 7.0f * p.y;
-            dz = p.x * p.y - 0.7f * p.z;
-        }
-        // ... Ajoutez ici les autres types (3 à 13) de votre fichier attracteurs.cpp original
+int main(int argc, char* argv[]) {
+    // "attracteurs sweep ...", "attracteurs --batch taches.toml" : commandes
+    // sans fenêtre (voir Cli.cpp)
+    int cliCode = runCommandLine(argc, argv);
+    if (cliCode >= 0) return cliCode;
+    loadStartupPlugins();
 
-        p.x += dx * dt; 
-        p.y += dy * dt; 
-        p.z += dz * dt;
+    // --frames N : quitte après N images en parcourant tous les systèmes
+    // (charge d'entraînement PGO, utilisable avec SDL_VIDEODRIVER=dummy)
+    // --session fichier : session restaurée au démarrage et sauvegardée en
+    // continu ; --no-session : ni l'un ni l'autre (toujours le cas avec --frames)
+    // --live nom : états publiés en mémoire partagée (attracteurs_cli live)
+    // --control chemin : socket de l'API de contrôle (attracteurs_cli control)
+    long maxFrames = 0;
+    std::string sessionPath = "session.atrs";
+    std::string liveName;
+    std::string controlPath;
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--frames") && i + 1 < argc) maxFrames = std::atol(argv[++i]);
+        else if (!std::strcmp(argv[i], "--live") && i + 1 < argc) liveName = argv[++i];
+        else if (!std::strcmp(argv[i], "--control") && i + 1 < argc) controlPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--session") && i + 1 < argc) sessionPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--no-session")) sessionPath.clear();
     }
-};
+    if (maxFrames > 0) sessionPath.clear();
 
-int main(int argc, char* argv[]) {
     // 1. Initialisation SDL3
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS) < 0) return -1;
+    if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS)) return -1;
 
     SDL_Window* window = SDL_CreateWindow("ChaosSim 2026 - SDL3 & ImGui", 1280, 720, SDL_WINDOW_RESIZABLE);
     SDL_Renderer* renderer = SDL_CreateRenderer(window, NULL);
@@ -61,22 +65,218 @@ int main(int argc, char* argv[]) {
     ImGui_ImplSDLRenderer3_Init(renderer);
 
     Attractor att;
-    std::vector<SDL_FPoint> points; // SDL3 utilise des SDL_FPoint (float)
-    float zoom = 15.0f;
+    UI ui;
+    ui.initialize(renderer);
+    LyapunovEstimator lyapunov;
+    BifurcationDiagram bifurcation;
+    PoincareSection poincare;
+    TrajectoryRecorder recorder;       // Enregistrement des pas de att.update()
+    TrajectoryReplay replay;           // Fichier relu à la place de la simulation
+    Renderer view;
+    view.initialize(renderer);
+    AnimationExport animation;         // Rendu hors écran d'une animation
+    Screenshot screenshot;             // F12 : scène seule, Maj+F12 : avec l'interface
+    LiveFeedWriter live;               // Derniers états pour d'autres programmes
+    if (!liveName.empty() && !live.open(liveName)) {
+        std::cerr << "Flux partagé " << liveName << " impossible à créer" << std::endl;
+    }
+    ControlServer control;             // Requêtes exécutées entre deux images
+    if (!controlPath.empty() && !control.start(controlPath)) std::cerr << control.error() << std::endl;
+    std::vector<Point> points;
     bool running = true;
-    ImVec4 color = ImVec4(0.0f, 1.0f, 1.0f, 1.0f); // Cyan
+    long frame = 0;
+    Uint64 lastTicks = SDL_GetTicks();
+
+    // Session : seuls les changements depuis la sauvegarde précédente sont
+    // passés au thread d'écriture
+    SessionWriter session;
+    bool autosave = true;
+    bool saveRequested = false;
+    const Uint64 autosaveTicks = 10000;
+    Uint64 lastSaveTicks = lastTicks;
+    size_t savedPoints = 0;
+    unsigned pointsEpoch = 0, savedEpoch = 0;  // pointsEpoch++ à chaque points.clear()
+    long savedCrossings = 0;
+    int savedColumns = 0;
+    if (!sessionPath.empty()) {
+        SessionState restored;
+        if (loadSession(sessionPath, restored)) {
+            if (restored.hasView) {
+                const SessionView& v = restored.view;
+                // Système personnalisé réinstallé, greffon retrouvé par son nom
+                std::string error;
+                if (restored.hasCustom && !defineCustomSystem(restored.custom, error)) {
+                    std::cerr << "Système personnalisé de la session : " << error << std::endl;
+                }
+                int type = v.type;
+                if (type >= kFirstPluginType) {
+                    type = Attractor::find(restored.system);
+                    if (type < kFirstPluginType) type = 0;
+                }
+                if (Attractor::available(type)) {
+                    att.select(type);
+                    att.dt = v.dt;
+                    std::memcpy(att.params, v.params, sizeof(att.params));
+                    if (v.integrator >= 0 && v.integrator <= int(Integrator::Taylor)) att.integrator = Integrator(v.integrator);
+                    att.taylorOrder = std::clamp(int(v.taylorOrder), 4, kMaxTaylorOrder);
+                    att.precision = v.precision == int(Precision::Double) ? Precision::Double : Precision::Single;
+                    att.setState({v.p[0], v.p[1], v.p[2]});
+                } else {
+                    // Greffon absent : Lorenz avec ses propres valeurs, rien de la session
+                    att.select(1);
+                }
+                view.camera.yaw = v.yaw;
+                view.camera.pitch = v.pitch;
+                view.camera.zoom = v.zoom;
+                std::memcpy(view.color, v.color, sizeof(view.color));
+            }
+            points = restored.points;
+            savedPoints = points.size();
+            // Calculs repris là où ils en étaient
+            if (restored.hasPoincare && !poincare.resume(restored.poincare)) restored.hasPoincare = false;
+            if (restored.hasBifurcation && !bifurcation.resume(restored.bifurcation)) restored.hasBifurcation = false;
+            savedCrossings = restored.hasPoincare ? restored.poincare.crossings : 0;
+            savedColumns = restored.hasBifurcation ? bifurcation.columnsDone() : 0;
+            ui.resumed(restored);
+        }
+        session.open(sessionPath, std::move(restored));
+    }
+    auto saveSession = [&] {
+        SessionState changes;
+        changes.hasView = true;
+        SessionView& v = changes.view;
+        v.type = att.type;
+        changes.system = Attractor::info(att.type).name;
+        changes.hasCustom = hasCustomSystem();
+        if (changes.hasCustom) changes.custom = customDefinition();
+        v.integrator = int32_t(att.integrator);
+        v.taylorOrder = att.taylorOrder;
+        v.precision = int32_t(att.precision);
+        const Vec3<double> state = att.state();
+        v.p[0] = state.x; v.p[1] = state.y; v.p[2] = state.z;
+        v.dt = att.dt;
+        std::memcpy(v.params, att.params, sizeof(v.params));
+        v.yaw = view.camera.yaw;
+        v.pitch = view.camera.pitch;
+        v.zoom = view.camera.zoom;
+        std::memcpy(v.color, view.color, sizeof(v.color));
+        if (pointsEpoch != savedEpoch || points.size() < savedPoints) {
+            changes.resetPoints = true;
+            savedPoints = 0;
+        }
+        changes.points.assign(points.begin() + savedPoints, points.end());
+        savedPoints = points.size();
+        savedEpoch = pointsEpoch;
+        // Images recopiées seulement si elles ont changé
+        if (poincare.crossings() != savedCrossings) {
+            poincare.snapshot(changes.poincare);
+            changes.hasPoincare = true;
+            savedCrossings = changes.poincare.crossings;
+        }
+        if (bifurcation.columnsDone() != savedColumns) {
+            bifurcation.snapshot(changes.bifurcation);
+            changes.hasBifurcation = true;
+            savedColumns = int(std::count(changes.bifurcation.columns.begin(), changes.bifurcation.columns.end(), uint8_t(1)));
+        }
+        session.save(std::move(changes));
+    };
 
     while (running) {
+        if (maxFrames > 0) {
+            if (frame >= maxFrames) break;
+            int type = 1 + (int)(frame * Attractor::kSystemCount / maxFrames);
+            if (type != att.type) {
+                att.select(type);
+                view.camera.zoom = Attractor::info(att.type).zoom;
+                points.clear();
+                pointsEpoch++;
+                live.restart();
+            }
+        }
+        frame++;
+        Uint64 ticks = SDL_GetTicks();
+        double elapsed = (ticks - lastTicks) * 1e-3;
+        lastTicks = ticks;
+
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
             ImGui_ImplSDL3_ProcessEvent(&event);
             if (event.type == SDL_EVENT_QUIT) running = false;
+            // Fichier .atr déposé sur la fenêtre : relecture
+            if (event.type == SDL_EVENT_DROP_FILE && event.drop.data) ui.openReplay(replay, event.drop.data);
+            if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_F12 && !event.key.repeat) {
+                screenshot.request((event.key.mod & SDL_KMOD_SHIFT) != 0);
+            }
+            view.handleEvent(event, ImGui::GetIO().WantCaptureMouse);
+        }
+
+        // Requêtes de contrôle : appliquées ici comme les réglages de l'interface
+        if (control.isRunning()) {
+            FrameView shown;
+            shown.yaw = view.camera.yaw;
+            shown.pitch = view.camera.pitch;
+            shown.zoom = view.camera.zoom;
+            std::memcpy(shown.color, view.color, sizeof(shown.color));
+            ControlTarget target{att, shown, animation};
+            const int previousType = att.type;
+            control.poll([&](const Json& request, Json& reply) {
+                const Json* cmd = request.find("cmd");
+                const std::string name = cmd && cmd->isString() ? cmd->text : "";
+                if (name == "reset") {
+                    target.resetPoints = true;
+                } else if (name == "screenshot") {
+                    const Json* withInterface = request.find("interface");
+                    screenshot.request(withInterface && withInterface->kind == Json::Kind::Bool && withInterface->boolean);
+                } else if (name == "export") {
+                    const Json* path = request.find("path");
+                    if (!path || !path->isString()) reply.set("error", "path attendu (fichier .npy)");
+                    else if (!writePointsNpy(path->text, points.data(), points.size())) reply.set("error", "écriture impossible : " + path->text);
+                    else reply.set("points", double(points.size()));
+                } else if (name == "quit") {
+                    running = false;
+                } else if (!handleControl(request, reply, target)) {
+                    reply.set("error", "commande inconnue : " + name);
+                } else if (name == "status") {
+                    reply.set("points", double(points.size()));
+                    reply.set("replay", replay.isOpen());
+                    reply.set("screenshot", screenshot.status().lastPath);
+                }
+            });
+            view.camera.yaw = shown.yaw;
+            view.camera.pitch = shown.pitch;
+            view.camera.zoom = shown.zoom;
+            std::memcpy(view.color, shown.color, sizeof(view.color));
+            // Même effet qu'un changement de type ou « Réinitialiser » dans l'interface
+            if (att.type != previousType) recorder.close();
+            if (target.resetPoints) {
+                points.clear();
+                pointsEpoch++;
+                live.restart();
+            }
         }
 
-        // 3. Logique de calcul (5 itérations par frame)
-        for (int i = 0; i < 5; i++) {
-            att.update();
-            points.push_back({ 640.0f + att.p.x * zoom, 360.0f + att.p.y * zoom });
+        // 3. Logique de calcul (5 itérations par frame), suspendue pendant une relecture
+        if (replay.isOpen()) {
+            replay.advance(elapsed);
+        } else {
+            // Intégrateur, ordre ou précision changés (interface, --control) :
+            // l'en-tête de l'enregistrement ne décrirait plus les pas suivants
+            if (recorder.isOpen() && !headerDescribes(recorder.header(), att)) recorder.close();
+            for (int i = 0; i < 5; i++) {
+                att.update();
+                points.push_back(att.p);
+                recorder.push(att.state());
+            }
+            if (live.isOpen()) {
+                LiveSnapshot description;
+                description.type = att.type;
+                description.dt = att.dt;
+                std::memcpy(description.params, att.params, sizeof(description.params));
+                description.yaw = view.camera.yaw;
+                description.pitch = view.camera.pitch;
+                description.zoom = view.camera.zoom;
+                live.publish(points.data() + points.size() - 5, 5, description);
+            }
         }
 
         // 4. Interface ImGui
@@ -85,29 +285,115 @@ int main(int argc, char* argv[]) {
         ImGui::NewFrame();
 
         ImGui::Begin("Contrôles de l'Attracteur");
-        ImGui::Text("Système actuel: %d", att.type);
-        if (ImGui::SliderInt("Type", &att.type, 1, 14)) points.clear();
-        ImGui::SliderFloat("Zoom", &zoom, 1.0f, 300.0f);
+        ImGui::Text("Système actuel: %d (%s)", att.type, Attractor::info(att.type).name);
+        int type = att.type;
+        // Greffons après le système personnalisé : les types non définis sont sautés
+        int lastType = kFirstPluginType + kPluginSlots - 1;
+        while (!Attractor::available(lastType)) lastType--;
+        if (ImGui::SliderInt("Type", &type, 1, lastType) && Attractor::available(type)) {
+            // L'en-tête d'un enregistrement ne décrit qu'un seul système
+            recorder.close();
+            att.select(type);
+            view.camera.zoom = Attractor::info(att.type).zoom;
+            points.clear();
+            pointsEpoch++;
+            live.restart();
+        }
+        ImGui::SliderFloat("Zoom", &view.camera.zoom, 1.0f, 300.0f);
+        ImGui::SliderAngle("Rotation", &view.camera.yaw, -180.0f, 180.0f);
+        ImGui::SliderAngle("Inclinaison", &view.camera.pitch, -90.0f, 90.0f);
         ImGui::SliderFloat("Vitesse (dt)", &att.dt, 0.001f, 0.05f);
-        ImGui::ColorEdit3("Couleur", (float*)&color);
-        if (ImGui::Button("Réinitialiser")) points.clear();
+        const SystemInfo& sys = Attractor::info(att.type);
+        for (int i = 0; i < sys.paramCount; i++) {
+            ImGui::DragFloat(sys.paramNames[i], &att.params[i], 0.01f);
+        }
+        if (!sys.isMap) {
+            int integrator = (int)att.integrator;
+            const char* integrators[] = {"Euler", "RK4", "Exact (Chua)", "Taylor (polynomiaux)"};
+            if (ImGui::Combo("Intégrateur", &integrator, integrators, 4)) att.integrator = (Integrator)integrator;
+            if (att.integrator == Integrator::Taylor) ImGui::SliderInt("Ordre", &att.taylorOrder, 4, kMaxTaylorOrder);
+        }
+        int precision = (int)att.precision;
+        const char* precisions[] = {"Simple (float)", "Double"};
+        if (ImGui::Combo("Précision", &precision, precisions, 2)) att.precision = (Precision)precision;
+        ImGui::ColorEdit3("Couleur", view.color);
+        if (ImGui::Button("Réinitialiser")) {
+            points.clear();
+            pointsEpoch++;
+            live.restart();
+        }
+
+        if (ImGui::Button("Capture (F12)")) screenshot.request(false);
+        ScreenshotStatus shot = screenshot.status();
+        ImGui::SameLine();
+        if (shot.failed) ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Échec de la capture");
+        else if (shot.pending > 0) ImGui::Text("Encodage de %d capture(s)...", shot.pending);
+        else if (!shot.lastPath.empty()) ImGui::Text("%s", shot.lastPath.c_str());
+
+        if (live.isOpen()) ImGui::Text("Flux %s : %llu états publiés", live.name().c_str(),
+                                       (unsigned long long)live.published());
+
+        if (session.isOpen()) {
+            ImGui::Separator();
+            ImGui::Checkbox("Sauvegarde auto", &autosave);
+            ImGui::SameLine();
+            if (ImGui::Button("Sauvegarder")) saveRequested = true;
+            SessionStats st = session.stats();
+            if (st.failed) ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Écriture impossible : %s", sessionPath.c_str());
+            else ImGui::Text("%s : %.1f Mo, écrit en %.0f ms", sessionPath.c_str(), st.fileBytes / 1e6, st.lastSeconds * 1e3);
+        }
+
         ImGui::End();
 
-        // 5. Rendu
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderClear(renderer);
+        ui.lyapunovPanel(att, lyapunov);
+        ui.bifurcationPanel(att, bifurcation);
+        ui.poincarePanel(att, poincare);
+        ui.recordingPanel(att, recorder, points);
+        ui.replayPanel(replay, view);
+        ui.animationPanel(att, view, animation);
+        if (ui.customSystemPanel()) {
+            recorder.close();
+            att.select(Attractor::kCustomType);
+            view.camera.zoom = Attractor::info(att.type).zoom;
+            points.clear();
+            pointsEpoch++;
+            live.restart();
+        }
 
-        SDL_SetRenderDrawColor(renderer, color.x * 255, color.y * 255, color.z * 255, 255);
-        if (!points.empty()) {
-            SDL_RenderPoints(renderer, points.data(), points.size());
+        // Sauvegarde périodique (ou demandée), sautée si la précédente s'écrit encore
+        if (session.isOpen() && (saveRequested || (autosave && ticks - lastSaveTicks >= autosaveTicks))
+            && !session.busy()) {
+            saveSession();
+            saveRequested = false;
+            lastSaveTicks = ticks;
         }
 
+        // 5. Rendu
+        // Même tracé pour la simulation et pour un fichier relu
+        view.clear();
+        if (replay.isOpen()) view.render(replay.visible());
+        else view.render(points);
+        screenshot.capture(renderer, false);
+
         ImGui::Render();
         ImGui_ImplSDLRenderer3_RenderDrawData(ImGui::GetDrawData(), renderer);
+        screenshot.capture(renderer, true);
         SDL_RenderPresent(renderer);
     }
 
-    // Nettoyage
+    // Nettoyage ; la dernière sauvegarde précède l'arrêt des calculs, qui
+    // reprendront donc au prochain démarrage
+    if (session.isOpen()) {
+        saveSession();
+        session.close();
+    }
+    lyapunov.stop();
+    animation.cancel();
+    bifurcation.cancel();
+    poincare.stop();
+    recorder.close();
+    replay.close();
+    ui.shutdown();
     ImGui_ImplSDLRenderer3_Shutdown();
     ImGui_ImplSDL3_Shutdown();
     ImGui::DestroyContext();
@@ -0,0 +1,135 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Attractor.h"
+
+// Hauteur de fenêtre de référence du zoom : une image rendue hors écran à
+// n'importe quelle taille est cadrée comme la fenêtre à 720 pixels de haut
+constexpr int kReferenceHeight = 720;
+
+// Caméra et couleur de Renderer, sans SDL
+struct FrameView {
+    float yaw = 0.0f, pitch = 0.0f;
+    float zoom = 15.0f;
+    float color[3] = {0.0f, 1.0f, 1.0f};
+};
+
+// Tracé hors écran (RGB 8 bits, fond noir) par la projection de Renderer
+void rasterizePoints(const Point* points, size_t count, const FrameView& view, int width, int height, uint8_t* rgb);
+
+enum class AnimationMode {
+    Orbit,      // Une trajectoire, la caméra tourne autour (yaw)
+    Morph,      // Un paramètre varie de from à to, une trajectoire par image
+    Keyframes   // Paramètres et vue interpolés entre des images clés
+};
+
+enum class FrameStyle {
+    Points,     // Comme la fenêtre : chaque point touché prend la couleur de la vue
+    Density     // Accumulation complète par image, palette de Density.h
+};
+
+// Paramètres et vue atteints à l'image frame
+struct Keyframe {
+    int frame = 0;
+    float params[kMaxParams] = {};
+    FrameView view;
+};
+
+// Valeurs à l'image frame (éventuellement fractionnaire) : constantes avant la
+// première image clé et après la dernière ; entre deux, interpolation linéaire
+// ou spline de Catmull-Rom (smooth). keys doit être trié par frame croissant.
+void interpolateKeyframes(const std::vector<Keyframe>& keys, float frame, bool smooth, float* params, FrameView& view);
+
+struct AnimationSettings {
+    int type = 1;
+    float params[kMaxParams];
+    float dt = 0.01f;
+    Point initial;
+    Integrator integrator = Integrator::Euler;
+    int taylorOrder = kTaylorOrder;     // Integrator::Taylor
+    Precision precision = Precision::Single;
+    long transient = 1000;
+    long steps = 200000;            // Points tracés par image
+    AnimationMode mode = AnimationMode::Orbit;
+    FrameView view;                 // Vue de la première image
+    float turns = 1.0f;             // Orbit : tours complets sur l'animation
+    int param = 0;                  // Morph : indice dans SystemInfo::paramNames
+    float from = 0.0f, to = 0.0f;
+    std::vector<Keyframe> keyframes;// Keyframes
+    bool smooth = true;
+    FrameStyle style = FrameStyle::Points;
+    int frames = 120;
+    int width = 1920, height = 1080;
+    int threads = 0;                // 0 = tous les cœurs
+
+    explicit AnimationSettings(int type = 1);   // Paramètres du registre
+};
+
+enum class FrameFormat {
+    Png,        // Une image par fichier, path = motif printf ("image_%05d.png"),
+                // ou nom du fichier s'il n'y a qu'une image
+    Y4m         // Flux YUV4MPEG2 4:2:0 dans path, ou sur l'entrée de command
+};
+
+struct AnimationOutput {
+    FrameFormat format = FrameFormat::Png;
+    std::string path = "image_%05d.png";
+    std::string command;            // Y4m : encodeur lancé par popen (ffmpeg -i - ...)
+    int fps = 30;
+};
+
+struct AnimationProgress {
+    std::atomic<int> framesDone{0};
+    std::atomic<bool> cancel{false};
+};
+
+struct AnimationResult {
+    int frames = 0;                 // Images écrites
+    double seconds = 0.0;
+    std::string error;              // Vide si tout s'est bien passé
+};
+
+// Les images sont rendues et encodées (PNG ou YUV) en parallèle, chaque
+// thread prenant la suivante ; le thread appelant les écrit dans l'ordre. Au
+// plus deux images par thread attendent leur tour : la mémoire reste bornée
+// quelle que soit la longueur de l'animation. Hors orbite, chaque image
+// simule sa trajectoire en la traçant au fil de l'eau, sans la stocker.
+AnimationResult runAnimation(const AnimationSettings& settings, const AnimationOutput& output,
+                             AnimationProgress* progress = nullptr);
+
+// runAnimation en tâche de fond (fenêtre de l'application)
+class AnimationExport {
+public:
+    AnimationExport() = default;
+    ~AnimationExport();
+    AnimationExport(const AnimationExport&) = delete;
+    AnimationExport& operator=(const AnimationExport&) = delete;
+
+    void start(const AnimationSettings& settings, const AnimationOutput& output);
+    void cancel();
+    bool isRunning() const { return running; }
+    int framesDone() const { return progress.framesDone; }
+    int frames() const { return total; }
+    // Valide quand isRunning() est faux
+    const AnimationResult& result() const { return last; }
+
+private:
+    AnimationProgress progress;
+    AnimationResult last;
+    int total = 0;
+    std::atomic<bool> running{false};
+    std::thread thread;
+};
+
+#endif // ANIMATION_H
+/**
+ * Animation.h
+ *
+ * Contient le rendu hors écran d'animations (orbite de la caméra, variation
+ * d'un paramètre, images clés interpolées), en points ou en densité, en suite
+ * d'images PNG ou en flux Y4M.
+ */
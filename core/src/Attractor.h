@@ -1,17 +1,72 @@
-#ifndef UTILS_H
-#define UTILS_H
+#ifndef ATTRACTOR_H
+#define ATTRACTOR_H
 
-#include <cmath>
+#include <string>
+#include "Systems.h"
 
-namespace Utils {
-    static inline float mapRange(float value, float fromStart, float fromEnd, float toStart, float toEnd) {
-        return toStart + (toEnd - toStart) * ((value - fromStart) / (fromEnd - fromStart));
-    }
-}
+// Structure de point pour les calculs
+using Point = Vec3<float>;
 
-#endif // UTILS_H
+// Entrée du registre des systèmes
+struct SystemInfo {
+    const char* name;
+    Point initial;                         // Point de départ
+    float zoom;                            // Zoom conseillé
+    int dim;                               // Dimension utile (2 ou 3)
+    bool isMap;                            // Application itérée (écrite f(p) - p)
+    int paramCount;
+    const char* paramNames[kMaxParams];
+    float paramDefaults[kMaxParams];
+};
+
+// "euler", "rk4", "exact", "taylor" : options --integrator, requêtes de contrôle
+const char* integratorName(Integrator integrator);
+bool findIntegrator(const std::string& name, Integrator& out);   // Faux si inconnu
+
+class Attractor {
+public:
+    static constexpr int kSystemCount = 14;
+    // Système saisi par l'utilisateur (CustomSystem.h), après les 14
+    static constexpr int kCustomType = kSystemCount + 1;
+    // Greffons chargés (Plugins.h) : kFirstPluginType (16) et suivants
+    static_assert(kFirstPluginType == kCustomType + 1, "greffons après le système personnalisé");
+
+    int type = 1;
+    Point p = {0.1f, 0.0f, 0.0f};
+    float dt = 0.01f; // Pas de temps plus fin pour la stabilité
+    float params[kMaxParams] = {10.0f, 28.0f, 8.0f / 3.0f};
+    Integrator integrator = Integrator::Euler;  // RK4, Exact et Taylor ignorés pour les applications
+    int taylorOrder = kTaylorOrder;             // Integrator::Taylor
+    // Double : état et paramètres calculés en double, p n'en est que l'arrondi
+    Precision precision = Precision::Single;
+
+    void update();
+    // État du calcul : en Precision::Double, la valeur exacte dont p est l'arrondi
+    Vec3<double> state() const;
+    void setState(const Vec3<double>& s);   // p en reçoit l'arrondi
+    void reset();            // Replace p sur le point de départ du type courant
+    void select(int type);   // Change de système (paramètres par défaut + reset)
+
+    // kCustomType sans système installé : entrée sans paramètres ni équations
+    static const SystemInfo& info(int type);
+    // Type d'après le nom, sans tenir compte de la casse ("lorenz", "Rössler"
+    // ou "rossler", "custom", le nom du système personnalisé ou d'un greffon) ;
+    // 0 si inconnu
+    static int find(const std::string& name);
+    // Type utilisable : 1 à kSystemCount, kCustomType une fois défini, types
+    // des greffons chargés
+    static bool available(int type);
+
+private:
+    Vec3<double> exact = {};    // État en Precision::Double
+    Point rounded = {};         // Arrondi de exact écrit dans p : s'il diffère,
+                                // p a été changé ailleurs et exact en repart
+};
+
+#endif // ATTRACTOR_H
 /**
- * Utils.h
- * 
- * Contient des fonctions utilitaires générales.
- */
\ No newline at end of file
+ * Attractor.h
+ *
+ * Contient la déclaration de la classe Attractor (les 14 systèmes, le
+ * système personnalisé et les greffons) et de son registre de systèmes.
+ */
@@ -0,0 +1,68 @@
+#ifndef ATTRACTORPLUGIN_H
+#define ATTRACTORPLUGIN_H
+
+#include <stdint.h>
+
+// Interface binaire (C) des greffons : une bibliothèque partagée compilée à
+// part, placée dans le dossier des greffons, exporte
+//
+//   const AttractorPluginSystem* attracteur_plugin_systems(int* count);
+//
+// qui renvoie un tableau de *count descripteurs, valides jusqu'à la fin du
+// processus (les bibliothèques ne sont jamais déchargées). Chaque système
+// reçoit un type à partir de 16 et passe par les mêmes aiguillages, lots SIMD
+// et fils de calcul que les 14 systèmes intégrés.
+//
+// Lots SoA, comme les programmes des systèmes personnalisés : pour n éléments,
+// l'entrée j de l'élément l est in[j * n + l], avec les entrées x, y, z puis
+// les param_count paramètres ; les sorties dx, dy, dz sont out[i * n + l].
+// Une application (is_map) écrit f(p) - p. Un système plan (dim = 2) écrit
+// dz = 0. Les fonctions sont appelées depuis plusieurs fils à la fois.
+//
+// La jacobienne est facultative : elle écrit d(dx_i)/d(x_j), i, j < 3, dans
+// out[(3 * i + j) * n + l] (neuf sorties par élément). Sans elle, les
+// estimateurs (Lyapunov, balayages) passent par des différences finies en
+// double.
+
+// Version de l'interface : incrémentée à chaque changement incompatible
+#define ATTRACTEUR_PLUGIN_ABI 1
+#define ATTRACTEUR_PLUGIN_MAX_PARAMS 6
+#define ATTRACTEUR_PLUGIN_ENTRY "attracteur_plugin_systems"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*AttractorBatchF)(const float* in, float* out, int n);
+typedef void (*AttractorBatchD)(const double* in, double* out, int n);
+
+typedef struct AttractorPluginSystem {
+    uint32_t abi;                   // ATTRACTEUR_PLUGIN_ABI
+    uint32_t size;                  // sizeof(AttractorPluginSystem)
+    const char* name;
+    int dim;                        // 2 ou 3
+    int is_map;
+    float initial[3];
+    float zoom;
+    int param_count;                // 0 à ATTRACTEUR_PLUGIN_MAX_PARAMS
+    const char* param_names[ATTRACTEUR_PLUGIN_MAX_PARAMS];
+    float param_defaults[ATTRACTEUR_PLUGIN_MAX_PARAMS];
+    AttractorBatchF field_f;        // Obligatoires
+    AttractorBatchD field_d;
+    AttractorBatchF jacobian_f;     // Facultatives (NULL)
+    AttractorBatchD jacobian_d;
+} AttractorPluginSystem;
+
+typedef const AttractorPluginSystem* (*AttractorPluginEntry)(int* count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ATTRACTORPLUGIN_H
+/**
+ * AttractorPlugin.h
+ *
+ * Contient l'interface binaire C des greffons de systèmes : descripteur,
+ * champ et jacobienne par lots SoA, point d'entrée de la bibliothèque.
+ */
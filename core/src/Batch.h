@@ -0,0 +1,73 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Une tâche d'un fichier --batch : une commande de Cli.cpp et ses options
+struct BatchJob {
+    std::string name;
+    std::string command;                                        // sweep, animate, lyapunov...
+    std::vector<std::pair<std::string, std::string>> options;  // "--clé valeur", sans les tirets ni threads
+    int threads = 1;                                            // Cœurs réservés pendant la tâche
+    std::vector<std::string> after;                             // Tâches à terminer avant celle-ci
+    bool customSystem = false;      // Installe un système personnalisé (system ou equations)
+};
+
+struct BatchFile {
+    int threads = 0;                // Budget de cœurs du fichier, 0 : tous
+    std::vector<BatchJob> jobs;
+};
+
+// Fichier de tâches (sous-ensemble de TOML, voir Toml.h) :
+//   threads = 8                    # budget, facultatif
+//   [[job]]
+//   name = "carte"                 # facultatif, "job-N" par défaut
+//   command = "sweep"
+//   threads = 2                    # 1 par défaut
+//   after = ["trajectoire"]        # facultatif
+//   type = "rossler"               # toute autre clé : option de la commande
+//   size = "512x512"
+//   color = [0, 1, 1]              # tableau : valeurs séparées par des virgules
+// Les noms doivent être uniques et les dépendances exister, sans cycle.
+bool readBatchFile(const std::string& path, BatchFile& out, std::string& error);
+bool parseBatch(const std::string& text, BatchFile& out, std::string& error);
+
+enum class BatchStatus { Done, Failed, Skipped };
+
+struct BatchJobResult {
+    BatchStatus status = BatchStatus::Skipped;
+    int code = 0;                   // Code de sortie de la commande
+    int threads = 0;                // Cœurs effectivement réservés
+    double start = 0.0;             // Secondes depuis le début du lot
+    double seconds = 0.0;
+};
+
+struct BatchReport {
+    std::vector<BatchJobResult> jobs;   // Dans l'ordre du fichier
+    int budget = 0;
+    int peakThreads = 0;            // Plus grand total de cœurs réservés à la fois
+    double seconds = 0.0;
+};
+
+// Lance les tâches dont les dépendances ont réussi, dans l'ordre du fichier,
+// tant que la somme de leurs cœurs tient dans budget (une tâche plus large
+// que le budget en reçoit le total) ; une tâche trop large pour les cœurs
+// libres n'empêche pas les suivantes de démarrer. Une tâche dont une
+// dépendance a échoué n'est pas lancée. Le système personnalisé est unique
+// dans le processus (CustomSystem.h) : les tâches qui en installent un
+// passent l'une après l'autre, jamais en même temps. run est appelé depuis un thread par
+// tâche et renvoie le code de sortie (0 : réussite) ; finished, appelé sous
+// verrou à chaque fin de tâche, peut afficher la progression.
+BatchReport runBatch(const std::vector<BatchJob>& jobs, int budget, const std::function<int(const BatchJob&)>& run,
+                     const std::function<void(size_t, const BatchJobResult&)>& finished = {});
+
+#endif // BATCH_H
+/**
+ * Batch.h
+ *
+ * Contient les tâches d'un fichier --batch et leur ordonnanceur à budget de
+ * cœurs.
+ */
@@ -0,0 +1,104 @@
+#ifndef BIFURCATION_H
+#define BIFURCATION_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Attractor.h"
+#include "Density.h"
+
+// Valeurs enregistrées pour chaque valeur du paramètre (flots uniquement ;
+// pour une application, chaque itéré est enregistré)
+enum class BifurcationRecord {
+    Maxima,     // Maxima locaux de la coordonnée axis
+    Section     // axis au passage montant de sectionAxis par sectionLevel
+};
+
+struct BifurcationSettings {
+    int type = 2;
+    int param = 2;                      // Paramètre balayé (une colonne par valeur)
+    float pMin = 2.0f, pMax = 12.0f;
+    int columns = 800, rows = 500;
+    int axis = 0;                       // Coordonnée enregistrée : 0 = x, 1 = y, 2 = z
+    BifurcationRecord record = BifurcationRecord::Maxima;
+    int sectionAxis = 1;
+    float sectionLevel = 0.0f;
+    float vMin = 0.0f, vMax = 0.0f;     // Plage des valeurs ; vMin == vMax : automatique
+    float dt = 0.01f;
+    long transient = 20000;
+    long steps = 100000;
+    int threads = 0;                    // 0 = tous les cœurs
+    float params[kMaxParams];
+    Point initial;
+
+    explicit BifurcationSettings(int type = 2);   // Paramètres du registre
+};
+
+// Colonnes terminées d'un diagramme, pour reprendre le calcul plus tard
+// (voir Session.h)
+struct BifurcationCheckpoint {
+    BifurcationSettings settings;   // Plage résolue (vMin < vMax)
+    DensityImage image;             // Colonnes non terminées à zéro
+    std::vector<uint8_t> columns;   // 1 = colonne terminée
+    double seconds = 0.0;
+};
+
+// Calcul en tâche de fond, colonne par colonne : chaque colonne terminée est
+// définitive et peut être affichée sans attendre les autres.
+class BifurcationDiagram {
+public:
+    BifurcationDiagram() = default;
+    ~BifurcationDiagram();
+    BifurcationDiagram(const BifurcationDiagram&) = delete;
+    BifurcationDiagram& operator=(const BifurcationDiagram&) = delete;
+
+    void start(const BifurcationSettings& settings);
+    // Ne calcule que les colonnes non terminées de la sauvegarde
+    bool resume(const BifurcationCheckpoint& checkpoint);
+    // Copie des colonnes terminées, possible pendant le calcul
+    void snapshot(BifurcationCheckpoint& out) const;
+    void cancel();
+    void wait();
+    bool isRunning() const { return activeThreads > 0; }
+    int columnsDone() const { return done; }
+    bool columnDone(int col) const { return columnFlags[col].load(std::memory_order_acquire) != 0; }
+    double seconds() const;
+    // Plage des valeurs (résolue au début du calcul si elle est automatique)
+    float valueMin() const { return rangeMin; }
+    float valueMax() const { return rangeMax; }
+
+    // Les colonnes dont columnDone() est vrai peuvent être lues pendant le calcul
+    const DensityImage& image() const { return density; }
+    const BifurcationSettings& settings() const { return current; }
+
+private:
+    void launch(const BifurcationSettings& settings, const BifurcationCheckpoint* from);
+    void worker();
+
+    BifurcationSettings current;
+    DensityImage density;
+    std::unique_ptr<std::atomic<uint8_t>[]> columnFlags;
+    std::vector<std::thread> pool;
+    std::atomic<int> nextColumn{0};
+    std::atomic<int> done{0};
+    std::atomic<int> activeThreads{0};
+    std::atomic<bool> cancelRequested{false};
+    std::atomic<float> rangeMin{0.0f}, rangeMax{0.0f};
+    std::unique_ptr<std::once_flag> rangeOnce;
+    std::atomic<double> elapsed{0.0};
+    double startTime = 0.0;
+    double previousSeconds = 0.0;   // Durée des calculs dont celui-ci est la reprise
+};
+
+// Calcul synchrone (ligne de commande)
+DensityImage computeBifurcation(BifurcationSettings settings);
+
+#endif // BIFURCATION_H
+/**
+ * Bifurcation.h
+ *
+ * Contient le diagramme de bifurcation calculé en parallèle et affiché au fur
+ * et à mesure.
+ */
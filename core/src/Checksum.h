@@ -0,0 +1,19 @@
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <cstddef>
+#include <cstdint>
+
+// CRC-32 (polynôme 0xEDB88320, celui de zlib et de PNG), chaînable :
+// crc32(crc32(0, a, n), b, m) == crc32(0, a + b, n + m)
+uint32_t crc32(uint32_t crc, const void* data, size_t bytes);
+
+// Adler-32 du flux zlib, chaînable de la même façon (départ : 1)
+uint32_t adler32(uint32_t adler, const void* data, size_t bytes);
+
+#endif // CHECKSUM_H
+/**
+ * Checksum.h
+ *
+ * Contient les sommes de contrôle CRC-32 et Adler-32.
+ */
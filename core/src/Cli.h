@@ -0,0 +1,17 @@
+#ifndef CLI_H
+#define CLI_H
+
+// Commandes sans interface graphique (balayages, exports...).
+// Renvoie le code de sortie, ou -1 si argv[1] n'est pas une commande connue.
+int runCommandLine(int argc, char* argv[]);
+
+// Affiche la liste des commandes sur stderr
+void printCommandLineUsage(const char* program);
+
+#endif // CLI_H
+/**
+ * Cli.h
+ *
+ * Contient le point d'entrée des commandes en ligne de commande, partagé par
+ * l'application graphique et attracteurs_cli.
+ */
@@ -0,0 +1,40 @@
+#ifndef CONTROL_H
+#define CONTROL_H
+
+#include "Animation.h"
+#include "Attractor.h"
+#include "Json.h"
+
+// Ce que l'API de contrôle peut modifier, sans SDL : la simulation, la vue
+// (recopiée depuis et vers Renderer par l'application) et l'export
+// d'animation
+struct ControlTarget {
+    Attractor& attractor;
+    FrameView& view;
+    AnimationExport& animation;
+    bool resetPoints = false;       // Mis à vrai quand la trajectoire affichée doit repartir de zéro
+};
+
+// Commandes communes (champ "cmd" de la requête) :
+//   status                         état complet
+//   set   type, params, dt, integrator, order (Taylor), precision, point,
+//         camera {yaw, pitch, zoom}, color [r, g, b], reset
+//                                  tout est vérifié avant d'appliquer
+//   animate  mode, frames, size [w, h], steps, turns, param, range [a, b],
+//            keys [{frame, params, yaw, pitch, zoom}], smooth, style, out,
+//            pipe, fps             lance le rendu hors écran (voir Animation.h)
+//   cancel                         interrompt l'animation en cours
+// Faux si la commande n'en fait pas partie (l'appelant traite les siennes) ;
+// une erreur est signalée par un membre "error" dans reply.
+bool handleControl(const Json& request, Json& reply, ControlTarget& target);
+
+// Résumé de la simulation et de l'animation (réponse de status)
+void controlStatus(const ControlTarget& target, Json& reply);
+
+#endif // CONTROL_H
+/**
+ * Control.h
+ *
+ * Contient les commandes de l'API de contrôle qui ne dépendent pas de
+ * l'interface (réglages du système, de la vue, animation).
+ */
@@ -0,0 +1,77 @@
+#ifndef CONTROL_SERVER_H
+#define CONTROL_SERVER_H
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Json.h"
+
+// API de contrôle d'une instance en cours : un socket Unix (droits 0600) où
+// chaque client envoie des objets JSON, un par ligne, et reçoit une réponse
+// par ligne dans le même ordre. Un thread dédié gère les connexions et le
+// découpage en lignes ; les requêtes ne sont exécutées que par poll(), sur
+// le thread principal, entre deux images : le gestionnaire n'a besoin
+// d'aucun verrou pour toucher à la simulation ou à l'interface.
+//
+// Réponse : l'objet rempli par le gestionnaire, avec "id" recopié de la
+// requête et "ok" (vrai par défaut, faux si le gestionnaire a mis "error").
+class ControlServer {
+public:
+    using Handler = std::function<void(const Json& request, Json& reply)>;
+
+    ControlServer() = default;
+    ~ControlServer();
+    ControlServer(const ControlServer&) = delete;
+    ControlServer& operator=(const ControlServer&) = delete;
+
+    // Faux si le chemin est pris par une instance active ou si le socket ne
+    // peut être créé (voir error()). Un socket abandonné est remplacé.
+    bool start(const std::string& path);
+    void stop();
+    bool isRunning() const { return thread.joinable(); }
+    const std::string& path() const { return socketPath; }
+    const std::string& error() const { return lastError; }
+
+    // Exécute au plus max requêtes en attente ; renvoie leur nombre
+    int poll(const Handler& handler, int max = 64);
+    int clients() const { return connected; }
+
+private:
+    struct Request {
+        int client;
+        Json body;
+        std::string error;          // Ligne rejetée : réponse d'erreur, dans l'ordre
+    };
+
+    void serve();
+    void reply(int client, const std::string& line);
+
+    std::string socketPath;
+    std::string lastError;
+    int listener = -1;
+    int wake[2] = {-1, -1};             // Réveil du thread (réponses, arrêt)
+    std::thread thread;
+    std::atomic<bool> stopRequested{false};
+    std::atomic<int> connected{0};
+
+    std::mutex mutex;
+    std::deque<Request> requests;       // Sous mutex
+    std::deque<std::pair<int, std::string>> replies;
+};
+
+// Client : envoie les requêtes (une par ligne) sur une même connexion et
+// attend autant de réponses, au plus timeoutMs en tout
+bool controlRequest(const std::string& path, const std::vector<std::string>& requests,
+                    std::vector<std::string>& replies, std::string& error, int timeoutMs = 10000);
+
+#endif // CONTROL_SERVER_H
+/**
+ * ControlServer.h
+ *
+ * Contient le serveur de contrôle (JSON ligne par ligne sur socket Unix) et
+ * son client minimal.
+ */
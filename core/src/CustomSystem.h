@@ -0,0 +1,56 @@
+#ifndef CUSTOMSYSTEM_H
+#define CUSTOMSYSTEM_H
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "Attractor.h"
+#include "Expression.h"
+
+// Système saisi par l'utilisateur (type Attractor::kCustomType) : équations
+// en fonction de x, y, z et des paramètres nommés (grammaire : Expression.h)
+struct CustomDefinition {
+    std::string name = "Personnalisé";
+    std::string equations[3];                           // dx, dy, dz (dz vide : système plan)
+    std::vector<std::pair<std::string, float>> params;  // Noms et valeurs par défaut (6 au plus)
+    bool isMap = false;     // Application : équations = point suivant (x' = ...)
+    Point initial = {0.1f, 0.0f, 0.0f};
+    float zoom = 15.0f;
+    bool native = false;    // Noyaux compilés par le compilateur local (Jit.h)
+};
+
+// Compile et installe le système ; faux avec le message de l'analyseur
+// ("dy : position 7 : ...") sans rien changer en cas d'erreur.
+// Les versions compilées ne sont jamais libérées : un calcul en cours garde
+// des programmes valides et passe aux nouvelles équations au pas suivant.
+bool defineCustomSystem(const CustomDefinition& def, std::string& error);
+bool hasCustomSystem();
+// Exécution du système installé : « machine virtuelle », « natif (cache) »,
+// « natif (compilé en 0.8 s) » ou la raison du repli sur la machine virtuelle
+std::string customBackend();
+CustomDefinition customDefinition();    // Système installé (défaut si aucun)
+const SystemInfo* customSystemInfo();   // nullptr si aucun système installé
+
+// Fichier de système (sous-ensemble de TOML, voir Toml.h) :
+//   name = "Lorenz bis"          # facultatif
+//   dx = "sigma * (y - x)"
+//   dy = "x * (rho - z) - y"
+//   dz = "x * y - beta * z"      # facultatif : système plan
+//   map = false                  # facultatif
+//   initial = [0.1, 0, 0]        # facultatif
+//   zoom = 15                    # facultatif
+//   native = true                # facultatif : compilation native
+//   [params]                     # dans l'ordre du fichier
+//   sigma = 10
+bool readCustomSystem(const std::string& path, CustomDefinition& out, std::string& error);
+bool parseCustomSystem(const std::string& text, CustomDefinition& out, std::string& error);
+// "sigma=10,rho=28" ; faux si un élément n'a pas la forme nom=valeur
+bool parseCustomParams(const std::string& text, std::vector<std::pair<std::string, float>>& out, std::string& error);
+
+#endif // CUSTOMSYSTEM_H
+/**
+ * CustomSystem.h
+ *
+ * Contient la définition des systèmes saisis par l'utilisateur, leur lecture
+ * depuis un fichier et leur installation comme type personnalisé.
+ */
@@ -0,0 +1,38 @@
+#ifndef DELTA_CODEC_H
+#define DELTA_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Compression d'une colonne de coordonnées successives (x, y ou z d'un bloc) :
+//   1. quantification au pas quantum : q[i] = round(v[i] / quantum), d'où une
+//      erreur absolue d'au plus quantum / 2 à la relecture ;
+//   2. prédiction polynomiale de q[i] par les valeurs précédentes, d'ordre 0
+//      (aucune) à 3, choisie par paquet de kDeltaBlock valeurs : d'un pas au
+//      suivant une trajectoire varie peu, une application (Hénon...) saute ;
+//   3. résidus en zigzag codés en Rice, paramètre choisi par paquet.
+// Chaque colonne se décode seule : les blocs d'un fichier se décodent en
+// parallèle.
+constexpr size_t kDeltaBlock = 64;
+
+// Vrai si toutes les valeurs sont finies et représentables au pas quantum
+// (sinon le bloc est enregistré brut)
+template <typename T>
+bool deltaEncodable(const T* values, size_t count, double quantum);
+
+// Ajoute le codage de values à out (complété à 8 octets)
+template <typename T>
+void deltaEncode(const T* values, size_t count, double quantum, std::vector<uint8_t>& out);
+
+// Décode count valeurs ; faux si les données sont tronquées ou invalides
+template <typename T>
+bool deltaDecode(const uint8_t* data, size_t bytes, size_t count, double quantum, T* out);
+
+#endif // DELTA_CODEC_H
+/**
+ * DeltaCodec.h
+ *
+ * Contient le codage compressé (quantification, prédiction, Rice) des
+ * colonnes de trajectoire.
+ */
@@ -0,0 +1,39 @@
+#ifndef DENSITY_H
+#define DENSITY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Histogramme 2D d'accumulation (diagramme de bifurcation, section de Poincaré...)
+// counts[row * width + col], ligne 0 en haut de l'image.
+struct DensityImage {
+    int width = 0, height = 0;
+    std::vector<uint32_t> counts;
+
+    void resize(int w, int h) { width = w; height = h; counts.assign(size_t(w) * h, 0); }
+    void clear() { counts.assign(counts.size(), 0); }
+};
+
+enum class DensityScale {
+    Global,     // log(1 + n) / log(1 + max de l'image)
+    PerColumn   // Chaque colonne normalisée par son propre maximum
+};
+
+// Convertit les colonnes [col0, col1) en pixels RGBA (4 octets par pixel,
+// pitch = width * 4), palette « feu » sur fond noir
+void densityToRgba(const DensityImage& image, DensityScale scale, int col0, int col1, uint8_t* rgba);
+
+// Image de toute l'accumulation : PNG si path se termine par .png, sinon PPM
+// binaire
+bool writeDensityImage(const DensityImage& image, DensityScale scale, const std::string& path);
+// Comptes bruts en .npy : uint32 (height, width), ligne 0 en haut de l'image
+bool writeDensityNpy(const DensityImage& image, const std::string& path);
+
+#endif // DENSITY_H
+/**
+ * Density.h
+ *
+ * Contient l'image d'accumulation partagée par les diagrammes et sa mise en
+ * couleurs.
+ */
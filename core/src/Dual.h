@@ -0,0 +1,84 @@
+#ifndef DUAL_H
+#define DUAL_H
+
+#include <cmath>
+
+// Signe (-1, 0 ou 1) : dérivée de abs. Lanes.h a le sien.
+inline float signum(float x) { return float((x > 0.0f) - (x < 0.0f)); }
+inline double signum(double x) { return double((x > 0.0) - (x < 0.0)); }
+
+// Nombre dual de N directions : valeur v et dérivées d[i] = dv/de_i.
+// Les noyaux de Systems.h instanciés avec Dual calculent en même temps le
+// champ et ses dérivées (différentiation automatique en mode direct) ;
+// T peut être un Lanes, les dérivées de W trajectoires sont alors vectorisées.
+// Les opérations avec un scalaire T évitent de multiplier des dérivées nulles,
+// et la valeur v est calculée exactement comme avec T seul (mêmes arrondis).
+template <typename T, int N>
+struct Dual {
+    T v;
+    T d[N];
+
+    Dual() = default;
+    Dual(const T& s) : v(s) { for (int i = 0; i < N; i++) d[i] = T(0); }   // Constante
+
+    // Variable i : dérivée 1 dans sa direction, 0 ailleurs
+    static Dual variable(const T& s, int i) { Dual r(s); r.d[i] = T(1); return r; }
+
+    friend Dual operator+(const Dual& a, const Dual& b) { Dual r; r.v = a.v + b.v; for (int i = 0; i < N; i++) r.d[i] = a.d[i] + b.d[i]; return r; }
+    friend Dual operator-(const Dual& a, const Dual& b) { Dual r; r.v = a.v - b.v; for (int i = 0; i < N; i++) r.d[i] = a.d[i] - b.d[i]; return r; }
+    friend Dual operator*(const Dual& a, const Dual& b) { Dual r; r.v = a.v * b.v; for (int i = 0; i < N; i++) r.d[i] = a.d[i] * b.v + a.v * b.d[i]; return r; }
+    friend Dual operator/(const Dual& a, const Dual& b) {
+        Dual r;
+        T inv = T(1) / b.v;
+        r.v = a.v / b.v;
+        for (int i = 0; i < N; i++) r.d[i] = (a.d[i] - r.v * b.d[i]) * inv;
+        return r;
+    }
+    friend Dual operator-(const Dual& a) { Dual r; r.v = -a.v; for (int i = 0; i < N; i++) r.d[i] = -a.d[i]; return r; }
+
+    friend Dual operator+(const Dual& a, const T& s) { Dual r = a; r.v = a.v + s; return r; }
+    friend Dual operator+(const T& s, const Dual& a) { return a + s; }
+    friend Dual operator-(const Dual& a, const T& s) { Dual r = a; r.v = a.v - s; return r; }
+    friend Dual operator-(const T& s, const Dual& a) { Dual r; r.v = s - a.v; for (int i = 0; i < N; i++) r.d[i] = -a.d[i]; return r; }
+    friend Dual operator*(const Dual& a, const T& s) { Dual r; r.v = a.v * s; for (int i = 0; i < N; i++) r.d[i] = a.d[i] * s; return r; }
+    friend Dual operator*(const T& s, const Dual& a) { return a * s; }
+    friend Dual operator/(const Dual& a, const T& s) {
+        Dual r;
+        T inv = T(1) / s;
+        r.v = a.v / s;
+        for (int i = 0; i < N; i++) r.d[i] = a.d[i] * inv;
+        return r;
+    }
+    friend Dual operator/(const T& s, const Dual& a) {
+        Dual r;
+        T inv = T(1) / a.v;
+        r.v = s / a.v;
+        for (int i = 0; i < N; i++) r.d[i] = -r.v * a.d[i] * inv;
+        return r;
+    }
+
+    Dual& operator+=(const Dual& b) { return *this = *this + b; }
+    Dual& operator-=(const Dual& b) { return *this = *this - b; }
+    Dual& operator*=(const Dual& b) { return *this = *this * b; }
+
+    // Règle de la chaîne : f(a) = f(a.v) + f'(a.v) a.d
+    friend Dual chain(const Dual& a, const T& value, const T& slope) {
+        Dual r;
+        r.v = value;
+        for (int i = 0; i < N; i++) r.d[i] = slope * a.d[i];
+        return r;
+    }
+    friend Dual sin(const Dual& a) { using std::sin; using std::cos; return chain(a, sin(a.v), cos(a.v)); }
+    friend Dual cos(const Dual& a) { using std::sin; using std::cos; return chain(a, cos(a.v), -sin(a.v)); }
+    friend Dual abs(const Dual& a) { using std::abs; return chain(a, abs(a.v), signum(a.v)); }
+    friend Dual floor(const Dual& a) { using std::floor; return Dual(floor(a.v)); }    // Dérivée nulle presque partout
+    friend Dual sqrt(const Dual& a) { using std::sqrt; T r = sqrt(a.v); return chain(a, r, T(0.5) / r); }
+};
+
+#endif // DUAL_H
+/**
+ * Dual.h
+ *
+ * Contient le type Dual (valeur et dérivées dans N directions) qui donne les
+ * jacobiennes des systèmes par différentiation automatique des champs.
+ */
@@ -0,0 +1,100 @@
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Programme compilé d'un ensemble d'expressions : instructions à trois
+// registres, chacune appliquée à tout un lot de n valeurs (une trajectoire
+// par élément) ; le coût de l'interprétation est ainsi partagé par le lot et
+// les boucles internes sont vectorisées. Registres : entrées, puis
+// constantes, puis temporaires réutilisés dès leur dernière lecture.
+class ExpressionProgram {
+public:
+    enum class Op : uint8_t {
+        Add, Sub, Mul, Div, Neg, Pow, Min, Max,
+        Sin, Cos, Tan, Tanh, Atan, Exp, Log, Sqrt, Abs, Floor, Sign, Step
+    };
+
+    struct Instruction {
+        Op op;
+        uint16_t dst, a, b;     // b ignoré par les opérations à un argument
+    };
+
+    int inputCount() const { return inputs; }
+    int outputCount() const { return int(outputs.size()); }
+    size_t instructionCount() const { return code.size(); }
+    int registerCount() const { return registers; }
+
+    // in[i * n + l] : entrée i de l'élément l ; out[j * n + l] de même.
+    // Instancié pour float et double ; registres dans un tampon par thread
+    template <typename T>
+    void run(const T* in, T* out, int n) const;
+
+    // Noyaux natifs du même programme (Jit.h) : run les appelle à la place
+    // de la machine virtuelle
+    using FloatKernel = void (*)(const float* in, float* out, int n);
+    using DoubleKernel = void (*)(const double* in, double* out, int n);
+    void attachNative(FloatKernel f, DoubleKernel d) { nativeFloat = f; nativeDouble = d; }
+    bool isNative() const { return nativeFloat != nullptr; }
+
+private:
+    friend class ExpressionCompiler;
+    friend std::string nativeSource(const std::vector<const ExpressionProgram*>& programs);
+
+    // Boucle des instructions ; Width > 0 : largeur du lot connue à la
+    // compilation (boucles internes déroulées), 0 : n quelconque
+    template <int Width, typename T>
+    void execute(T* r, int n) const;
+
+    uint64_t id = 0;        // Identifiant de compilation (constantes déjà en place)
+    int inputs = 0;
+    int registers = 0;
+    std::vector<double> constants;      // Registres inputs à inputs + constants.size() - 1
+    std::vector<Instruction> code;
+    std::vector<uint16_t> outputs;      // Registre de chaque sortie
+    FloatKernel nativeFloat = nullptr;
+    DoubleKernel nativeDouble = nullptr;
+};
+
+struct ExpressionSource {
+    std::string label;  // Nom dans les messages d'erreur ("dx")
+    std::string text;
+    int minus = -1;     // Variable retranchée au résultat (application écrite f(p) - p)
+};
+
+// Compile une sortie par source ; variables : noms des entrées, dans l'ordre.
+// Grammaire (espaces libres) :
+//   somme   := produit (('+' | '-') produit)*
+//   produit := unaire (('*' | '/') unaire)*
+//   unaire  := ('-' | '+') unaire | puissance
+//   puissance := primaire ('^' unaire)?          (2^-x, -x^2 = -(x^2))
+//   primaire  := nombre | nom | nom '(' somme (',' somme)* ')' | '(' somme ')'
+// Fonctions : sin cos tan tanh atan exp log sqrt abs floor sign step (x > 0),
+// min max pow ; constantes pi et e (sauf variable du même nom).
+// Les sous-expressions constantes sont calculées à la compilation, les
+// sous-expressions communes partagées, x^n (n entier, |n| <= 4) développé.
+// tangentOf > 0 : les tangentOf premières variables reçoivent en plus une
+// entrée de direction (après les variables, dans le même ordre) et le
+// programme sort après les valeurs la dérivée de chaque source dans cette
+// direction (produit jacobienne-vecteur, dérivation du même graphe).
+// Imbrication limitée (256 niveaux, 4096 opérations enchaînées) : au-delà,
+// "imbrication trop profonde".
+// Faux avec "label : position P : ..." en cas d'erreur.
+bool compileExpressions(const std::vector<ExpressionSource>& sources, const std::vector<std::string>& variables,
+                        int tangentOf, ExpressionProgram& out, std::string& error);
+
+// Traduction C++ des programmes : une fonction par programme et par type,
+// attracteur_kernel_<i>_f et attracteur_kernel_<i>_d (extern "C", signature
+// de run), mêmes opérations dans le même ordre que la machine virtuelle.
+std::string nativeSource(const std::vector<const ExpressionProgram*>& programs);
+
+#endif // EXPRESSION_H
+/**
+ * Expression.h
+ *
+ * Contient le compilateur d'expressions (équations saisies par l'utilisateur),
+ * la machine virtuelle qui exécute le bytecode sur des lots et sa traduction
+ * en C++ pour la compilation native.
+ */
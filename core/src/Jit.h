@@ -0,0 +1,39 @@
+#ifndef JIT_H
+#define JIT_H
+
+#include <string>
+#include <vector>
+#include "Expression.h"
+
+struct JitResult {
+    bool ok = false;
+    bool cached = false;        // Bibliothèque déjà compilée par une session précédente
+    double seconds = 0.0;       // Génération, compilation et chargement
+    std::string path;           // Bibliothèque chargée
+    std::string error;          // Compilateur absent, erreur de compilation...
+};
+
+// Compile les programmes en une bibliothèque partagée (nativeSource, puis le
+// compilateur C++ local en -O3 -march=native) et y branche leurs noyaux
+// (ExpressionProgram::attachNative). La bibliothèque est rangée dans le
+// dossier de cache sous le hachage de sa source, de la commande et de la
+// cible de -march=native (macros prédéfinies du compilateur) : les sessions
+// suivantes la rechargent sans recompiler, sur un processeur du même type.
+// La bibliothèque n'est jamais déchargée, comme les programmes du système
+// personnalisé. Le compilateur est lancé sans shell.
+// Variables d'environnement : ATTRACTEUR_JIT_CXX (compilateur, par défaut
+// celui du build), ATTRACTEUR_JIT_CACHE (dossier, par défaut
+// $XDG_CACHE_HOME/attracteurs/jit ou ~/.cache/attracteurs/jit).
+// En cas d'échec, les programmes restent sur la machine virtuelle.
+JitResult compileNative(const std::vector<ExpressionProgram*>& programs);
+
+// Dossier de cache effectif (voir ci-dessus)
+std::string jitCacheDirectory();
+
+#endif // JIT_H
+/**
+ * Jit.h
+ *
+ * Contient la compilation native des programmes d'expressions (C++ généré,
+ * compilateur local, chargement dynamique) et son cache.
+ */
@@ -0,0 +1,55 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// Valeur JSON minimale (API de contrôle) : les membres d'un objet gardent
+// leur ordre, les nombres sont des double
+struct Json {
+    enum class Kind { Null, Bool, Number, String, Array, Object };
+
+    Kind kind = Kind::Null;
+    bool boolean = false;
+    double number = 0.0;
+    std::string text;
+    std::vector<Json> items;                            // Array
+    std::vector<std::pair<std::string, Json>> members;  // Object
+
+    Json() = default;
+    Json(bool b) : kind(Kind::Bool), boolean(b) {}
+    Json(double n) : kind(Kind::Number), number(n) {}
+    Json(int n) : kind(Kind::Number), number(n) {}
+    Json(long long n) : kind(Kind::Number), number(double(n)) {}
+    Json(const char* s) : kind(Kind::String), text(s) {}
+    Json(const std::string& s) : kind(Kind::String), text(s) {}
+
+    static Json array() { Json j; j.kind = Kind::Array; return j; }
+    static Json object() { Json j; j.kind = Kind::Object; return j; }
+
+    bool isNumber() const { return kind == Kind::Number; }
+    bool isString() const { return kind == Kind::String; }
+    bool isObject() const { return kind == Kind::Object; }
+    bool isArray() const { return kind == Kind::Array; }
+
+    // Membre key d'un objet ; nullptr s'il manque (ou si ce n'est pas un objet)
+    const Json* find(const std::string& key) const;
+    // Ajoute ou remplace le membre key (la valeur devient un objet)
+    Json& set(const std::string& key, Json value);
+    Json& push(Json value);
+};
+
+// Analyse un texte JSON complet (RFC 8259, \uXXXX compris) ; faux avec un
+// message et la position en cas d'erreur
+bool parseJson(const std::string& text, Json& out, std::string& error);
+
+// Forme compacte sur une ligne
+std::string toJson(const Json& value);
+
+#endif // JSON_H
+/**
+ * Json.h
+ *
+ * Contient une valeur JSON, son analyse et son écriture compacte.
+ */
@@ -0,0 +1,42 @@
+#ifndef LANES_H
+#define LANES_H
+
+#include <cmath>
+
+// Paquet de W valeurs traitées ensemble : les noyaux de Systems.h instanciés
+// avec Lanes calculent W trajectoires à la fois (une par cellule d'un balayage).
+// Les opérations sont des boucles fixes que le compilateur vectorise (SSE/AVX).
+template <typename S, int W>
+struct Lanes {
+    S v[W];
+
+    Lanes() = default;
+    Lanes(S s) { for (int l = 0; l < W; l++) v[l] = s; }   // Diffusion d'un scalaire
+
+    S& operator[](int l) { return v[l]; }
+    const S& operator[](int l) const { return v[l]; }
+
+    friend Lanes operator+(const Lanes& a, const Lanes& b) { Lanes r; for (int l = 0; l < W; l++) r.v[l] = a.v[l] + b.v[l]; return r; }
+    friend Lanes operator-(const Lanes& a, const Lanes& b) { Lanes r; for (int l = 0; l < W; l++) r.v[l] = a.v[l] - b.v[l]; return r; }
+    friend Lanes operator*(const Lanes& a, const Lanes& b) { Lanes r; for (int l = 0; l < W; l++) r.v[l] = a.v[l] * b.v[l]; return r; }
+    friend Lanes operator/(const Lanes& a, const Lanes& b) { Lanes r; for (int l = 0; l < W; l++) r.v[l] = a.v[l] / b.v[l]; return r; }
+    friend Lanes operator-(const Lanes& a) { Lanes r; for (int l = 0; l < W; l++) r.v[l] = -a.v[l]; return r; }
+    Lanes& operator+=(const Lanes& b) { for (int l = 0; l < W; l++) v[l] += b.v[l]; return *this; }
+    Lanes& operator-=(const Lanes& b) { for (int l = 0; l < W; l++) v[l] -= b.v[l]; return *this; }
+    Lanes& operator*=(const Lanes& b) { for (int l = 0; l < W; l++) v[l] *= b.v[l]; return *this; }
+
+    friend Lanes sin(const Lanes& a) { Lanes r; for (int l = 0; l < W; l++) r.v[l] = std::sin(a.v[l]); return r; }
+    friend Lanes cos(const Lanes& a) { Lanes r; for (int l = 0; l < W; l++) r.v[l] = std::cos(a.v[l]); return r; }
+    friend Lanes abs(const Lanes& a) { Lanes r; for (int l = 0; l < W; l++) r.v[l] = std::abs(a.v[l]); return r; }
+    friend Lanes floor(const Lanes& a) { Lanes r; for (int l = 0; l < W; l++) r.v[l] = std::floor(a.v[l]); return r; }
+    friend Lanes sqrt(const Lanes& a) { Lanes r; for (int l = 0; l < W; l++) r.v[l] = std::sqrt(a.v[l]); return r; }
+    friend Lanes signum(const Lanes& a) { Lanes r; for (int l = 0; l < W; l++) r.v[l] = S((a.v[l] > S(0)) - (a.v[l] < S(0))); return r; }
+};
+
+#endif // LANES_H
+/**
+ * Lanes.h
+ *
+ * Contient le type Lanes (W valeurs en parallèle) utilisé pour vectoriser les
+ * balayages de paramètres sur les mêmes noyaux que Attractor::update.
+ */
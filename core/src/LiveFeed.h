@@ -0,0 +1,145 @@
+#ifndef LIVE_FEED_H
+#define LIVE_FEED_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "Attractor.h"
+
+// Flux en direct de la simulation pour d'autres programmes locaux (tracés,
+// sonification, enregistreurs) : une mémoire partagée nommée (shm_open, ou
+// CreateFileMapping sous Windows) contient les derniers états dans un anneau
+// et un résumé de la simulation. L'application n'attend jamais les lecteurs :
+// publier revient à écrire en mémoire, et un lecteur trop lent perd les
+// états écrasés (il le sait, voir LiveFeedReader::read).
+//
+// Disposition (alignement natif, petit-boutiste) :
+//   [0, kLiveHeaderBytes)   LiveHeader
+//   [kLiveHeaderBytes, ...) capacity états Point (3 float), l'état n dans la
+//                           case n % capacity
+
+constexpr uint32_t kLiveVersion = 1;
+constexpr uint32_t kLiveHeaderBytes = 512;
+
+// Résumé de la simulation, protégé par LiveHeader::sequence
+struct LiveSnapshot {
+    int32_t type = 0;
+    float dt = 0.0f;
+    float params[kMaxParams] = {};
+    float yaw = 0.0f, pitch = 0.0f, zoom = 0.0f;
+    uint64_t head = 0;              // États publiés (LiveHeader::head)
+    Point current = {0.0f, 0.0f, 0.0f};
+    // Statistiques des états publiés depuis le dernier restart()
+    uint64_t samples = 0;
+    Point mean = {0.0f, 0.0f, 0.0f};
+    Point min = {0.0f, 0.0f, 0.0f}, max = {0.0f, 0.0f, 0.0f};
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "compteurs partagés entre processus");
+
+struct LiveHeader {
+    char magic[8];                  // "ATRLIVE\0"
+    uint32_t version;
+    uint32_t headerBytes;           // Début de l'anneau
+    uint32_t capacity;              // États dans l'anneau
+    uint32_t stateBytes;            // sizeof(Point)
+    uint64_t writerPid;
+    // Anneau : les états [head - capacity, head) sont lisibles. reserve est
+    // avancé avant d'écrire les cases et head après : une case lue est
+    // valide si, relu après la copie, reserve ne l'a pas encore rattrapée
+    alignas(64) std::atomic<uint64_t> head;
+    std::atomic<uint64_t> reserve;
+    // Verrou de séquence du résumé : impair pendant l'écriture
+    alignas(64) std::atomic<uint64_t> sequence;
+    LiveSnapshot snapshot;
+};
+
+static_assert(sizeof(LiveHeader) <= kLiveHeaderBytes, "en-tête du flux trop grand");
+
+// Mémoire partagée nommée : en écriture pour son créateur, en lecture seule
+// pour les autres
+class SharedMemory {
+public:
+    SharedMemory() = default;
+    ~SharedMemory();
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    // create : crée (ou remplace) l'objet name de size octets ; sinon ouvre
+    // l'objet existant dans toute sa taille
+    bool open(const std::string& name, bool create, uint64_t size = 0);
+    void close();
+
+    bool isOpen() const { return base != nullptr; }
+    uint8_t* data() const { return base; }
+    uint64_t size() const { return length; }
+
+private:
+    std::string owned;              // Nom à retirer à la fermeture (créateur)
+    uint8_t* base = nullptr;
+    uint64_t length = 0;
+#ifdef _WIN32
+    void* mapping = nullptr;
+#endif
+};
+
+class LiveFeedWriter {
+public:
+    // name : "/attracteurs" (POSIX) ; sous Windows, "Local\attracteurs"
+    bool open(const std::string& name, uint32_t capacity = 1u << 16);
+    void close() { memory.close(); }
+    bool isOpen() const { return memory.isOpen(); }
+    const std::string& name() const { return feedName; }
+
+    // Ajoute count états à l'anneau et met à jour le résumé. description
+    // fournit type, dt, paramètres et caméra ; le reste est calculé ici.
+    void publish(const Point* states, size_t count, const LiveSnapshot& description);
+    // Remet à zéro les statistiques (changement de système, réinitialisation)
+    void restart() { stats = LiveSnapshot(); }
+    uint64_t published() const { return written; }
+
+private:
+    LiveHeader* header() const { return reinterpret_cast<LiveHeader*>(memory.data()); }
+
+    SharedMemory memory;
+    std::string feedName;
+    Point* ring = nullptr;
+    uint32_t capacity = 0;
+    uint64_t written = 0;
+    LiveSnapshot stats;
+    double sum[3] = {0.0, 0.0, 0.0};
+};
+
+class LiveFeedReader {
+public:
+    bool open(const std::string& name);
+    void close() { memory.close(); }
+    bool isOpen() const { return memory.isOpen(); }
+    const std::string& error() const { return lastError; }
+    uint32_t capacity() const { return header()->capacity; }
+    uint64_t head() const { return header()->head.load(std::memory_order_acquire); }
+
+    // Copie au plus max états à partir de l'état next dans out, et avance
+    // next. Les états déjà écrasés (lecteur en retard) sont sautés et comptés
+    // dans lost. Renvoie le nombre d'états copiés.
+    size_t read(uint64_t& next, Point* out, size_t max, uint64_t& lost) const;
+
+    // Copie cohérente du résumé ; faux si l'écrivain n'a pas laissé de
+    // fenêtre après spins essais
+    bool snapshot(LiveSnapshot& out, int spins = 10000) const;
+
+private:
+    const LiveHeader* header() const { return reinterpret_cast<const LiveHeader*>(memory.data()); }
+
+    SharedMemory memory;
+    const Point* ring = nullptr;
+    std::string lastError;
+};
+
+#endif // LIVE_FEED_H
+/**
+ * LiveFeed.h
+ *
+ * Contient la publication en mémoire partagée des derniers états de la
+ * simulation (anneau et résumé sous verrou de séquence) et son lecteur.
+ */
@@ -0,0 +1,69 @@
+#ifndef LYAPUNOV_H
+#define LYAPUNOV_H
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Attractor.h"
+
+// Réglages de la méthode de Benettin (vecteurs tangents + orthonormalisation QR)
+struct LyapunovSettings {
+    long transient = 10000;     // Pas ignorés avant de mesurer
+    long maxSteps = 50000000;   // Arrêt automatique
+    long batch = 20000;         // Pas entre deux publications du résultat
+    int orthoInterval = 10;     // Pas entre deux orthonormalisations
+};
+
+struct LyapunovResult {
+    int type = 0;
+    int count = 0;              // dim exposants pour un flot, 1 pour une application
+    bool isMap = false;
+    bool diverged = false;
+    bool finished = false;
+    long steps = 0;
+    double exponents[3] = {0.0, 0.0, 0.0};   // Par unité de temps (flot) ou par itération
+    std::vector<float> history[3];           // Convergence, une valeur par lot
+};
+
+// Dimension de Kaplan-Yorke déduite d'un spectre complet (0 si indéfinie)
+double kaplanYorkeDimension(const LyapunovResult& result);
+
+// Estimation synchrone : appelle onBatch après chaque lot, s'arrête s'il renvoie false.
+// La trajectoire suit exactement le pas de Attractor::update (intégrateur et
+// précision de source) ; les vecteurs tangents suivent la dérivée du pas
+// d'Euler ou RK4, ou celle du flot pour Exact et Taylor. Pour les applications
+// (Hénon, Clifford...), c'est l'application elle-même qui est itérée.
+LyapunovResult estimateLyapunov(const Attractor& source, const LyapunovSettings& settings,
+                                const std::function<bool(const LyapunovResult&)>& onBatch = {});
+
+// Estimation en tâche de fond pour l'interface
+class LyapunovEstimator {
+public:
+    LyapunovEstimator() = default;
+    ~LyapunovEstimator();
+    LyapunovEstimator(const LyapunovEstimator&) = delete;
+    LyapunovEstimator& operator=(const LyapunovEstimator&) = delete;
+
+    LyapunovSettings settings;
+
+    void start(const Attractor& source);   // Relance depuis l'état courant
+    void stop();
+    bool isRunning() const { return running; }
+    LyapunovResult result() const;
+
+private:
+    std::thread worker;
+    std::atomic<bool> stopRequested{false};
+    std::atomic<bool> running{false};
+    mutable std::mutex mutex;
+    LyapunovResult latest;
+};
+
+#endif // LYAPUNOV_H
+/**
+ * Lyapunov.h
+ *
+ * Contient l'estimateur des exposants de Lyapunov (méthode de Benettin).
+ */
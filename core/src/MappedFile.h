@@ -0,0 +1,69 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Fichier projeté en mémoire (mmap / MapViewOfFile).
+// En écriture, le fichier est agrandi par resize() : la place est réservée sur
+// le disque avant d'être projetée, un disque plein est donc signalé par un
+// échec de resize() et non par un SIGBUS au moment de la copie.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool openRead(const std::string& path);
+    bool create(const std::string& path);     // Crée ou vide le fichier, en écriture
+    // Agrandit (ou réduit) le fichier et le reprojette ; data() peut changer
+    bool resize(uint64_t size);
+    // Tronque le fichier à finalSize (écriture) puis ferme
+    void close(uint64_t finalSize);
+    void close();
+
+    bool isOpen() const { return handle != kInvalid; }
+    bool isWritable() const { return writable; }
+    uint8_t* data() { return base; }
+    const uint8_t* data() const { return base; }
+    uint64_t size() const { return length; }
+
+    // Lecture par appel système, sans toucher à la projection (les pages lues
+    // ne s'ajoutent pas à la mémoire du processus)
+    bool readAt(uint64_t offset, void* out, size_t bytes) const;
+
+    // Écriture asynchrone vers le disque de [offset, offset + bytes)
+    void flush(uint64_t offset, uint64_t bytes);
+
+    // Conseils de pagination (lecture) : accès dispersés (pas de lecture
+    // anticipée globale), chargement d'une zone, libération d'une zone
+    void adviseRandom();
+    void prefetch(uint64_t offset, uint64_t bytes);
+    void release(uint64_t offset, uint64_t bytes);
+
+private:
+    bool map();
+    void unmap();
+
+#ifdef _WIN32
+    using Handle = void*;
+    static constexpr Handle kInvalid = nullptr;
+    Handle mapping = nullptr;
+#else
+    using Handle = int;
+    static constexpr Handle kInvalid = -1;
+#endif
+    Handle handle = kInvalid;
+    bool writable = false;
+    uint8_t* base = nullptr;
+    uint64_t length = 0;
+};
+
+#endif // MAPPED_FILE_H
+/**
+ * MappedFile.h
+ *
+ * Contient la projection en mémoire de fichiers, en lecture et en écriture.
+ */
@@ -0,0 +1,32 @@
+#ifndef NPY_H
+#define NPY_H
+
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <string>
+
+// Format .npy de NumPy (version 1.0) : en-tête texte décrivant le type et la
+// forme, complété à 64 octets, puis les données brutes. Les tableaux écrits ici
+// se chargent sans analyse, y compris en projection :
+//   np.load("trajectoire.npy", mmap_mode="r")
+enum class NpyType {
+    Float32,    // '<f4'
+    Float64,    // '<f8'
+    UInt32,     // '<u4'
+    UInt64      // '<u8'
+};
+
+// Écrit l'en-tête ; fortranOrder indique un tableau rangé colonne par colonne
+// (une trajectoire (n, 3) en SoA : tous les x, puis tous les y, puis tous les z)
+bool writeNpyHeader(FILE* f, NpyType type, std::initializer_list<uint64_t> shape, bool fortranOrder = false);
+
+// Fichier complet à partir d'un tableau contigu (ordre C)
+bool writeNpy(const std::string& path, NpyType type, std::initializer_list<uint64_t> shape, const void* data);
+
+#endif // NPY_H
+/**
+ * Npy.h
+ *
+ * Contient l'écriture de tableaux au format .npy de NumPy.
+ */
@@ -0,0 +1,33 @@
+#ifndef PIECEWISE_H
+#define PIECEWISE_H
+
+// Système affine par morceaux : dans le régime r, dp/dt = A[r] p + b[r].
+// Les régimes sont séparés par des plans p[axis] = levels[i] (croissants) :
+// le régime r couvre levels[r - 1] <= p[axis] < levels[r].
+struct PiecewiseAffine {
+    static constexpr int kMaxSurfaces = 2;
+    int axis = 0;
+    int surfaces = 0;
+    double levels[kMaxSurfaces] = {};
+    double A[kMaxSurfaces + 1][3][3] = {};
+    double b[kMaxSurfaces + 1][3] = {};
+};
+
+// Avance p de dt par la solution exacte de chaque régime (exponentielle de
+// la matrice augmentée [A b ; 0 0], calculée une fois par régime et par dt
+// tant que le système ne change pas). Une commutation est repérée si l'un
+// des 8 échantillons du pas tombe dans un autre régime, ou si p[axis] y
+// passe entre deux échantillons (extremum localisé où sa dérivée s'annule) :
+// un aller-retour au-delà d'une surface dans le même pas n'est pas manqué.
+// L'instant de passage est localisé par Newton sur la solution exacte, le
+// pas s'arrête sur la surface et repart dans le nouveau régime pour le
+// temps restant.
+void stepPiecewise(const PiecewiseAffine& system, double p[3], double dt);
+
+#endif // PIECEWISE_H
+/**
+ * Piecewise.h
+ *
+ * Contient l'intégration exacte des systèmes affines par morceaux (Chua) :
+ * solution exponentielle par régime et localisation des commutations.
+ */
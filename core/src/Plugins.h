@@ -0,0 +1,34 @@
+#ifndef PLUGINS_H
+#define PLUGINS_H
+
+#include <string>
+#include <vector>
+#include "Attractor.h"
+
+// Charge les bibliothèques du dossier (.so, .dylib ; ordre alphabétique) et
+// inscrit leurs systèmes dans les emplacements libres, types
+// kFirstPluginType et suivants. Une bibliothèque déjà chargée est ignorée.
+// Renvoie le nombre de systèmes inscrits ; errors reçoit un message par
+// bibliothèque ou système refusé (interface d'une autre version, nom déjà
+// pris, emplacements épuisés...). Un dossier absent n'est pas une erreur.
+int loadPlugins(const std::string& directory, std::vector<std::string>& errors);
+
+// Dossier des greffons : $ATTRACTEUR_PLUGINS, sinon plugins/ à côté de
+// l'exécutable (vide si son chemin est inconnu : aucun greffon)
+std::string pluginDirectory();
+
+// Chargement de pluginDirectory() au démarrage (applications, banc d'essai) :
+// une seule fois, erreurs affichées sur la sortie d'erreur
+void loadStartupPlugins();
+
+int pluginCount();                          // Emplacements occupés
+const SystemInfo* pluginSystemInfo(int slot);   // nullptr si vide
+std::string pluginPath(int slot);           // Bibliothèque d'origine
+
+#endif // PLUGINS_H
+/**
+ * Plugins.h
+ *
+ * Contient le chargement des greffons de systèmes (AttractorPlugin.h) et
+ * leur inscription dans le registre.
+ */
@@ -0,0 +1,110 @@
+#ifndef POINCARE_H
+#define POINCARE_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Attractor.h"
+#include "Density.h"
+
+// Section de Poincaré d'un flot 3D par le plan normal.p = offset
+struct PoincareSettings {
+    int type = 1;
+    float normal[3] = {0.0f, 0.0f, 1.0f};  // Normalisée au démarrage
+    float offset = 27.0f;
+    bool bothDirections = false;            // Sinon seulement les passages où normal.f > 0
+    Integrator integrator = Integrator::RK4;
+    int taylorOrder = kTaylorOrder;     // Integrator::Taylor
+    int width = 512, height = 512;
+    // Plage des coordonnées (u, v) dans le plan ; uMin == uMax : automatique
+    float uMin = 0.0f, uMax = 0.0f, vMin = 0.0f, vMax = 0.0f;
+    float dt = 0.01f;
+    long transient = 10000;
+    long maxCrossings = 0;                  // 0 = jusqu'à stop()
+    int threads = 0;                        // 0 = tous les cœurs
+    float params[kMaxParams];
+    Point initial;
+
+    explicit PoincareSettings(int type = 1);   // Paramètres du registre et plan conseillé
+};
+
+// Flots 3D à coordonnées bornées : ni les applications, ni Duffing, dont la
+// troisième coordonnée est une phase qui croît sans fin
+bool poincareSupported(int type);
+
+// Base (u, v) du plan : u et v orthonormés, orthogonaux à la normale.
+// Pour un plan de coordonnée (z = c), u et v sont les deux autres axes.
+void poincareBasis(const float normal[3], float u[3], float v[3]);
+
+// État d'une accumulation, pour la reprendre plus tard (voir Session.h)
+struct PoincareCheckpoint {
+    PoincareSettings settings;      // Plage résolue (uMin < uMax)
+    DensityImage image;
+    long crossings = 0;
+    double seconds = 0.0;
+    bool running = false;           // Calcul en cours au moment de la copie
+    std::vector<Point> trajectories;// Point courant de chaque thread
+};
+
+// Accumulation en tâche de fond : chaque thread suit sa propre trajectoire
+// (départs légèrement décalés) et ajoute ses passages à l'image commune.
+class PoincareSection {
+public:
+    PoincareSection() = default;
+    ~PoincareSection();
+    PoincareSection(const PoincareSection&) = delete;
+    PoincareSection& operator=(const PoincareSection&) = delete;
+
+    // Faux si !poincareSupported(settings.type) ou si la normale est nulle
+    bool start(const PoincareSettings& settings);
+    // Reprend une accumulation sauvegardée (image, passages, trajectoires) ;
+    // les threads ne redémarrent que si elle était en cours
+    bool resume(const PoincareCheckpoint& checkpoint);
+    // Copie cohérente de l'image et des trajectoires
+    void snapshot(PoincareCheckpoint& out) const;
+    void stop();
+    void wait();
+    bool isRunning() const { return activeThreads > 0; }
+    long crossings() const { return crossingCount; }
+    double seconds() const;
+    // Incrémenté à chaque ajout dans l'image
+    unsigned version() const { return imageVersion.load(std::memory_order_acquire); }
+    // Plage (uMin, uMax, vMin, vMax) ; faux tant qu'elle n'est pas estimée
+    bool range(float out[4]) const;
+    void copyImage(DensityImage& out) const;
+    const PoincareSettings& settings() const { return current; }
+
+private:
+    bool launch(const PoincareSettings& settings, const PoincareCheckpoint* from);
+    void worker(int index);
+
+    PoincareSettings current;
+    DensityImage density;
+    std::vector<Point> positions;   // Point courant de chaque thread (sous mutex)
+    std::vector<uint8_t> resumed;   // Thread reparti d'une position sauvegardée
+    mutable std::mutex mutex;
+    std::vector<std::thread> pool;
+    std::atomic<long> crossingCount{0};
+    std::atomic<unsigned> imageVersion{0};
+    std::atomic<int> activeThreads{0};
+    std::atomic<bool> stopRequested{false};
+    std::atomic<bool> rangeReady{false};
+    float rangeValues[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    std::unique_ptr<std::once_flag> rangeOnce;
+    std::atomic<double> elapsed{0.0};
+    double startTime = 0.0;
+    double previousSeconds = 0.0;   // Durée des calculs dont celui-ci est la reprise
+};
+
+// Calcul synchrone (ligne de commande) ; maxCrossings doit être > 0
+DensityImage computePoincare(const PoincareSettings& settings);
+
+#endif // POINCARE_H
+/**
+ * Poincare.h
+ *
+ * Contient l'extraction des sections de Poincaré des flots 3D et leur
+ * accumulation en image de densité.
+ */
@@ -2,20 +2,44 @@
 #define RENDERER_H
 
 #include <vector>
-#include <SDL.h>
+#include <SDL3/SDL.h>
 #include "Attractor.h"
 
+// Tracé des points d'une trajectoire (simulation en direct ou fichier relu)
 class Renderer {
 public:
+    // Rotation autour de l'axe vertical (yaw) puis horizontal (pitch) ;
+    // yaw = pitch = 0 : plan (x, y) vu de face
+    struct Camera {
+        float yaw = 0.0f, pitch = 0.0f;
+        float zoom = 15.0f;
+    };
+
     Renderer();
     ~Renderer();
 
-    void initialize();
+    void initialize(SDL_Renderer* renderer);
     void clear();
-    void render(const Attractor& attractor);
+    void render(const Point* points, size_t count);
+    void render(const std::vector<Point>& points) { render(points.data(), points.size()); }
+
+    // Clic gauche + glisser : rotation ; molette : zoom.
+    // captured : la souris est déjà utilisée par ImGui
+    void handleEvent(const SDL_Event& event, bool captured);
+
+    Camera camera;
+    float color[3] = {0.0f, 1.0f, 1.0f};   // Cyan
 
 private:
-    SDL_Color pointColor;
+    SDL_Renderer* sdl = nullptr;
+    std::vector<SDL_FPoint> projected;      // SDL3 utilise des SDL_FPoint (float)
+    bool dragging = false;
 };
 
 #endif // RENDERER_H
+/**
+ * Renderer.h
+ *
+ * Contient la déclaration de la classe Renderer (projection et tracé des
+ * points avec SDL_Renderer).
+ */
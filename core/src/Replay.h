@@ -0,0 +1,60 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <string>
+#include <vector>
+#include "Attractor.h"
+#include "TrajectoryFile.h"
+
+// Relecture d'un fichier .atr : la fenêtre [position - window, position) est
+// lue dans la projection et fournie au rendu comme une trajectoire calculée.
+class TrajectoryReplay {
+public:
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return opened; }
+    const std::string& error() const { return reader.error(); }
+    const TrajectoryHeader& header() const { return reader.header(); }
+    uint64_t length() const { return reader.pointCount(); }
+
+    uint64_t position = 0;          // Fin de la fenêtre affichée (en points)
+    uint64_t window = 100000;       // Points affichés
+    double speed = 300.0;           // Pas de simulation par seconde en lecture (un
+                                    // bloc sous-échantillonné avance moins de points)
+    bool playing = false;
+    bool loop = true;
+
+    // Avance la lecture de seconds secondes
+    void advance(double seconds);
+    // Points de la fenêtre courante (relus seulement si elle a changé)
+    const std::vector<Point>& visible();
+
+    // Pas de simulation de la fin de la fenêtre, sous-échantillonnage à cet
+    // endroit (1 : tous les pas) et dans tout le fichier
+    uint64_t step() const { return reader.stepOf(position); }
+    uint32_t stride() const;
+    uint32_t maxStride() const { return reader.maxStride(); }
+    bool contiguous() const { return reader.contiguous(); }
+    uint64_t stepCount() const { return reader.stepOf(length()); }
+
+    // Tout le fichier en tableau NumPy (voir writeTrajectoryNpy), plus le pas
+    // de chaque point (trajectoryStepsPath) si des pas manquent
+    bool exportNpy(const std::string& path);
+
+    // Attracteur décrit par l'en-tête (système, paramètres, pas)
+    Attractor source() const;
+
+private:
+    TrajectoryReader reader;
+    bool opened = false;
+    std::vector<Point> points;
+    uint64_t loadedFirst = 0, loadedCount = 0;
+    double carry = 0.0;             // Fraction de point pas encore avancée
+};
+
+#endif // REPLAY_H
+/**
+ * Replay.h
+ *
+ * Contient la relecture des trajectoires enregistrées.
+ */
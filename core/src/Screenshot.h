@@ -0,0 +1,66 @@
+#ifndef SCREENSHOT_H
+#define SCREENSHOT_H
+
+#include <SDL3/SDL.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+struct ScreenshotStatus {
+    std::string lastPath;       // Dernière capture écrite
+    int pending = 0;            // Captures lues, pas encore écrites
+    int dropped = 0;            // Ignorées (trop de captures en attente)
+    bool failed = false;        // La dernière écriture a échoué
+};
+
+// Captures d'écran PNG horodatées (capture_AAAAMMJJ_HHMMSS.png). Seule la
+// lecture des pixels (SDL_RenderReadPixels) a lieu sur le thread de rendu ;
+// la conversion en RGB, l'encodage et l'écriture se font sur un thread dédié.
+class Screenshot {
+public:
+    Screenshot() = default;
+    ~Screenshot();
+    Screenshot(const Screenshot&) = delete;
+    Screenshot& operator=(const Screenshot&) = delete;
+
+    // withInterface : fenêtre entière, sinon la scène seule (sans ImGui)
+    void request(bool withInterface);
+
+    // À appeler après le tracé de la scène (withInterface = false) puis après
+    // celui d'ImGui (true), avant SDL_RenderPresent : lit les pixels si une
+    // capture de ce type est demandée
+    void capture(SDL_Renderer* renderer, bool withInterface);
+
+    ScreenshotStatus status() const;
+
+private:
+    struct Job {
+        SDL_Surface* surface;
+        std::string path;
+    };
+
+    std::string nextPath();
+    void writerLoop();
+
+    bool requested = false;
+    bool requestedInterface = false;
+    long long lastStamp = 0;    // Seconde de la dernière capture (noms uniques)
+    int sameStamp = 0;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<Job> jobs;       // Sous mutex
+    bool stopRequested = false;
+    ScreenshotStatus current;
+    std::thread thread;
+};
+
+#endif // SCREENSHOT_H
+/**
+ * Screenshot.h
+ *
+ * Contient la capture d'écran (F12) lue sur le thread de rendu et encodée en
+ * PNG en tâche de fond.
+ */
@@ -0,0 +1,112 @@
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Attractor.h"
+#include "Bifurcation.h"
+#include "CustomSystem.h"
+#include "Poincare.h"
+
+// Simulation et vue de la fenêtre principale. Tous les intégrateurs sont à
+// un pas : l'état (en double, Attractor::state), le pas, les paramètres,
+// l'intégrateur et la précision suffisent à reprendre la trajectoire à
+// l'identique.
+struct SessionView {
+    int32_t type = 1;
+    int32_t integrator = 0;             // Integrator
+    int32_t taylorOrder = kTaylorOrder;
+    int32_t precision = 0;              // Precision
+    double p[3] = {0.0, 0.0, 0.0};
+    float dt = 0.01f;
+    float params[kMaxParams] = {};
+    float yaw = 0.0f, pitch = 0.0f, zoom = 15.0f;
+    float color[3] = {0.0f, 1.0f, 1.0f};
+};
+
+// État d'une session. Passé à SessionWriter::save, c'est un changement :
+// points ne contient que les points ajoutés depuis la sauvegarde précédente,
+// sauf si resetPoints (tampon vidé entre-temps : points le remplace).
+struct SessionState {
+    bool hasView = false;
+    SessionView view;
+    // Nom du système (Attractor::info) : les greffons sont retrouvés par leur
+    // nom, leur numéro de type dépend de l'ordre de chargement
+    std::string system;
+    bool hasCustom = false;
+    CustomDefinition custom;    // Système personnalisé installé, réinstallé à la reprise
+    bool resetPoints = false;
+    std::vector<Point> points;
+    bool hasPoincare = false;
+    PoincareCheckpoint poincare;
+    bool hasBifurcation = false;
+    BifurcationCheckpoint bifurcation;
+};
+
+// Relit un journal de session ; les enregistrements sont vérifiés par CRC et
+// la lecture s'arrête au premier invalide (fin tronquée par un arrêt brutal).
+// Faux si le fichier est absent ou n'est pas un journal de session.
+bool loadSession(const std::string& path, SessionState& out);
+
+struct SessionStats {
+    uint64_t fileBytes = 0;     // Taille du journal
+    uint64_t saves = 0;         // Sauvegardes écrites
+    double lastSeconds = 0.0;   // Durée de la dernière écriture
+    bool failed = false;        // Erreur d'écriture (disque plein...)
+};
+
+// Journal de session en ajout seul : chaque sauvegarde n'ajoute que ce qui a
+// changé (nouveaux points, images des calculs en cours), écrit par un thread
+// dédié. Le journal est réécrit en entier quand il dépasse le double de l'état
+// qu'il décrit (images remplacées plusieurs fois).
+class SessionWriter {
+public:
+    SessionWriter() = default;
+    ~SessionWriter();
+    SessionWriter(const SessionWriter&) = delete;
+    SessionWriter& operator=(const SessionWriter&) = delete;
+
+    // Démarre le thread, qui réécrit aussitôt initial (état relu par
+    // loadSession) dans un journal neuf ; une erreur apparaît dans stats()
+    void open(const std::string& path, SessionState initial = SessionState());
+    void close();   // Écrit la sauvegarde en attente puis arrête le thread
+    bool isOpen() const { return thread.joinable(); }
+
+    // Ne bloque pas : si la sauvegarde précédente n'est pas encore écrite, les
+    // deux sont fusionnées
+    void save(SessionState&& changes);
+    bool busy() const;
+    SessionStats stats() const;
+
+private:
+    void writerLoop();
+    bool append(const SessionState& changes);
+    bool compact();
+
+    std::string path;
+    FILE* file = nullptr;
+    SessionState live;          // Tout ce que décrit le journal (thread d'écriture)
+    uint64_t fileBytes = 0;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    SessionState pending;       // Sous mutex
+    bool hasPending = false;
+    bool writing = false;
+    bool stopRequested = false;
+    SessionStats current;
+    std::thread thread;
+};
+
+#endif // SESSION_H
+/**
+ * Session.h
+ *
+ * Contient la sauvegarde incrémentale de la session (simulation, vue, points,
+ * calculs en cours) et sa relecture au démarrage.
+ */
@@ -0,0 +1,51 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// File sans verrou à un producteur et un consommateur, capacité fixe.
+// push() n'est appelé que par le producteur, pop() que par le consommateur.
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity) : slots(capacity + 1) {}
+
+    bool push(const T& value) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t next = t + 1 == slots.size() ? 0 : t + 1;
+        if (next == head.load(std::memory_order_acquire)) return false;   // Pleine
+        slots[t] = value;
+        tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& value) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;      // Vide
+        value = slots[h];
+        head.store(h + 1 == slots.size() ? 0 : h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximatif si l'autre thread travaille en même temps
+    size_t size() const {
+        size_t h = head.load(std::memory_order_acquire), t = tail.load(std::memory_order_acquire);
+        return t >= h ? t - h : t + slots.size() - h;
+    }
+
+private:
+    std::vector<T> slots;
+    // Indices sur des lignes de cache distinctes : le producteur n'écrit que
+    // tail, le consommateur que head
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+};
+
+#endif // SPSC_QUEUE_H
+/**
+ * SpscQueue.h
+ *
+ * Contient la file sans verrou entre la simulation et le thread d'écriture.
+ */
@@ -0,0 +1,65 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include "Attractor.h"
+
+enum class SweepMode {
+    Lyapunov,   // Plus grand exposant de Lyapunov
+    Period      // Période détectée (0 = pas de période <= maxPeriod)
+};
+
+// Balayage de deux paramètres d'un système sur une grille width x height
+struct SweepSettings {
+    int type = 2;
+    int paramX = 0, paramY = 2;         // Indices dans SystemInfo::paramNames
+    float xMin = 0.05f, xMax = 0.45f;
+    float yMin = 2.0f, yMax = 12.0f;
+    int width = 256, height = 256;
+    SweepMode mode = SweepMode::Lyapunov;
+    float dt = 0.01f;                   // Ignoré pour les applications (une itération)
+    long transient = 5000;
+    long steps = 20000;
+    int orthoInterval = 10;
+    int maxPeriod = 32;
+    float periodTolerance = 1e-3f;
+    int threads = 0;                    // 0 = tous les cœurs
+    Precision precision = Precision::Single;    // Double : deux fois moins de cellules par registre SIMD
+    float params[kMaxParams];           // Valeurs des paramètres non balayés
+    Point initial;
+
+    explicit SweepSettings(int type = 2);   // Paramètres et point de départ du registre
+};
+
+// Valeur par cellule, ligne par ligne (y croissant). NaN = trajectoire divergente.
+struct SweepResult {
+    int width = 0, height = 0;
+    SweepMode mode = SweepMode::Lyapunov;
+    std::vector<float> values;
+    double seconds = 0.0;
+};
+
+struct SweepProgress {
+    std::atomic<int> rowsDone{0};
+    std::atomic<bool> cancel{false};
+};
+
+SweepResult runSweep(const SweepSettings& settings, SweepProgress* progress = nullptr);
+
+// Image couleur (PPM binaire) : exposant négatif en bleu, positif en jaune/rouge ;
+// une couleur par période.
+bool writeSweepImage(const SweepResult& result, const std::string& path);
+// Tableau brut float32 little-endian, height x width
+bool writeSweepRaw(const SweepResult& result, const std::string& path);
+// Même tableau en .npy : float32 (height, width), ligne 0 = y minimal
+bool writeSweepNpy(const SweepResult& result, const std::string& path);
+
+#endif // SWEEP_H
+/**
+ * Sweep.h
+ *
+ * Contient le balayage parallèle d'un plan de paramètres (cartes de Lyapunov
+ * et de périodicité).
+ */
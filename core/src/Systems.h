@@ -0,0 +1,614 @@
+#ifndef SYSTEMS_H
+#define SYSTEMS_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include "AttractorPlugin.h"
+#include "Dual.h"
+#include "Expression.h"
+#include "Lanes.h"
+#include "Piecewise.h"
+
+// Nombre maximal de paramètres d'un système (Aizawa en a 6)
+constexpr int kMaxParams = 6;
+
+template <typename T>
+struct Vec3 { T x, y, z; };
+
+// Programmes du système personnalisé installé (CustomSystem.h) ; nullptr si
+// aucun. tangent : entrées et sorties suivies de la direction et de J v.
+const ExpressionProgram* customProgram(bool tangent);
+
+// Greffons (AttractorPlugin.h) : types kFirstPluginType à
+// kFirstPluginType + kPluginSlots - 1, chacun compilé comme un système intégré
+constexpr int kFirstPluginType = 16;
+constexpr int kPluginSlots = 8;
+// Descripteur chargé dans l'emplacement slot (Plugins.h) ; nullptr si vide
+const AttractorPluginSystem* pluginSystem(int slot);
+
+// Accès élément par élément à un scalaire (un élément) ou à un Lanes (W)
+template <typename T>
+struct LaneAccess {
+    using Scalar = T;
+    static constexpr int width = 1;
+    static T get(const T& v, int) { return v; }
+    static void set(T& v, int, T s) { v = s; }
+};
+
+template <typename S, int W>
+struct LaneAccess<Lanes<S, W>> {
+    using Scalar = S;
+    static constexpr int width = W;
+    static S get(const Lanes<S, W>& v, int l) { return v[l]; }
+    static void set(Lanes<S, W>& v, int l, S s) { v[l] = s; }
+};
+
+// Champ évalué hors des noyaux compilés (système personnalisé, greffons) :
+// les éléments d'un Lanes forment un lot SoA (x, y, z puis les paramètres)
+// passé à run(in, out, n) en une fois
+template <typename T, typename P, typename Run>
+inline Vec3<T> batchField(const P* k, const Vec3<T>& p, int params, const Run& run) {
+    using A = LaneAccess<T>;
+    using S = typename A::Scalar;
+    constexpr int W = A::width;
+    constexpr int KW = LaneAccess<P>::width;
+    S in[(3 + kMaxParams) * W], out[3 * W];
+    for (int l = 0; l < W; l++) {
+        in[l] = A::get(p.x, l);
+        in[W + l] = A::get(p.y, l);
+        in[2 * W + l] = A::get(p.z, l);
+        for (int i = 0; i < params; i++) in[(3 + i) * W + l] = S(LaneAccess<P>::get(k[i], l % KW));
+    }
+    run(in, out, W);
+    Vec3<T> f{T(S(0)), T(S(0)), T(S(0))};
+    for (int l = 0; l < W; l++) {
+        A::set(f.x, l, out[l]);
+        A::set(f.y, l, out[W + l]);
+        A::set(f.z, l, out[2 * W + l]);
+    }
+    return f;
+}
+
+// Champ du système personnalisé, exécuté par la machine virtuelle
+// (Expression.h) ou son noyau natif
+template <typename T, typename P>
+inline Vec3<T> customField(const P* k, const Vec3<T>& p) {
+    using S = typename LaneAccess<T>::Scalar;
+    const ExpressionProgram* program = customProgram(false);
+    if (!program) return {T(S(0)), T(S(0)), T(S(0))};
+    return batchField(k, p, program->inputCount() - 3, [&](const S* in, S* out, int n) { program->run(in, out, n); });
+}
+
+// Nombres duaux : valeurs et dérivées par le programme tangent, un élément
+// du lot par élément du Lanes et par direction
+template <typename T, int N, typename P>
+inline Vec3<Dual<T, N>> customField(const P* k, const Vec3<Dual<T, N>>& p) {
+    using A = LaneAccess<T>;
+    using S = typename A::Scalar;
+    constexpr int W = A::width;
+    constexpr int B = W * N;
+    constexpr int KW = LaneAccess<P>::width;
+    using D = Dual<T, N>;
+    Vec3<D> f{D(T(S(0))), D(T(S(0))), D(T(S(0)))};
+    const ExpressionProgram* program = customProgram(true);
+    if (!program) return f;
+    const int params = program->inputCount() - 6;
+    S in[(6 + kMaxParams) * B], out[6 * B];
+    const T* values[3] = {&p.x.v, &p.y.v, &p.z.v};
+    const D* duals[3] = {&p.x, &p.y, &p.z};
+    for (int c = 0; c < N; c++) {
+        for (int l = 0; l < W; l++) {
+            const int e = c * W + l;
+            for (int i = 0; i < 3; i++) {
+                in[i * B + e] = A::get(*values[i], l);
+                in[(3 + params + i) * B + e] = A::get(duals[i]->d[c], l);
+            }
+            for (int i = 0; i < params; i++) in[(3 + i) * B + e] = S(LaneAccess<P>::get(k[i], l % KW));
+        }
+    }
+    program->run(in, out, B);
+    D* results[3] = {&f.x, &f.y, &f.z};
+    for (int i = 0; i < 3; i++) {
+        for (int l = 0; l < W; l++) {
+            A::set(results[i]->v, l, out[i * B + l]);
+            for (int c = 0; c < N; c++) A::set(results[i]->d[c], l, out[(3 + i) * B + c * W + l]);
+        }
+    }
+    return f;
+}
+
+inline void pluginRun(AttractorBatchF f, AttractorBatchD, const float* in, float* out, int n) { f(in, out, n); }
+inline void pluginRun(AttractorBatchF, AttractorBatchD d, const double* in, double* out, int n) { d(in, out, n); }
+
+// Champ d'un greffon : un appel de sa fonction par lot
+template <int Slot, typename T, typename P>
+inline Vec3<T> pluginField(const P* k, const Vec3<T>& p) {
+    using S = typename LaneAccess<T>::Scalar;
+    const AttractorPluginSystem* s = pluginSystem(Slot);
+    if (!s) return {T(S(0)), T(S(0)), T(S(0))};
+    return batchField(k, p, s->param_count, [&](const S* in, S* out, int n) {
+        pluginRun(s->field_f, s->field_d, in, out, n);
+    });
+}
+
+// Nombres duaux : J v par la jacobienne du greffon, ou sinon par différences
+// finies en double (pas relatif de l'ordre de la racine de l'epsilon machine)
+template <int Slot, typename T, int N, typename P>
+inline Vec3<Dual<T, N>> pluginField(const P* k, const Vec3<Dual<T, N>>& p) {
+    using A = LaneAccess<T>;
+    using S = typename A::Scalar;
+    constexpr int W = A::width;
+    constexpr int KW = LaneAccess<P>::width;
+    using D = Dual<T, N>;
+    const Vec3<T> value = pluginField<Slot>(k, Vec3<T>{p.x.v, p.y.v, p.z.v});
+    Vec3<D> f{D(value.x), D(value.y), D(value.z)};
+    const AttractorPluginSystem* s = pluginSystem(Slot);
+    if (!s) return f;
+    const int params = s->param_count;
+    const D* duals[3] = {&p.x, &p.y, &p.z};
+    D* results[3] = {&f.x, &f.y, &f.z};
+    if (s->jacobian_f && s->jacobian_d) {
+        S in[(3 + kMaxParams) * W], J[9 * W];
+        for (int l = 0; l < W; l++) {
+            for (int i = 0; i < 3; i++) in[i * W + l] = A::get(duals[i]->v, l);
+            for (int i = 0; i < params; i++) in[(3 + i) * W + l] = S(LaneAccess<P>::get(k[i], l % KW));
+        }
+        pluginRun(s->jacobian_f, s->jacobian_d, in, J, W);
+        for (int i = 0; i < 3; i++) {
+            for (int c = 0; c < N; c++) {
+                for (int l = 0; l < W; l++) {
+                    S d = S(0);
+                    for (int j = 0; j < 3; j++) d += J[(3 * i + j) * W + l] * A::get(duals[j]->d[c], l);
+                    A::set(results[i]->d[c], l, d);
+                }
+            }
+        }
+        return f;
+    }
+    // Élément l : le point ; élément (c + 1) * W + l : le point décalé de h v[c]
+    constexpr int B = W * (N + 1);
+    double in[(3 + kMaxParams) * B], out[3 * B], h[N * W];
+    for (int l = 0; l < W; l++) {
+        double scale = 1.0;
+        for (int i = 0; i < 3; i++) scale = std::fmax(scale, std::fabs(double(A::get(duals[i]->v, l))));
+        for (int c = 0; c < N; c++) {
+            double norm = 0.0;
+            for (int i = 0; i < 3; i++) norm = std::fmax(norm, std::fabs(double(A::get(duals[i]->d[c], l))));
+            h[c * W + l] = 1.5e-8 * scale / (norm > 0.0 ? norm : 1.0);
+        }
+        for (int c = 0; c <= N; c++) {
+            const int e = c * W + l;
+            for (int i = 0; i < 3; i++) {
+                double x = double(A::get(duals[i]->v, l));
+                if (c > 0) x += h[(c - 1) * W + l] * double(A::get(duals[i]->d[c - 1], l));
+                in[i * B + e] = x;
+            }
+            for (int i = 0; i < params; i++) in[(3 + i) * B + e] = double(LaneAccess<P>::get(k[i], l % KW));
+        }
+    }
+    s->field_d(in, out, B);
+    for (int i = 0; i < 3; i++) {
+        for (int c = 0; c < N; c++) {
+            for (int l = 0; l < W; l++) {
+                const int e = (c + 1) * W + l;
+                A::set(results[i]->d[c], l, S((out[i * B + e] - out[i * B + l]) / h[c * W + l]));
+            }
+        }
+    }
+    return f;
+}
+
+// Champ de vecteurs du système Type, paramètres k.
+// Les applications (Hénon, Ikeda, Clifford...) sont écrites sous la forme
+// f(p) - p pour pouvoir être tracées en continu avec un pas dt.
+template <int Type, typename T, typename P>
+inline Vec3<T> field(const P* k, const Vec3<T>& p) {
+    using std::sin; using std::cos; using std::abs; using std::floor;
+    T dx = T(0), dy = T(0), dz = T(0);
+    if constexpr (Type == 1) { // Lorenz : sigma, rho, beta
+        dx = k[0] * (p.y - p.x);
+        dy = p.x * (k[1] - p.z) - p.y;
+        dz = p.x * p.y - k[2] * p.z;
+    }
+    else if constexpr (Type == 2) { // Rössler : a, b, c
+        dx = -p.y - p.z;
+        dy = p.x + k[0] * p.y;
+        dz = k[1] + p.z * (p.x - k[2]);
+    }
+    else if constexpr (Type == 3) { // Aizawa : a, b, c, d, e, f
+        dx = (p.z - k[1]) * p.x - k[3] * p.y;
+        dy = k[3] * p.x + (p.z - k[1]) * p.y;
+        dz = k[2] + k[0] * p.z - (p.z * p.z * p.z / P(3)) - (p.x * p.x + p.y * p.y) * (P(1) + k[4] * p.z) + k[5] * p.z * p.x * p.x * p.x;
+    }
+    else if constexpr (Type == 4) { // Thomas : b
+        dx = sin(p.y) - k[0] * p.x;
+        dy = sin(p.z) - k[0] * p.y;
+        dz = sin(p.x) - k[0] * p.z;
+    }
+    else if constexpr (Type == 5) { // Hénon : a, b
+        dx = (P(1) - k[0] * p.x * p.x + p.y) - p.x;
+        dy = (k[1] * p.x) - p.y;
+    }
+    else if constexpr (Type == 6) { // Ikeda : u
+        T t = P(0.4) - P(6) / (P(1) + p.x * p.x + p.y * p.y);
+        T c = cos(t), s = sin(t);
+        dx = (P(1) + k[0] * (p.x * c - p.y * s)) - p.x;
+        dy = (k[0] * (p.x * s + p.y * c)) - p.y;
+    }
+    else if constexpr (Type == 7) { // Duffing : delta, gamma, omega
+        dx = p.y;
+        dy = p.x - p.x * p.x * p.x - k[0] * p.y + k[1] * cos(p.z);
+        dz = T(k[2]); // Évolution de la phase temporelle
+    }
+    else if constexpr (Type == 8) { // Van der Pol : mu
+        dx = k[0] * (p.x - (P(1) / P(3)) * p.x * p.x * p.x - p.y);
+        dy = p.x / k[0];
+    }
+    else if constexpr (Type == 9) { // Clifford (Pickover) : a, b, c, d
+        dx = (sin(k[0] * p.y) + k[2] * cos(k[0] * p.x)) - p.x;
+        dy = (sin(k[1] * p.x) + k[3] * cos(k[1] * p.y)) - p.y;
+    }
+    else if constexpr (Type == 10) { // Gumowski-Mira : a, mu
+        auto g = [k](const T& x) { return k[1] * x + P(2) * (P(1) - k[1]) * x * x / (P(1) + x * x); };
+        T nextX = k[0] * p.y + g(p.x);
+        dx = nextX - p.x;
+        dy = (-p.x + g(nextX)) - p.y;
+    }
+    else if constexpr (Type == 11) { // Chua : alpha, beta, m0, m1
+        T h = k[3] * p.x + P(0.5) * (k[2] - k[3]) * (abs(p.x + P(1)) - abs(p.x - P(1)));
+        dx = k[0] * (p.y - p.x - h);
+        dy = p.x - p.y + p.z;
+        dz = -k[1] * p.y;
+    }
+    else if constexpr (Type == 12) { // Tamari
+        dx = p.x - p.y * p.z;
+        dy = p.x * p.z - p.y;
+        dz = p.z + (p.x * p.y / P(3));
+    }
+    else if constexpr (Type == 13) { // Kaplan-Yorke : alpha
+        dx = (P(2) * p.x - floor(P(2) * p.x)) - p.x; // Modulo 1 simplifié
+        dy = (k[0] * p.y + cos(P(4) * P(3.14159) * p.x)) - p.y;
+    }
+    else if constexpr (Type == 14) { // Double Scroll : a, b
+        dx = k[0] * (p.y - p.x);
+        dy = p.x - p.x * p.z + k[1] * p.y;
+        dz = p.x * p.y - k[0] * p.z;
+    }
+    else if constexpr (Type == 15) { // Personnalisé : équations saisies (CustomSystem.h)
+        Vec3<T> f = customField(k, p);
+        dx = f.x;
+        dy = f.y;
+        dz = f.z;
+    }
+    else if constexpr (Type >= kFirstPluginType && Type < kFirstPluginType + kPluginSlots) { // Greffons
+        Vec3<T> f = pluginField<Type - kFirstPluginType>(k, p);
+        dx = f.x;
+        dy = f.y;
+        dz = f.z;
+    }
+    return {dx, dy, dz};
+}
+
+// Jacobienne du champ (J[i][j] = d(field_i)/d(p_j)), obtenue en évaluant
+// field sur des nombres duaux : exacte pour tous les systèmes, sans dérivée
+// écrite à la main
+template <int Type, typename T, typename P>
+inline void jacobian(const P* k, const Vec3<T>& p, T J[3][3]) {
+    using D = Dual<T, 3>;
+    Vec3<D> f = field<Type>(k, Vec3<D>{D::variable(p.x, 0), D::variable(p.y, 1), D::variable(p.z, 2)});
+    for (int j = 0; j < 3; j++) {
+        J[0][j] = f.x.d[j];
+        J[1][j] = f.y.d[j];
+        J[2][j] = f.z.d[j];
+    }
+}
+
+// Produits J(p) v[c] pour N directions sans former la jacobienne : v[c] est
+// remplacé par J(p) v[c] ; renvoie le champ f(p), identique à field<Type>(k, p)
+template <int Type, int N, typename T, typename P>
+inline Vec3<T> tangents(const P* k, const Vec3<T>& p, Vec3<T> (&v)[N]) {
+    using D = Dual<T, N>;
+    Vec3<D> q{D(p.x), D(p.y), D(p.z)};
+    for (int c = 0; c < N; c++) {
+        q.x.d[c] = v[c].x;
+        q.y.d[c] = v[c].y;
+        q.z.d[c] = v[c].z;
+    }
+    Vec3<D> f = field<Type>(k, q);
+    for (int c = 0; c < N; c++) v[c] = {f.x.d[c], f.y.d[c], f.z.d[c]};
+    return {f.x.v, f.y.v, f.z.v};
+}
+
+// Pas d'Euler, identique pour Attractor::update et les estimateurs
+template <int Type, typename T, typename P>
+inline void step(const P* k, Vec3<T>& p, T dt) {
+    Vec3<T> d = field<Type>(k, p);
+    p.x += d.x * dt;
+    p.y += d.y * dt;
+    p.z += d.z * dt;
+}
+
+// Runge-Kutta d'ordre 4 (flots uniquement : pour une application écrite
+// f(p) - p, seul le pas d'Euler de dt = 1 a un sens)
+template <int Type, typename T, typename P>
+inline void stepRK4(const P* k, Vec3<T>& p, T dt) {
+    auto at = [&](const Vec3<T>& d, T h) { return Vec3<T>{p.x + d.x * h, p.y + d.y * h, p.z + d.z * h}; };
+    Vec3<T> k1 = field<Type>(k, p);
+    Vec3<T> k2 = field<Type>(k, at(k1, dt * T(0.5)));
+    Vec3<T> k3 = field<Type>(k, at(k2, dt * T(0.5)));
+    Vec3<T> k4 = field<Type>(k, at(k3, dt));
+    T h = dt / T(6);
+    p.x += h * (k1.x + T(2) * (k2.x + k3.x) + k4.x);
+    p.y += h * (k1.y + T(2) * (k2.y + k3.y) + k4.y);
+    p.z += h * (k1.z + T(2) * (k2.z + k3.z) + k4.z);
+}
+
+// Exact : solution exacte par régime des systèmes affines par morceaux
+// (piecewiseForm), RK4 pour les autres. Taylor : série de Taylor de la
+// solution pour les champs polynomiaux (taylorSeries), RK4 pour les autres.
+enum class Integrator { Euler, RK4, Exact, Taylor };
+
+constexpr int kTaylorOrder = 20;        // Ordre par défaut
+constexpr int kMaxTaylorOrder = 40;
+
+// Coefficients de la solution issue d'un point : x(t) = somme x[n] t^n
+template <typename T>
+struct TaylorSeries {
+    T x[kMaxTaylorOrder + 1], y[kMaxTaylorOrder + 1], z[kMaxTaylorOrder + 1];
+};
+
+// Coefficient n du produit de deux séries
+template <typename T>
+inline T cauchy(const T* a, const T* b, int n) {
+    T sum = T(0);
+    for (int i = 0; i <= n; i++) sum += a[i] * b[n - i];
+    return sum;
+}
+
+// Systèmes dont le champ est polynomial (Lorenz, Rössler, Aizawa, Tamari,
+// Double Scroll) : récurrences de taylorSeries
+constexpr bool taylorSupported(int type) {
+    return type == 1 || type == 2 || type == 3 || type == 12 || type == 14;
+}
+
+// Série de la solution issue de s.x[0], s.y[0], s.z[0] jusqu'à l'ordre
+// order : le coefficient n du champ, obtenu par produits de Cauchy des
+// coefficients 0 à n, donne x[n + 1] = f_n / (n + 1). Coût en order^2.
+template <int Type, typename T, typename P>
+inline void taylorSeries(const P* k, int order, TaylorSeries<T>& s) {
+    T* x = s.x;
+    T* y = s.y;
+    T* z = s.z;
+    if constexpr (Type == 1) { // Lorenz
+        const T sigma = T(k[0]), rho = T(k[1]), beta = T(k[2]);
+        for (int n = 0; n < order; n++) {
+            const T inv = T(1) / T(n + 1);
+            const T xz = cauchy(x, z, n), xy = cauchy(x, y, n);
+            x[n + 1] = sigma * (y[n] - x[n]) * inv;
+            y[n + 1] = (rho * x[n] - xz - y[n]) * inv;
+            z[n + 1] = (xy - beta * z[n]) * inv;
+        }
+    }
+    else if constexpr (Type == 2) { // Rössler
+        const T a = T(k[0]), b = T(k[1]), c = T(k[2]);
+        for (int n = 0; n < order; n++) {
+            const T inv = T(1) / T(n + 1);
+            x[n + 1] = (-y[n] - z[n]) * inv;
+            y[n + 1] = (x[n] + a * y[n]) * inv;
+            z[n + 1] = ((n == 0 ? b : T(0)) + cauchy(z, x, n) - c * z[n]) * inv;
+        }
+    }
+    else if constexpr (Type == 3) { // Aizawa : séries auxiliaires des monômes
+        const T a = T(k[0]), b = T(k[1]), c = T(k[2]), d = T(k[3]), e = T(k[4]), f = T(k[5]);
+        T xx[kMaxTaylorOrder + 1], xxx[kMaxTaylorOrder + 1], zz[kMaxTaylorOrder + 1];
+        T zzz[kMaxTaylorOrder + 1], r[kMaxTaylorOrder + 1];
+        for (int n = 0; n < order; n++) {
+            const T inv = T(1) / T(n + 1);
+            xx[n] = cauchy(x, x, n);
+            xxx[n] = cauchy(xx, x, n);
+            zz[n] = cauchy(z, z, n);
+            zzz[n] = cauchy(zz, z, n);
+            r[n] = xx[n] + cauchy(y, y, n);
+            x[n + 1] = (cauchy(z, x, n) - b * x[n] - d * y[n]) * inv;
+            y[n + 1] = (d * x[n] + cauchy(z, y, n) - b * y[n]) * inv;
+            z[n + 1] = ((n == 0 ? c : T(0)) + a * z[n] - zzz[n] / T(3) - r[n] - e * cauchy(r, z, n)
+                        + f * cauchy(z, xxx, n)) * inv;
+        }
+    }
+    else if constexpr (Type == 12) { // Tamari
+        for (int n = 0; n < order; n++) {
+            const T inv = T(1) / T(n + 1);
+            x[n + 1] = (x[n] - cauchy(y, z, n)) * inv;
+            y[n + 1] = (cauchy(x, z, n) - y[n]) * inv;
+            z[n + 1] = (z[n] + cauchy(x, y, n) / T(3)) * inv;
+        }
+    }
+    else if constexpr (Type == 14) { // Double Scroll
+        const T a = T(k[0]), b = T(k[1]);
+        for (int n = 0; n < order; n++) {
+            const T inv = T(1) / T(n + 1);
+            x[n + 1] = a * (y[n] - x[n]) * inv;
+            y[n + 1] = (x[n] - cauchy(x, z, n) + b * y[n]) * inv;
+            z[n + 1] = (cauchy(x, y, n) - a * z[n]) * inv;
+        }
+    }
+}
+
+// Forme affine par morceaux du champ de Type (Piecewise.h) ; faux si le champ
+// n'en a pas. Chua : h(x) = m1 x + (m0 - m1) sat(x), régimes x < -1,
+// |x| <= 1 et x > 1 de pentes m1, m0, m1.
+template <int Type, typename P>
+inline bool piecewiseForm(const P* k, PiecewiseAffine& out) {
+    if constexpr (Type == 11) {
+        const double alpha = double(k[0]), beta = double(k[1]), m0 = double(k[2]), m1 = double(k[3]);
+        out.axis = 0;
+        out.surfaces = 2;
+        out.levels[0] = -1.0;
+        out.levels[1] = 1.0;
+        for (int r = 0; r < 3; r++) {
+            const double m = r == 1 ? m0 : m1;
+            const double A[3][3] = {{-alpha * (1.0 + m), alpha, 0.0}, {1.0, -1.0, 1.0}, {0.0, -beta, 0.0}};
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 3; j++) out.A[r][i][j] = A[i][j];
+                out.b[r][i] = 0.0;
+            }
+            out.b[r][0] = -alpha * (m0 - m1) * double(r - 1);
+        }
+        return true;
+    } else {
+        (void)k;
+        (void)out;
+        return false;
+    }
+}
+
+// Pas de Taylor d'ordre order : dt est couvert par des sous-pas h choisis
+// d'après la décroissance des deux derniers coefficients,
+// h = min (eps max(1, |p|) / |c_j|)^(1/j) pour j = order - 1, order (erreur
+// de troncature de l'ordre de l'epsilon du type) ; un seul sous-pas tant que
+// dt est plus court. Au-delà de 10000 sous-pas, ou si h devient négligeable
+// devant le reste, RK4 termine le pas. RK4 pour les autres systèmes et les
+// lots (Lanes).
+template <int Type, typename T, typename P>
+inline void stepTaylor(const P* k, Vec3<T>& p, T dt, int order) {
+    if constexpr (taylorSupported(Type) && std::is_floating_point_v<T>) {
+        order = std::clamp(order, 2, kMaxTaylorOrder);
+        const T eps = std::numeric_limits<T>::epsilon();
+        TaylorSeries<T> s;
+        T remaining = dt;
+        for (int substeps = 0; remaining > T(0) && substeps < 10000; substeps++) {
+            s.x[0] = p.x;
+            s.y[0] = p.y;
+            s.z[0] = p.z;
+            taylorSeries<Type>(k, order, s);
+            const T scale = std::max({T(1), std::abs(p.x), std::abs(p.y), std::abs(p.z)});
+            T h = remaining;
+            for (int j = order - 1; j <= order; j++) {
+                const T size = std::max({std::abs(s.x[j]), std::abs(s.y[j]), std::abs(s.z[j])});
+                if (size > T(0)) h = std::min(h, std::pow(eps * scale / size, T(1) / T(j)));
+            }
+            if (h <= remaining * eps) break;    // Sous-pas sans effet sur le reste
+            Vec3<T> q{s.x[order], s.y[order], s.z[order]};
+            for (int n = order - 1; n >= 0; n--) {
+                q.x = q.x * h + s.x[n];
+                q.y = q.y * h + s.y[n];
+                q.z = q.z * h + s.z[n];
+            }
+            p = q;
+            remaining -= h;
+            if (!std::isfinite(p.x + p.y + p.z)) return;
+        }
+        if (remaining > T(0)) stepRK4<Type>(k, p, remaining);
+    } else {
+        stepRK4<Type>(k, p, dt);
+        (void)order;
+    }
+}
+
+// Pas exact (stepPiecewise) en double, sinon RK4 ; les lots (Lanes) passent
+// aussi par RK4
+template <int Type, typename T, typename P>
+inline void stepExact(const P* k, Vec3<T>& p, T dt) {
+    if constexpr (std::is_floating_point_v<T>) {
+        PiecewiseAffine system;
+        if (piecewiseForm<Type>(k, system)) {
+            double q[3] = {double(p.x), double(p.y), double(p.z)};
+            stepPiecewise(system, q, double(dt));
+            p = {T(q[0]), T(q[1]), T(q[2])};
+            return;
+        }
+    }
+    stepRK4<Type>(k, p, dt);
+}
+
+// Type scalaire du calcul : float (largeur SIMD et mémoire) ou double
+// (précision sur les longues trajectoires)
+enum class Precision { Single, Double };
+
+// Appelle f(float()) ou f(double()) : comme pour dispatchSystem, le choix est
+// fait hors des boucles, compilées pour les deux types
+template <typename F>
+inline decltype(auto) dispatchPrecision(Precision precision, F&& f) {
+    if (precision == Precision::Double) return f(double());
+    return f(float());
+}
+
+template <typename T, typename U>
+inline Vec3<T> vecCast(const Vec3<U>& p) { return {T(p.x), T(p.y), T(p.z)}; }
+
+// order : ordre du pas de Taylor, ignoré par les autres intégrateurs
+template <int Type, typename T, typename P>
+inline void advance(Integrator integrator, const P* k, Vec3<T>& p, T dt, int order = kTaylorOrder) {
+    if (integrator == Integrator::RK4) stepRK4<Type>(k, p, dt);
+    else if (integrator == Integrator::Exact) stepExact<Type>(k, p, dt);
+    else if (integrator == Integrator::Taylor) stepTaylor<Type>(k, p, dt, order);
+    else step<Type>(k, p, dt);
+}
+
+// Astuce de Hénon : avec g(p) = n.p comme variable indépendante,
+// dp/dg = f(p) / (n.f(p)) ; un pas RK4 de longueur dg amène p exactement
+// (à l'ordre 4) sur le plan n.p = g(p) + dg.
+template <int Type, typename T, typename P>
+inline void stepToPlane(const P* k, const T n[3], Vec3<T>& p, T dg) {
+    auto slope = [&](const Vec3<T>& q) {
+        Vec3<T> f = field<Type>(k, q);
+        T rate = T(1) / (n[0] * f.x + n[1] * f.y + n[2] * f.z);
+        return Vec3<T>{f.x * rate, f.y * rate, f.z * rate};
+    };
+    auto at = [&](const Vec3<T>& d, T h) { return Vec3<T>{p.x + d.x * h, p.y + d.y * h, p.z + d.z * h}; };
+    Vec3<T> k1 = slope(p);
+    Vec3<T> k2 = slope(at(k1, dg * T(0.5)));
+    Vec3<T> k3 = slope(at(k2, dg * T(0.5)));
+    Vec3<T> k4 = slope(at(k3, dg));
+    T h = dg / T(6);
+    p.x += h * (k1.x + T(2) * (k2.x + k3.x) + k4.x);
+    p.y += h * (k1.y + T(2) * (k2.y + k3.y) + k4.y);
+    p.z += h * (k1.z + T(2) * (k2.z + k3.z) + k4.z);
+}
+
+template <int Type>
+using SystemTag = std::integral_constant<int, Type>;
+
+// Appelle f(SystemTag<type>{}) : le choix du système est fait une fois, hors
+// des boucles de calcul, qui sont ensuite compilées pour un seul système.
+template <typename F>
+inline decltype(auto) dispatchSystem(int type, F&& f) {
+    switch (type) {
+        case 2:  return f(SystemTag<2>{});
+        case 3:  return f(SystemTag<3>{});
+        case 4:  return f(SystemTag<4>{});
+        case 5:  return f(SystemTag<5>{});
+        case 6:  return f(SystemTag<6>{});
+        case 7:  return f(SystemTag<7>{});
+        case 8:  return f(SystemTag<8>{});
+        case 9:  return f(SystemTag<9>{});
+        case 10: return f(SystemTag<10>{});
+        case 11: return f(SystemTag<11>{});
+        case 12: return f(SystemTag<12>{});
+        case 13: return f(SystemTag<13>{});
+        case 14: return f(SystemTag<14>{});
+        case 15: return f(SystemTag<15>{});
+        case 16: return f(SystemTag<16>{});
+        case 17: return f(SystemTag<17>{});
+        case 18: return f(SystemTag<18>{});
+        case 19: return f(SystemTag<19>{});
+        case 20: return f(SystemTag<20>{});
+        case 21: return f(SystemTag<21>{});
+        case 22: return f(SystemTag<22>{});
+        case 23: return f(SystemTag<23>{});
+        default: return f(SystemTag<1>{});
+    }
+}
+static_assert(kFirstPluginType + kPluginSlots - 1 == 23, "un case de dispatchSystem par emplacement de greffon");
+
+#endif // SYSTEMS_H
+/**
+ * Systems.h
+ *
+ * Contient les noyaux de calcul des 14 systèmes, du système personnalisé et
+ * des greffons (champ de vecteurs, jacobienne et produit tangent par nombres
+ * duaux, pas d'Euler, RK4, exact et de Taylor, pas jusqu'à un plan),
+ * génériques sur le type scalaire, et leurs aiguillages (système, précision).
+ */
@@ -0,0 +1,23 @@
+#ifndef TOML_H
+#define TOML_H
+
+#include <string>
+#include "Json.h"
+
+// Sous-ensemble de TOML suffisant pour les fichiers de tâches (--batch) :
+//   # commentaires, clé = valeur (clé nue ou entre guillemets),
+//   [table], [[tableau de tables]],
+//   chaînes "..." (échappements \" \\ \n \t \r \uXXXX) et '...',
+//   entiers et réels (avec _), true / false,
+//   tableaux [a, b, ...] sur une ou plusieurs lignes (64 niveaux au plus).
+// Pas de tables en ligne, de clés pointées ni de dates : erreur explicite.
+// Le document devient un objet Json : [table] un objet, [[table]] un
+// tableau d'objets. Faux avec "ligne N : ..." en cas d'erreur.
+bool parseToml(const std::string& text, Json& out, std::string& error);
+
+#endif // TOML_H
+/**
+ * Toml.h
+ *
+ * Contient la lecture du sous-ensemble de TOML des fichiers de tâches.
+ */
@@ -0,0 +1,268 @@
+#ifndef TRAJECTORY_FILE_H
+#define TRAJECTORY_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Attractor.h"
+#include "MappedFile.h"
+
+// Format .atr (petit-boutiste, version 3) :
+//   TrajectoryHeader (256 octets)
+//   puis des blocs : TrajectoryChunkHeader (48 octets) + données, complétées
+//   à 64 octets. Données brutes : SoA x[count], y[count] (et z[count] si
+//   dims == 3), lues directement dans la projection du fichier. Données
+//   compressées : DeltaChunkHeader puis une colonne codée par coordonnée.
+// Les versions 1 (blocs bruts) et 2 (blocs compressés) restent lisibles :
+// en-têtes de blocs de 32 octets, sans firstStep (pas supposés contigus).
+constexpr char kTrajectoryMagic[8] = {'A', 'T', 'R', 'T', 'R', 'A', 'J', 0};
+constexpr uint32_t kTrajectoryVersion = 3;
+constexpr uint64_t kLegacyChunkHeaderSize = 32;     // Versions 1 et 2
+constexpr uint32_t kChunkMagic = 0x4B4E4843;   // "CHNK"
+constexpr uint64_t kChunkAlign = 64;
+
+// Codage des données d'un bloc
+enum class ChunkCodec : uint16_t {
+    Raw = 0,    // Scalaires bruts (float ou double)
+    Delta = 1   // Quantification, prédiction et codage de Rice (DeltaCodec.h)
+};
+
+struct TrajectoryHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    int32_t systemType;
+    int32_t integrator;         // Integrator (Euler pour les applications)
+    int32_t dims;               // 2 ou 3 coordonnées enregistrées
+    int32_t scalarSize;         // 4 (float) ou 8 (double)
+    double dt;
+    double params[kMaxParams];
+    double initial[3];
+    uint64_t pointCount;        // Mis à jour à chaque bloc
+    uint64_t chunkCount;
+    uint64_t dataEnd;           // Fin du dernier bloc complet
+    double quantum;             // Pas de quantification des blocs Delta
+    uint32_t codec;             // ChunkCodec demandé (un bloc incompressible reste brut)
+    uint32_t taylorOrder;       // Ordre du pas de Taylor (0 : autre intégrateur)
+    uint8_t reserved[104];
+};
+static_assert(sizeof(TrajectoryHeader) == 256, "TrajectoryHeader : 256 octets");
+
+struct TrajectoryChunkHeader {
+    uint32_t magic;
+    uint16_t codec;             // ChunkCodec
+    uint16_t stride;            // Pas de simulation entre deux points (0 ou 1 : tous)
+    uint64_t count;             // Points du bloc
+    uint64_t firstIndex;        // Indice du premier point dans la trajectoire
+    uint64_t bytes;             // Taille des données (sans l'en-tête ni le bourrage)
+    uint64_t firstStep;         // Pas de simulation du premier point (version 3) :
+                                // les points abandonnés ou décimés laissent des trous
+    uint64_t reserved;
+};
+static_assert(sizeof(TrajectoryChunkHeader) == 48, "TrajectoryChunkHeader : 48 octets");
+
+// Début des données d'un bloc Delta, suivi des colonnes codées (chacune
+// complétée à 8 octets)
+struct DeltaChunkHeader {
+    double quantum;             // Erreur absolue <= quantum / 2
+    uint32_t axisBytes[3];
+    uint32_t reserved[3];
+};
+static_assert(sizeof(DeltaChunkHeader) == 32, "DeltaChunkHeader : 32 octets");
+
+// Bloc de points en SoA, rempli pas à pas par la simulation, dans le type
+// scalaire du fichier (scalarSize 4 : float, 8 : double)
+struct TrajectoryBuffer {
+    size_t count = 0;
+    uint32_t stride = 1;        // Pas de simulation entre deux points
+    uint64_t firstStep = 0;     // Pas de simulation du premier point
+
+    explicit TrajectoryBuffer(size_t capacity = 65536, int scalarSize = 4) { reset(capacity, scalarSize); }
+    void reset(size_t capacity, int scalarSize) {
+        slots = capacity;
+        scalar = scalarSize == 8 ? 8 : 4;
+        count = 0;
+        for (auto& c : columns) c.assign(capacity * size_t(scalar), 0);
+    }
+    size_t capacity() const { return slots; }
+    int scalarSize() const { return scalar; }
+    bool full() const { return count == slots; }
+    const void* column(int axis) const { return columns[axis].data(); }
+
+    template <typename T>
+    void push(const Vec3<T>& p) {
+        if (scalar == 8) store<double>(p);
+        else store<float>(p);
+        count++;
+    }
+    // Garde un point sur deux (les impairs) : le bloc reste homogène, au pas
+    // double, et commence au second point
+    void halve() {
+        if (scalar == 8) keepOdd<double>();
+        else keepOdd<float>();
+        firstStep += stride;
+        stride *= 2;
+    }
+
+private:
+    template <typename S>
+    S* values(int axis) { return reinterpret_cast<S*>(columns[axis].data()); }
+    template <typename S, typename T>
+    void store(const Vec3<T>& p) {
+        values<S>(0)[count] = S(p.x);
+        values<S>(1)[count] = S(p.y);
+        values<S>(2)[count] = S(p.z);
+    }
+    template <typename S>
+    void keepOdd() {
+        for (int axis = 0; axis < 3; axis++) {
+            S* v = values<S>(axis);
+            for (size_t i = 0; i < count / 2; i++) v[i] = v[2 * i + 1];
+        }
+        count /= 2;
+    }
+
+    std::vector<uint8_t> columns[3];
+    size_t slots = 0;
+    int scalar = 4;
+};
+
+// En-tête rempli à partir de l'état courant d'un attracteur ; storage fixe
+// le type des points du fichier
+TrajectoryHeader makeTrajectoryHeader(const Attractor& source, Integrator integrator = Integrator::Euler,
+                                      Precision storage = Precision::Single);
+// Faux si les pas de source ne sont plus ceux que décrit header (système,
+// intégrateur, ordre de Taylor, précision = stockage) : l'enregistrement de
+// l'interface doit alors être fermé
+bool headerDescribes(const TrajectoryHeader& header, const Attractor& source);
+
+// Écriture par blocs dans un fichier projeté, agrandi par paliers :
+// ajouter un bloc revient à une copie mémoire.
+class TrajectoryWriter {
+public:
+    TrajectoryWriter() = default;
+    ~TrajectoryWriter() { close(); }
+    TrajectoryWriter(const TrajectoryWriter&) = delete;
+    TrajectoryWriter& operator=(const TrajectoryWriter&) = delete;
+
+    // firstStep par défaut : à la suite du bloc précédent, sans trou
+    static constexpr uint64_t kNextStep = ~uint64_t(0);
+
+    bool open(const std::string& path, const TrajectoryHeader& header);
+    // count points en SoA (z ignoré si dims == 2), du type annoncé par scalarSize,
+    // un tous les stride pas de simulation à partir du pas firstStep
+    bool append(const void* x, const void* y, const void* z, size_t count, uint32_t stride = 1,
+                uint64_t firstStep = kNextStep);
+    bool append(const float* x, const float* y, const float* z, size_t count, uint32_t stride = 1,
+                uint64_t firstStep = kNextStep) {
+        return append(static_cast<const void*>(x), y, z, count, stride, firstStep);
+    }
+    bool append(const TrajectoryBuffer& buffer) {
+        return append(buffer.column(0), buffer.column(1), buffer.column(2), buffer.count, buffer.stride,
+                      buffer.firstStep);
+    }
+    // Plusieurs blocs à la suite : s'ils sont compressés, leur codage est
+    // réparti sur threads threads (0 = tous les cœurs), l'écriture reste dans
+    // l'ordre. Renvoie le nombre de blocs écrits.
+    size_t append(TrajectoryBuffer* const* buffers, size_t count, int threads);
+    void close();
+
+    bool isOpen() const { return file.isOpen(); }
+    uint64_t pointCount() const { return isOpen() ? header().pointCount : 0; }
+    uint64_t bytesWritten() const { return isOpen() ? header().dataEnd : 0; }
+
+private:
+    TrajectoryHeader& header() { return *reinterpret_cast<TrajectoryHeader*>(file.data()); }
+    const TrajectoryHeader& header() const { return *reinterpret_cast<const TrajectoryHeader*>(file.data()); }
+    bool reserve(uint64_t end);
+    // Codage Delta des colonnes dans out ; faux si le bloc doit rester brut
+    bool encode(const void* const columns[3], size_t count, std::vector<uint8_t>& out) const;
+    // Copie un bloc formé de parts[0..partCount) à la fin du fichier
+    bool writeChunk(ChunkCodec codec, const void* const parts[], const uint64_t sizes[], int partCount,
+                    size_t count, uint32_t stride, uint64_t firstStep);
+
+    MappedFile file;
+    uint64_t nextStep = 0;      // Pas du point suivant, au pas du dernier bloc
+    uint64_t minStep = 0;       // Premier pas après le dernier point écrit
+    std::vector<std::vector<uint8_t>> encoded;  // Un tampon de codage par bloc d'un lot
+};
+
+// Lecture d'un fichier projeté : seuls les en-têtes de blocs sont parcourus
+// à l'ouverture, les points restent dans la projection.
+class TrajectoryReader {
+public:
+    struct Chunk {
+        uint64_t firstIndex;
+        uint64_t count;
+        uint64_t offset;        // Début des données dans le fichier
+        uint64_t bytes;         // Taille des données
+        ChunkCodec codec;
+        uint32_t stride;
+        uint64_t firstStep;     // Pas de simulation du premier point
+    };
+
+    bool open(const std::string& path);
+    void close();
+    const std::string& error() const { return lastError; }
+
+    const TrajectoryHeader& header() const { return info; }
+    uint64_t pointCount() const { return points; }
+    const std::vector<Chunk>& chunks() const { return index; }
+    // Bloc contenant le point index
+    size_t chunkOf(uint64_t index) const;
+    // Adresse de la coordonnée axis (0, 1, 2) d'un bloc brut
+    const void* column(const Chunk& chunk, int axis) const;
+    // Coordonnée axis d'un bloc, brut ou compressé, dans le type enregistré
+    // (chunk.count scalaires de scalarSize octets)
+    bool readColumn(const Chunk& chunk, int axis, void* out) const;
+    // Octets de données par point (compression comprise)
+    double bytesPerPoint() const;
+    // Pas de simulation du point index, lu dans l'en-tête de son bloc (blocs
+    // sous-échantillonnés : un point tous les stride pas ; blocs abandonnés :
+    // trou entre deux blocs) ; stepOf(pointCount()) : pas qui suit le dernier
+    uint64_t stepOf(uint64_t index) const;
+    uint32_t maxStride() const;     // 1 : aucun bloc sous-échantillonné
+    bool contiguous() const { return stepOf(points) == points; }   // Point i au pas i
+
+    // Copie les points [first, first + count) (convertis en float) ; les blocs
+    // compressés sont décodés en parallèle
+    size_t read(uint64_t first, size_t count, Point* out) const;
+
+    // Pagination des blocs des points [first, first + count) : seule la
+    // fenêtre lue reste en mémoire, même pour un fichier de plusieurs Go
+    void prefetch(uint64_t first, uint64_t count);
+    void release(uint64_t first, uint64_t count);
+
+private:
+    // Octets [begin, end) des blocs couvrant les points [first, first + count)
+    bool byteRange(uint64_t first, uint64_t count, uint64_t& begin, uint64_t& end) const;
+    // Faux si le codage est inconnu ou si bytes ne peut contenir count points
+    bool chunkSizeValid(const TrajectoryChunkHeader& chunk) const;
+
+    MappedFile file;
+    TrajectoryHeader info{};
+    std::vector<Chunk> index;
+    uint64_t points = 0;
+    std::string lastError;
+};
+
+// Export .npy : tableau (n, 3) de float32 à partir de points en mémoire
+bool writePointsNpy(const std::string& path, const Point* points, size_t count);
+// Export .npy d'un fichier .atr : tableau (n, dims) du type enregistré, rangé
+// colonne par colonne (ordre Fortran) pour recopier les colonnes SoA des blocs
+// telles quelles, sans conversion ni entrelacement
+bool writeTrajectoryNpy(TrajectoryReader& reader, const std::string& path);
+// Pas de simulation de chaque point, tableau (n,) d'uint64 : les points d'un
+// fichier sous-échantillonné ou troué (RecordPolicy::Downsample, Drop) ne sont
+// pas équidistants. Rangé à côté du tableau des points : "a.npy" -> "a_pas.npy"
+std::string trajectoryStepsPath(const std::string& pointsPath);
+bool writeTrajectoryStepsNpy(const TrajectoryReader& reader, const std::string& path);
+
+#endif // TRAJECTORY_FILE_H
+/**
+ * TrajectoryFile.h
+ *
+ * Contient le format binaire versionné des trajectoires enregistrées et ses
+ * classes de lecture et d'écriture par projection en mémoire.
+ */
@@ -0,0 +1,92 @@
+#ifndef TRAJECTORY_RECORDER_H
+#define TRAJECTORY_RECORDER_H
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SpscQueue.h"
+#include "TrajectoryFile.h"
+
+// Que faire quand le thread d'écriture ne suit plus (aucun bloc libre)
+enum class RecordPolicy {
+    Block,      // La simulation attend un bloc libre : aucun point perdu
+    Drop,       // Le bloc courant est abandonné : la simulation ne ralentit jamais
+    Downsample  // Le bloc courant est décimé d'un point sur deux et le pas
+                // d'enregistrement doublé ; il redescend quand l'écriture rattrape
+};
+
+struct RecorderStats {
+    uint64_t written = 0;       // Points écrits dans le fichier
+    uint64_t dropped = 0;       // Points abandonnés, décimés ou sautés par le pas
+    uint64_t bytes = 0;
+    double blockedSeconds = 0.0;// Temps passé par la simulation à attendre
+    uint32_t stride = 1;        // Pas d'enregistrement courant
+    size_t queued = 0;          // Blocs en attente d'écriture
+    size_t buffers = 0;
+    bool failed = false;        // Erreur d'écriture (disque plein...)
+};
+
+// Enregistrement asynchrone : la simulation remplit des blocs SoA et les passe
+// au thread d'écriture par une file sans verrou ; les blocs écrits reviennent
+// par une seconde file. Aucune allocation ni appel système côté simulation.
+class TrajectoryRecorder {
+public:
+    explicit TrajectoryRecorder(size_t bufferCount = 16, size_t chunkSize = 65536);
+    ~TrajectoryRecorder();
+    TrajectoryRecorder(const TrajectoryRecorder&) = delete;
+    TrajectoryRecorder& operator=(const TrajectoryRecorder&) = delete;
+
+    RecordPolicy policy = RecordPolicy::Block;
+    // Threads de codage des blocs compressés en retard (0 = tous les cœurs)
+    int encodeThreads = 0;
+
+    bool open(const std::string& path, const TrajectoryHeader& header);
+    void close();   // Écrit les blocs en attente puis ferme le fichier
+    bool isOpen() const { return current != nullptr; }
+    const TrajectoryHeader& header() const { return info; }   // Celui passé à open()
+
+    // Thread de simulation uniquement, un appel par pas ; p converti dans le
+    // type du fichier
+    template <typename T>
+    void push(const Vec3<T>& p) {
+        if (!current) return;
+        const uint64_t step = steps++;
+        if (++skipped < stride) { decimated++; return; }
+        skipped = 0;
+        if (current->count == 0) current->firstStep = step;
+        current->push(p);
+        if (current->full()) submit();
+    }
+
+    RecorderStats stats() const;
+
+private:
+    void submit();
+    void writerLoop();
+
+    std::vector<TrajectoryBuffer> buffers;
+    SpscQueue<TrajectoryBuffer*> filled;        // Simulation -> écriture
+    SpscQueue<TrajectoryBuffer*> available;     // Écriture -> simulation
+    TrajectoryBuffer* current = nullptr;
+    uint32_t stride = 1;
+    uint32_t skipped = 0;
+    uint64_t steps = 0;         // Pas reçus par push() : premier pas de chaque bloc
+    uint64_t decimated = 0;     // Points sautés par le pas, publiés dans dropped par submit()
+
+    TrajectoryWriter writer;
+    TrajectoryHeader info{};
+    std::thread thread;
+    std::atomic<bool> stopRequested{false};
+    std::atomic<bool> failed{false};
+    std::atomic<uint64_t> written{0}, bytes{0}, dropped{0};
+    std::atomic<uint32_t> currentStride{1};
+    std::atomic<double> blockedSeconds{0.0};
+};
+
+#endif // TRAJECTORY_RECORDER_H
+/**
+ * TrajectoryRecorder.h
+ *
+ * Contient l'enregistrement de trajectoires par un thread d'écriture dédié.
+ */
@@ -1,22 +1,115 @@
 #ifndef UI_H
 #define UI_H
 
+#include <SDL3/SDL.h>
 #include <imgui.h>
-#include <SDL.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Animation.h"
 #include "Attractor.h"
+#include "Bifurcation.h"
+#include "Lyapunov.h"
+#include "Poincare.h"
+#include "Renderer.h"
+#include "Replay.h"
+#include "Session.h"
+#include "TrajectoryRecorder.h"
 
 class UI {
 public:
     UI();
     ~UI();
 
-    void initialize();
-    void handleEvent(const SDL_Event& event);
-    void update(const Attractor& attractor);
-    void render();
+    // Renderer utilisé pour les textures des panneaux (à appeler une fois)
+    void initialize(SDL_Renderer* renderer);
+    // Libère les textures (avant SDL_DestroyRenderer)
+    void shutdown();
+
+    // Fenêtre des exposants de Lyapunov (spectre et courbes de convergence)
+    void lyapunovPanel(const Attractor& attractor, LyapunovEstimator& estimator);
+
+    // Fenêtre du diagramme de bifurcation (colonnes affichées dès qu'elles
+    // sont terminées)
+    void bifurcationPanel(const Attractor& attractor, BifurcationDiagram& diagram);
+
+    // Fenêtre de la section de Poincaré (flots 3D)
+    void poincarePanel(const Attractor& attractor, PoincareSection& section);
+
+    // Fenêtre d'enregistrement de la trajectoire (fichier, politique, débit)
+    // et export .npy des points affichés
+    void recordingPanel(const Attractor& attractor, TrajectoryRecorder& recorder, const std::vector<Point>& points);
+
+    // Fenêtre de relecture d'un fichier .atr (frise, lecture, vitesse)
+    void replayPanel(TrajectoryReplay& replay, Renderer& view);
+    void openReplay(TrajectoryReplay& replay, const char* path);
+
+    // Fenêtre d'export d'animation (orbite de la caméra, variation d'un
+    // paramètre ou images clés), rendue hors écran à partir de la vue
+    // courante ; l'éditeur d'images clés modifie attractor et view (aperçu)
+    void animationPanel(Attractor& attractor, Renderer& view, AnimationExport& exporter);
+
+    // Fenêtre du système personnalisé (équations, paramètres nommés) ; vrai
+    // quand « Compiler » vient d'installer un nouveau système
+    bool customSystemPanel();
+
+    // Réglages et textures des panneaux après la reprise des calculs d'une
+    // session restaurée (hasPoincare / hasBifurcation : calcul repris)
+    void resumed(const SessionState& state);
 
 private:
-    void renderMenu(const Attractor& attractor);
+    // Champ de fichier et bouton « Exporter .npy » : write(path) est appelé
+    // au clic, l'échec reste affiché sous le champ
+    void exportField(const char* id, char* path, size_t size, const std::function<bool(const char*)>& write);
+
+    SDL_Renderer* renderer = nullptr;
+    std::string exportFailed;   // Identifiant du dernier export en échec
+
+    bool lyapunovAutoRestart = true;
+    Attractor lyapunovSource;   // Réglages utilisés pour la dernière estimation
+
+    BifurcationSettings bifurcation;
+    SDL_Texture* bifurcationTexture = nullptr;
+    std::vector<uint8_t> bifurcationShown;  // Colonnes déjà copiées dans la texture
+    std::vector<uint8_t> bifurcationPixels;
+    bool bifurcationClear = false;          // Nouveau calcul : texture et pixels à effacer
+
+    char bifurcationNpy[256] = "bifurcation.npy";
+
+    PoincareSettings poincare;
+    SDL_Texture* poincareTexture = nullptr;
+    unsigned poincareVersion = 0;       // Version de l'image copiée dans la texture
+    Uint64 poincareUploadTicks = 0;
+    DensityImage poincareImage;
+    std::vector<uint8_t> poincarePixels;
+    char poincareNpy[256] = "section.npy";
+
+    char recordPath[256] = "trajectoire.atr";
+    bool recordError = false;
+    bool recordCompressed = false;      // Blocs Delta (DeltaCodec.h)
+    float recordQuantum = 1e-3f;
+    char pointsNpy[256] = "trajectoire.npy";
+
+    char replayPath[256] = "trajectoire.atr";
+    std::string replayError;
+    char replayNpy[256] = "relecture.npy";
+    bool replayZoomPending = false;     // Zoom du système relu à appliquer
+
+    AnimationSettings animation;
+    int animationOutput = 0;            // 0 : images PNG, 1 : fichier Y4M, 2 : encodeur
+    int animationFps = 30;
+    char animationPng[256] = "image_%05d.png";
+    char animationY4m[256] = "animation.y4m";
+    char animationCommand[512] = "ffmpeg -y -i - -c:v libx264 -pix_fmt yuv420p animation.mp4";
+    int keyframeTarget = 0;             // Image de la prochaine image clé
+    int previewFrame = 0;
+
+    char customName[64] = "Lorenz (équations)";
+    char customEquations[3][256] = {"sigma * (y - x)", "x * (rho - z) - y", "x * y - beta * z"};
+    char customParams[256] = "sigma=10,rho=28,beta=2.6667";
+    bool customMap = false;
+    bool customNative = false;
+    std::string customError;
 };
 
 #endif // UI_H
@@ -25,4 +118,4 @@ private:
  * 
  * Contient la déclaration de la classe UI pour gérer l'interface utilisateur
  * avec ImGui.
- */
\ No newline at end of file
+ */
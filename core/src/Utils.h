@@ -2,11 +2,26 @@
 #define UTILS_H
 
 #include <cmath>
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
 
 namespace Utils {
     static inline float mapRange(float value, float fromStart, float fromEnd, float toStart, float toEnd) {
         return toStart + (toEnd - toStart) * ((value - fromStart) / (fromEnd - fromStart));
     }
+
+    // Met les nombres dénormaux à zéro (FTZ/DAZ) le temps d'un calcul intensif :
+    // une trajectoire qui converge vers 0 coûte sinon jusqu'à 50 fois plus cher.
+    class FlushDenormals {
+    public:
+#if defined(__SSE__) || defined(_M_X64)
+        FlushDenormals() : saved(_mm_getcsr()) { _mm_setcsr(saved | 0x8040); }
+        ~FlushDenormals() { _mm_setcsr(saved); }
+    private:
+        unsigned int saved;
+#endif
+    };
 }
 
 #endif // UTILS_H
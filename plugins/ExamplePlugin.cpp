@@ -0,0 +1,82 @@
+#include <cmath>
+#include "AttractorPlugin.h"
+
+// Greffon d'exemple : compilé à part (cible attracteur_plugin_example), il
+// n'utilise que AttractorPlugin.h. Chaque fonction traite un lot de n
+// éléments rangés par entrée : boucles simples, vectorisées par le compilateur.
+
+namespace {
+    // Halvorsen : flot symétrique par permutation circulaire de x, y, z
+    template <typename T>
+    void halvorsen(const T* in, T* out, int n) {
+        const T* x = in;
+        const T* y = in + n;
+        const T* z = in + 2 * n;
+        const T* a = in + 3 * n;
+        for (int l = 0; l < n; l++) {
+            out[l] = -a[l] * x[l] - T(4) * y[l] - T(4) * z[l] - y[l] * y[l];
+            out[n + l] = -a[l] * y[l] - T(4) * z[l] - T(4) * x[l] - z[l] * z[l];
+            out[2 * n + l] = -a[l] * z[l] - T(4) * x[l] - T(4) * y[l] - x[l] * x[l];
+        }
+    }
+
+    template <typename T>
+    void halvorsenJacobian(const T* in, T* out, int n) {
+        const T* x = in;
+        const T* y = in + n;
+        const T* z = in + 2 * n;
+        const T* a = in + 3 * n;
+        for (int l = 0; l < n; l++) {
+            out[l] = -a[l];
+            out[n + l] = T(-4) - T(2) * y[l];
+            out[2 * n + l] = T(-4);
+            out[3 * n + l] = T(-4);
+            out[4 * n + l] = -a[l];
+            out[5 * n + l] = T(-4) - T(2) * z[l];
+            out[6 * n + l] = T(-4) - T(2) * x[l];
+            out[7 * n + l] = T(-4);
+            out[8 * n + l] = -a[l];
+        }
+    }
+
+    // Sprott B : sans jacobienne (différences finies côté application)
+    template <typename T>
+    void sprottB(const T* in, T* out, int n) {
+        const T* x = in;
+        const T* y = in + n;
+        const T* z = in + 2 * n;
+        const T* a = in + 3 * n;
+        const T* b = in + 4 * n;
+        for (int l = 0; l < n; l++) {
+            out[l] = a[l] * y[l] * z[l];
+            out[n + l] = x[l] - y[l];
+            out[2 * n + l] = b[l] - x[l] * y[l];
+        }
+    }
+
+    const AttractorPluginSystem kSystems[] = {
+        {ATTRACTEUR_PLUGIN_ABI, sizeof(AttractorPluginSystem), "Halvorsen", 3, 0,
+         {-1.48f, -1.51f, 2.04f}, 30.0f, 1, {"a"}, {1.89f},
+         halvorsen<float>, halvorsen<double>, halvorsenJacobian<float>, halvorsenJacobian<double>},
+        {ATTRACTEUR_PLUGIN_ABI, sizeof(AttractorPluginSystem), "Sprott B", 3, 0,
+         {0.1f, 0.0f, 0.0f}, 60.0f, 2, {"a", "b"}, {1.0f, 1.0f},
+         sprottB<float>, sprottB<double>, nullptr, nullptr},
+    };
+}
+
+extern "C"
+#ifdef _WIN32
+__declspec(dllexport)
+#else
+__attribute__((visibility("default")))
+#endif
+const AttractorPluginSystem* attracteur_plugin_systems(int* count) {
+    *count = int(sizeof(kSystems) / sizeof(kSystems[0]));
+    return kSystems;
+}
+/**
+ * ExamplePlugin.cpp
+ *
+ * Contient un greffon d'exemple (Halvorsen avec sa jacobienne, Sprott B
+ * sans) écrit contre l'interface binaire de AttractorPlugin.h.
+ */
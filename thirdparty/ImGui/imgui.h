@@ -61,9 +61,7 @@ Index of this file:
 
 */
 
-#pragma on
-
-.Tce
+#pragma once
 
 // Configuration file with compile-time options
 // (edit imconfig.h or '#define IMGUI_USER_CONFIG "myfilename.h" from your build system)